@@ -0,0 +1,325 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Microbenchmarks of components in the core library, which do not depend on
+// CEF or OpenGL. Datasets are generated with fixed seeds, so results of
+// different commits are comparable. Each benchmark is repeated and median and
+// minimum time per operation are written as JSON. The checksum of each
+// benchmark must not change between commits unless behavior has changed.
+//
+// Usage: CoreBenchmarks [--output=<file>] [--filter=<part of name>] [--repetitions=<count>]
+
+#include "src/Input/Filters/WeightedAverageFilter.h"
+#include "src/State/Web/Tab/Pipelines/Actions/Action.h"
+#include "src/State/Web/Tab/Pipelines/Actions/ActionConnector.h"
+#include "src/State/Web/Managers/HistoryManager.h"
+#include "src/State/Web/Tab/SocialPlatform.h"
+#include "src/CEF/AdBlocking.h"
+#include "src/CEF/Data/Rect.h"
+#include "src/Utils/Helper.h"
+#include "src/Utils/Logger.h"
+#include "src/Global.h"
+#include "src/Setup.h"
+#include "submodules/json/src/json.hpp"
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <chrono>
+#include <functional>
+#include <algorithm>
+#include <cstdio>
+
+using json = nlohmann::json;
+
+// Benchmark, function runs all operations once and returns checksum
+struct Benchmark
+{
+	std::string name;
+	int operations;
+	std::function<double()> function;
+};
+
+// Random domain of some syllables
+std::string RandomDomain(std::mt19937& rGenerator)
+{
+	static const std::vector<std::string> syllables = { "news", "shop", "mail", "web", "net", "data", "info", "page", "blog", "city" };
+	static const std::vector<std::string> endings = { ".com", ".de", ".org", ".net", ".gr", ".co.il" };
+	std::uniform_int_distribution<int> syllableCount(1, 3);
+	std::uniform_int_distribution<int> syllable(0, (int)syllables.size() - 1);
+	std::uniform_int_distribution<int> ending(0, (int)endings.size() - 1);
+	std::string domain;
+	const int count = syllableCount(rGenerator);
+	for (int i = 0; i < count; i++) { domain += syllables.at(syllable(rGenerator)); }
+	return domain + endings.at(ending(rGenerator));
+}
+
+// Random URL, some belong to social platforms or ad servers
+std::string RandomURL(std::mt19937& rGenerator)
+{
+	static const std::vector<std::string> known = { "facebook.com", "youtube.com", "wikipedia.org", "amazon.de", "reddit.com", "doubleclick.net", "2mdn.net", "zmedia.com" };
+	std::uniform_int_distribution<int> kind(0, 3);
+	std::uniform_int_distribution<int> knownIndex(0, (int)known.size() - 1);
+	std::uniform_int_distribution<int> number(0, 99999);
+	const std::string domain = (kind(rGenerator) == 0) ? known.at(knownIndex(rGenerator)) : RandomDomain(rGenerator);
+	return (kind(rGenerator) < 2 ? "https://www." : "http://") + domain + "/path/" + std::to_string(number(rGenerator)) + "?query=value";
+}
+
+// Action with some slots, only used to exercise data maps and connectors
+class BenchmarkAction : public Action
+{
+public:
+
+	BenchmarkAction() : Action(nullptr)
+	{
+		AddIntInputSlot("id");
+		AddFloatInputSlot("duration");
+		AddVec2InputSlot("coordinate");
+		AddStringInputSlot("text");
+		AddIntOutputSlot("id", 42);
+		AddFloatOutputSlot("duration", 0.5f);
+		AddVec2OutputSlot("coordinate", glm::vec2(100.f, 200.f));
+		AddStringOutputSlot("text", "some text of an input field");
+	}
+
+	virtual bool Update(float, const std::shared_ptr<const TabInput>) { return true; }
+	virtual void Draw() const {}
+	virtual void Activate() {}
+	virtual void Deactivate() {}
+	virtual void Abort() {}
+
+	// Read input, so copies cannot be optimized away
+	double Sum() const
+	{
+		int id = 0; float duration = 0.f; glm::vec2 coordinate; std::string text;
+		GetInputValue("id", id);
+		GetInputValue("duration", duration);
+		GetInputValue("coordinate", coordinate);
+		GetInputValue("text", text);
+		return id + duration + coordinate.x + coordinate.y + text.size();
+	}
+};
+
+// Create list of benchmarks
+std::vector<Benchmark> CreateBenchmarks()
+{
+	std::vector<Benchmark> benchmarks;
+
+	// Weighted average filter, fed with one sample per update like from tracker
+	{
+		auto spSamples = std::make_shared<std::vector<SampleData> >();
+		std::mt19937 generator(42);
+		std::normal_distribution<double> noise(0.0, 15.0);
+		std::uniform_real_distribution<double> position(100.0, 1800.0);
+		double fixationX = position(generator), fixationY = position(generator);
+		for (int i = 0; i < 20000; i++)
+		{
+			if (i % 100 == 0) { fixationX = position(generator); fixationY = position(generator); }
+			spSamples->push_back(SampleData(fixationX + noise(generator), fixationY + noise(generator), SampleDataCoordinateSystem::SCREEN_PIXELS, std::chrono::milliseconds(i * 4)));
+		}
+		benchmarks.push_back({ "WeightedAverageFilter.Update", (int)spSamples->size(), [spSamples]()
+		{
+			WeightedAverageFilter filter(setup::FILTER_KERNEL, setup::FILTER_WINDOW_SIZE, setup::FILTER_USE_OUTLIER_REMOVAL);
+			double checksum = 0.0;
+			for (const auto& rSample : *spSamples)
+			{
+				SampleQueue spQueue = SampleQueue(new std::deque<SampleData>);
+				spQueue->push_back(rSample);
+				filter.Update(spQueue);
+				checksum += filter.GetFilteredGazeX() + filter.GetFilteredGazeY();
+			}
+			return checksum;
+		} });
+	}
+
+	// Connector between two actions, like executed by pipelines
+	{
+		const int count = 100000;
+		benchmarks.push_back({ "ActionConnector.Execute", count, [count]()
+		{
+			auto spPrevious = std::make_shared<BenchmarkAction>();
+			auto spNext = std::make_shared<BenchmarkAction>();
+			ActionConnector connector(spPrevious, spNext);
+			connector.ConnectInt("id", "id");
+			connector.ConnectFloat("duration", "duration");
+			connector.ConnectVec2("coordinate", "coordinate");
+			connector.ConnectString("text", "text");
+			double checksum = 0.0;
+			for (int i = 0; i < count; i++)
+			{
+				connector.Execute();
+				checksum += spNext->Sum();
+			}
+			return checksum;
+		} });
+	}
+
+	// Ad matching of requested URLs
+	{
+		auto spURLs = std::make_shared<std::vector<std::string> >();
+		std::mt19937 generator(42);
+		for (int i = 0; i < 2000; i++) { spURLs->push_back(RandomURL(generator)); }
+		benchmarks.push_back({ "IsAdURL", (int)spURLs->size(), [spURLs]()
+		{
+			double checksum = 0.0;
+			for (const auto& rURL : *spURLs) { checksum += IsAdURL(rURL) ? 1.0 : 0.0; }
+			return checksum;
+		} });
+	}
+
+	// Classification of URLs into social platforms
+	{
+		auto spURLs = std::make_shared<std::vector<std::string> >();
+		std::mt19937 generator(42);
+		for (int i = 0; i < 20000; i++) { spURLs->push_back(RandomURL(generator)); }
+		benchmarks.push_back({ "ClassifySocialPlatform", (int)spURLs->size(), [spURLs]()
+		{
+			double checksum = 0.0;
+			for (const auto& rURL : *spURLs) { checksum += (double)ClassifySocialPlatform(ShortenURL(rURL)); }
+			return checksum;
+		} });
+	}
+
+	// Hit test of gaze against rects of DOM nodes
+	{
+		auto spRects = std::make_shared<std::vector<Rect> >();
+		auto spPoints = std::make_shared<std::vector<glm::vec2> >();
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> position(0.f, 1920.f);
+		std::uniform_real_distribution<float> extent(10.f, 300.f);
+		for (int i = 0; i < 1000; i++)
+		{
+			const float top = position(generator), left = position(generator);
+			spRects->push_back(Rect(top, left, top + extent(generator), left + extent(generator)));
+		}
+		for (int i = 0; i < 1000; i++) { spPoints->push_back(glm::vec2(position(generator), position(generator))); }
+		benchmarks.push_back({ "Rect.IsInside", (int)(spRects->size() * spPoints->size()), [spRects, spPoints]()
+		{
+			double checksum = 0.0;
+			for (const auto& rPoint : *spPoints)
+			{
+				for (const auto& rRect : *spRects)
+				{
+					if (!rRect.IsZero() && rRect.IsInside(rPoint.x, rPoint.y)) { checksum += rRect.Center().x; }
+				}
+			}
+			return checksum;
+		} });
+	}
+
+	// Splitting of messages from render process
+	{
+		auto spMessages = std::make_shared<std::vector<std::string> >();
+		std::mt19937 generator(42);
+		std::uniform_real_distribution<float> value(0.f, 2000.f);
+		for (int i = 0; i < 5000; i++)
+		{
+			std::string message;
+			for (int j = 0; j < 16; j++) { message += std::to_string(value(generator)) + ";"; }
+			spMessages->push_back(message);
+		}
+		benchmarks.push_back({ "SplitBySeparator", (int)spMessages->size(), [spMessages]()
+		{
+			double checksum = 0.0;
+			for (const auto& rMessage : *spMessages) { checksum += (double)SplitBySeparator(rMessage, ';').size(); }
+			return checksum;
+		} });
+	}
+
+	// History with file on disk, which is rewritten at each added page
+	{
+		auto spURLs = std::make_shared<std::vector<std::string> >();
+		std::mt19937 generator(42);
+		for (int i = 0; i < 200; i++) { spURLs->push_back(RandomURL(generator)); }
+		benchmarks.push_back({ "HistoryManager.AddPage", (int)spURLs->size(), [spURLs]()
+		{
+			const std::string prefix = "benchmark_"; // history manager appends file name
+			std::remove((prefix + HISTORY_FILE).c_str());
+			double checksum = 0.0;
+			{
+				HistoryManager manager(prefix);
+				for (const auto& rURL : *spURLs) { manager.AddPage(rURL, "Title"); }
+				checksum = (double)manager.GetHistory()->size();
+			}
+			std::remove((prefix + HISTORY_FILE).c_str());
+			return checksum;
+		} });
+	}
+
+	return benchmarks;
+}
+
+int main(int argc, char* argv[])
+{
+	// Parse arguments
+	std::string output;
+	std::string filter;
+	int repetitions = 7;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		if (argument.find("--output=") == 0) { output = argument.substr(9); }
+		else if (argument.find("--filter=") == 0) { filter = argument.substr(9); }
+		else if (argument.find("--repetitions=") == 0) { repetitions = std::max(1, std::stoi(argument.substr(14))); }
+		else
+		{
+			std::cerr << "Usage: CoreBenchmarks [--output=<file>] [--filter=<part of name>] [--repetitions=<count>]" << std::endl;
+			return 1;
+		}
+	}
+
+	// Log only errors, so output is not mixed with log
+	LogThreshold = (int)LogLevel::ERROR_LEVEL;
+
+	// Run benchmarks
+	json results = json::array();
+	for (const auto& rBenchmark : CreateBenchmarks())
+	{
+		if (!filter.empty() && rBenchmark.name.find(filter) == std::string::npos) { continue; }
+
+		std::vector<double> times; // nanoseconds per operation
+		double checksum = 0.0;
+		for (int i = 0; i < repetitions; i++)
+		{
+			const auto start = std::chrono::steady_clock::now();
+			checksum = rBenchmark.function();
+			const double duration = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+			times.push_back(duration / rBenchmark.operations);
+		}
+		std::sort(times.begin(), times.end());
+
+		results.push_back(
+		{
+			{ "name", rBenchmark.name },
+			{ "operations", rBenchmark.operations },
+			{ "median_ns", times.at(times.size() / 2) },
+			{ "min_ns", times.front() },
+			{ "checksum", checksum }
+		});
+		std::cerr << rBenchmark.name << ": " << times.at(times.size() / 2) << " ns/op" << std::endl;
+	}
+
+	// Output results
+	json document =
+	{
+		{ "version", std::to_string(CLIENT_VERSION) },
+		{ "repetitions", repetitions },
+		{ "benchmarks", results }
+	};
+	if (output.empty())
+	{
+		std::cout << document.dump(4) << std::endl;
+	}
+	else
+	{
+		std::ofstream file(output);
+		if (!file.is_open())
+		{
+			std::cerr << "Cannot write " << output << std::endl;
+			return 1;
+		}
+		file << document.dump(4) << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,309 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Replays gaze traces through the available filters and reports jitter and
+// lag of each. Traces are CSV files with timestamp in milliseconds, x and y in
+// pixels per line. Without files, a synthetic trace of fixations, saccades and
+// smooth pursuits is generated, for which also the error against the true gaze
+// is reported. Output of filters is assumed to be displayed after given
+// latency, which is also the prediction horizon of the predictive filter.
+//
+// Usage: FilterReplay [--latency=<milliseconds>] [trace.csv ...]
+
+#include "src/Input/Filters/WeightedAverageFilter.h"
+#include "src/Input/Filters/PredictiveFilter.h"
+#include "src/Utils/glmWrapper.h"
+#include "src/Setup.h"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <algorithm>
+#include <cmath>
+
+// Sample of a trace, with true gaze if known
+struct TraceSample
+{
+	double timestamp; // milliseconds
+	double x;
+	double y;
+	double trueX;
+	double trueY;
+};
+
+// Trace
+struct Trace
+{
+	std::string name;
+	std::vector<TraceSample> samples;
+	bool hasTruth = false;
+};
+
+// Load trace from CSV, lines that do not start with numbers are skipped
+bool LoadTrace(const std::string& rFilepath, Trace& rTrace)
+{
+	std::ifstream file(rFilepath);
+	if (!file.is_open()) { return false; }
+	rTrace.name = rFilepath;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::replace(line.begin(), line.end(), ';', ' ');
+		std::istringstream stream(line);
+		TraceSample sample;
+		if (stream >> sample.timestamp >> sample.x >> sample.y)
+		{
+			sample.trueX = sample.x;
+			sample.trueY = sample.y;
+			rTrace.samples.push_back(sample);
+		}
+	}
+	return !rTrace.samples.empty();
+}
+
+// Generate trace with fixations, saccades, smooth pursuits, noise and outliers
+Trace GenerateTrace(double sampleRate, double duration)
+{
+	Trace trace;
+	trace.name = "synthetic " + std::to_string((int)sampleRate) + " Hz";
+	trace.hasTruth = true;
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<double> positionX(100, 1820);
+	std::uniform_real_distribution<double> positionY(100, 980);
+	std::uniform_real_distribution<double> fixationDuration(200, 800);
+	std::uniform_real_distribution<double> pursuitDuration(500, 1500);
+	std::uniform_real_distribution<double> pursuitSpeed(200, 600); // pixels per second
+	std::uniform_real_distribution<double> angle(0, 6.2831853);
+	std::uniform_real_distribution<double> chance(0, 1);
+	std::normal_distribution<double> noise(0, 6);
+
+	const double step = 1000.0 / sampleRate;
+	double time = 0;
+	glm::dvec2 gaze(positionX(generator), positionY(generator));
+	auto Emit = [&](glm::dvec2 truth)
+	{
+		glm::dvec2 measured = truth + glm::dvec2(noise(generator), noise(generator));
+		if (chance(generator) < 0.01) // outlier
+		{
+			measured += glm::dvec2(60, -40);
+		}
+		trace.samples.push_back(TraceSample{ time, measured.x, measured.y, truth.x, truth.y });
+		time += step;
+	};
+
+	while (time < duration)
+	{
+		// Fixation
+		const double fixationEnd = time + fixationDuration(generator);
+		while (time < fixationEnd) { Emit(gaze); }
+
+		if (chance(generator) < 0.25)
+		{
+			// Smooth pursuit
+			const double a = angle(generator);
+			const glm::dvec2 velocity = glm::dvec2(std::cos(a), std::sin(a)) * pursuitSpeed(generator) / 1000.0;
+			const double pursuitEnd = time + pursuitDuration(generator);
+			while (time < pursuitEnd)
+			{
+				gaze = glm::clamp(gaze + velocity * step, glm::dvec2(0, 0), glm::dvec2(1920, 1080));
+				Emit(gaze);
+			}
+		}
+		else
+		{
+			// Saccade with smooth velocity profile
+			const glm::dvec2 target(positionX(generator), positionY(generator));
+			const glm::dvec2 origin = gaze;
+			const double saccadeDuration = 20.0 + 0.05 * glm::distance(origin, target);
+			const double saccadeStart = time;
+			while (time < saccadeStart + saccadeDuration)
+			{
+				const double t = (time - saccadeStart) / saccadeDuration;
+				gaze = glm::mix(origin, target, t * t * (3.0 - 2.0 * t));
+				Emit(gaze);
+			}
+			gaze = target;
+		}
+	}
+	return trace;
+}
+
+// Filter under test
+struct Candidate
+{
+	std::string name;
+	std::function<std::shared_ptr<Filter>()> create;
+	bool extrapolate; // whether display latency is given to filter as prediction horizon
+};
+
+// Result of replay
+struct Result
+{
+	double jitter = 0; // RMS of movement while resting, pixels
+	double meanLag = 0; // milliseconds from start of fixation until displayed gaze arrives
+	double medianLag = 0;
+	double error = -1; // RMS distance of displayed to true gaze, pixels
+};
+
+Result Replay(const Trace& rTrace, const Candidate& rCandidate, double latency)
+{
+	const auto& rSamples = rTrace.samples;
+	const double radius = setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS;
+
+	// Filter sample by sample, like the tracker delivers them
+	std::shared_ptr<Filter> spFilter = rCandidate.create();
+	spFilter->SetPredictionHorizon(rCandidate.extrapolate ? (float)(latency / 1000.0) : 0.f);
+	std::vector<glm::dvec2> output;
+	output.reserve(rSamples.size());
+	for (const auto& rSample : rSamples)
+	{
+		SampleQueue spQueue = SampleQueue(new std::deque<SampleData>);
+		spQueue->push_back(SampleData(rSample.x, rSample.y, SampleDataCoordinateSystem::SCREEN_PIXELS, std::chrono::milliseconds((long long)rSample.timestamp)));
+		spFilter->Update(spQueue);
+		output.push_back(glm::dvec2(spFilter->GetFilteredGazeX(), spFilter->GetFilteredGazeY()));
+	}
+
+	// Segment raw samples into fixations by distance of subsequent samples
+	std::vector<std::pair<size_t, size_t> > fixations;
+	size_t begin = 0;
+	for (size_t i = 1; i <= rSamples.size(); i++)
+	{
+		if (i == rSamples.size()
+			|| glm::distance(glm::dvec2(rSamples[i].x, rSamples[i].y), glm::dvec2(rSamples[i - 1].x, rSamples[i - 1].y)) > radius)
+		{
+			if (rSamples[i - 1].timestamp - rSamples[begin].timestamp >= 150.0) { fixations.push_back(std::make_pair(begin, i)); }
+			begin = i;
+		}
+	}
+
+	Result result;
+
+	// Jitter in fixations, ignoring first 100 ms where gaze still arrives
+	double squaredSum = 0;
+	int count = 0;
+	for (const auto& rFixation : fixations)
+	{
+		for (size_t i = rFixation.first + 1; i < rFixation.second; i++)
+		{
+			if (rSamples[i].timestamp - rSamples[rFixation.first].timestamp < 100.0) { continue; }
+			const double distance = glm::distance(output[i], output[i - 1]);
+			squaredSum += distance * distance;
+			count++;
+		}
+	}
+	result.jitter = count > 0 ? std::sqrt(squaredSum / count) : 0;
+
+	// Lag until displayed gaze is within half the fixation radius of median of fixation
+	std::vector<double> lags;
+	for (const auto& rFixation : fixations)
+	{
+		std::vector<double> xs, ys;
+		for (size_t i = rFixation.first; i < rFixation.second; i++) { xs.push_back(rSamples[i].x); ys.push_back(rSamples[i].y); }
+		std::nth_element(xs.begin(), xs.begin() + xs.size() / 2, xs.end());
+		std::nth_element(ys.begin(), ys.begin() + ys.size() / 2, ys.end());
+		const glm::dvec2 target(xs[xs.size() / 2], ys[ys.size() / 2]);
+		for (size_t i = rFixation.first; i < rFixation.second; i++)
+		{
+			if (glm::distance(output[i], target) <= radius / 2)
+			{
+				lags.push_back(rSamples[i].timestamp - rSamples[rFixation.first].timestamp + latency);
+				break;
+			}
+		}
+	}
+	if (!lags.empty())
+	{
+		double sum = 0;
+		for (double lag : lags) { sum += lag; }
+		result.meanLag = sum / lags.size();
+		std::nth_element(lags.begin(), lags.begin() + lags.size() / 2, lags.end());
+		result.medianLag = lags[lags.size() / 2];
+	}
+
+	// Error of displayed gaze against true gaze at time of display
+	if (rTrace.hasTruth)
+	{
+		squaredSum = 0;
+		count = 0;
+		size_t j = 0;
+		for (size_t i = 0; i < rSamples.size(); i++)
+		{
+			const double displayTime = rSamples[i].timestamp + latency;
+			while (j + 1 < rSamples.size() && rSamples[j + 1].timestamp <= displayTime) { j++; }
+			const double distance = glm::distance(output[i], glm::dvec2(rSamples[j].trueX, rSamples[j].trueY));
+			squaredSum += distance * distance;
+			count++;
+		}
+		result.error = std::sqrt(squaredSum / count);
+	}
+
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	// Arguments
+	double latency = 30.0;
+	std::vector<Trace> traces;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		if (argument.find("--latency=") == 0)
+		{
+			latency = std::stod(argument.substr(std::string("--latency=").length()));
+		}
+		else
+		{
+			Trace trace;
+			if (LoadTrace(argument, trace)) { traces.push_back(trace); }
+			else { std::cerr << "Could not load trace " << argument << std::endl; }
+		}
+	}
+	if (traces.empty())
+	{
+		traces.push_back(GenerateTrace(60, 60000));
+		traces.push_back(GenerateTrace(250, 60000));
+	}
+
+	// Filters
+	auto CreatePredictiveFilter = []()
+	{
+		return std::shared_ptr<Filter>(new PredictiveFilter(
+			setup::FILTER_PREDICTIVE_MIN_CUTOFF,
+			setup::FILTER_PREDICTIVE_BETA,
+			setup::FILTER_PREDICTIVE_DERIVATIVE_CUTOFF,
+			setup::FILTER_PREDICTIVE_WINDOW_DURATION));
+	};
+	const std::vector<Candidate> candidates =
+	{
+		{ "weighted average", []() { return std::shared_ptr<Filter>(new WeightedAverageFilter(setup::FILTER_KERNEL, setup::FILTER_WINDOW_SIZE, setup::FILTER_USE_OUTLIER_REMOVAL)); }, false },
+		{ "weighted average, no outlier removal", []() { return std::shared_ptr<Filter>(new WeightedAverageFilter(setup::FILTER_KERNEL, setup::FILTER_WINDOW_SIZE, false)); }, false },
+		{ "predictive, no extrapolation", CreatePredictiveFilter, false },
+		{ "predictive", CreatePredictiveFilter, true }
+	};
+
+	// Replay traces
+	std::cout << std::fixed << std::setprecision(1);
+	for (const auto& rTrace : traces)
+	{
+		std::cout << rTrace.name << ", " << rTrace.samples.size() << " samples, display latency " << latency << " ms" << std::endl;
+		for (const auto& rCandidate : candidates)
+		{
+			const Result result = Replay(rTrace, rCandidate, latency);
+			std::cout << "  " << std::left << std::setw(40) << rCandidate.name << std::right
+				<< " jitter: " << std::setw(5) << result.jitter << " px"
+				<< ", lag: " << std::setw(5) << result.meanLag << " ms (median " << result.medianLag << " ms)";
+			if (result.error >= 0) { std::cout << ", error: " << result.error << " px"; }
+			std::cout << std::endl;
+		}
+	}
+
+	return 0;
+}
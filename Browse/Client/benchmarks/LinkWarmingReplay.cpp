@@ -0,0 +1,244 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Replay of reading sessions against the link warmer, with and without
+// prefetch. Pages consist of links to the same origin, to other origins and
+// links with side effects like logout. Gaze fixates links with random
+// durations and some fixations end in a click. Commands of the warmer are
+// executed against a model of the network, in which a connection to the
+// origin of the page is already open, a connection to another origin costs
+// a handshake and a prefetch completes after the fetch time. Reports modeled
+// navigation time, requests and wasted prefetches. Fails when a link with
+// side effects or of another origin is prefetched. Sessions are generated
+// with fixed seeds, so results of different commits are comparable.
+//
+// Usage: LinkWarmingReplay [--navigations=<count>]
+
+#include "src/State/Web/Tab/LinkWarmer.h"
+#include "src/Setup.h"
+#include <iostream>
+#include <iomanip>
+#include <random>
+#include <vector>
+#include <map>
+#include <string>
+
+// Model of network in milliseconds
+static const double HANDSHAKE_DURATION = 150.0; // DNS, TCP and TLS
+static const double FETCH_DURATION = 250.0;
+static const double CACHE_DURATION = 20.0;
+static const double PREFETCH_SIZE = 60.0; // kilobytes
+
+// Model of reading
+static const float FRAME_DURATION = 1.f / 60.f; // seconds
+static const float SACCADE_DURATION = 0.1f; // seconds without link under gaze between fixations
+
+// Link on page
+struct Link
+{
+	std::string URL;
+	std::string text;
+	bool sideEffect;
+};
+
+// Generate links of page of given origin
+std::vector<Link> GeneratePage(const std::string& rOrigin, std::mt19937& rGenerator)
+{
+	static const std::vector<std::string> otherOrigins = { "https://video.example.org", "https://shop.example.net", "http://blog.example.de" };
+	std::uniform_int_distribution<int> article(0, 99999);
+	std::uniform_int_distribution<int> other(0, (int)otherOrigins.size() - 1);
+	std::vector<Link> links;
+	for (int i = 0; i < 30; i++)
+	{
+		links.push_back({ rOrigin + "/article/" + std::to_string(article(rGenerator)), "Read article", false });
+	}
+	for (int i = 0; i < 8; i++)
+	{
+		links.push_back({ otherOrigins.at(other(rGenerator)) + "/item/" + std::to_string(article(rGenerator)) + "#top", "Related item", false });
+	}
+	links.push_back({ rOrigin + "/logout", "Log out", true });
+	links.push_back({ rOrigin + "/account/delete?id=3", "Account", true });
+	links.push_back({ rOrigin + "/newsletter?do=unsubscribe&id=7", "Newsletter", true });
+	links.push_back({ rOrigin + "/comments/7/edit", "Remove comment", true });
+	links.push_back({ rOrigin + "/session/sign_out", "Bye", true });
+	return links;
+}
+
+// Result of a replay
+struct Result
+{
+	unsigned int navigationCount = 0;
+	double navigationDuration = 0; // milliseconds, sum
+	double unwarmedNavigationDuration = 0; // milliseconds, sum
+	unsigned int preconnectCount = 0;
+	unsigned int prefetchCount = 0;
+	unsigned int prefetchHitCount = 0;
+	unsigned int cancelledPrefetchCount = 0;
+	unsigned int unsafePrefetchCount = 0;
+	unsigned int crossOriginPrefetchCount = 0;
+};
+
+// Replay sessions until given count of navigations
+Result Replay(bool prefetch, unsigned int navigationCount)
+{
+	std::mt19937 generator(42);
+	std::uniform_real_distribution<float> fixationDuration(0.05f, 1.2f);
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+
+	LinkWarmer warmer(prefetch);
+	Result result;
+	double time = 0; // seconds
+	std::string pageOrigin = "https://news.example.com";
+	std::vector<Link> links = GeneratePage(pageOrigin, generator);
+	warmer.NotifyNavigationURL(pageOrigin + "/");
+
+	// State of modeled network
+	std::map<std::string, double> connections; // origin to time of last use in seconds
+	std::map<std::string, double> prefetches; // URL to time of completion in seconds
+	std::string lastPrefetch;
+	double lastPrefetchStart = 0;
+
+	// Execute command of warmer in modeled network
+	auto execute = [&](LinkWarmer::Command command, const std::string& rURL, const Link& rLink)
+	{
+		switch (command)
+		{
+		case LinkWarmer::Command::PRECONNECT:
+			result.preconnectCount++;
+			connections[rURL] = time;
+			break;
+		case LinkWarmer::Command::PREFETCH:
+			result.prefetchCount++;
+			if (rLink.sideEffect) { result.unsafePrefetchCount++; }
+			if (LinkWarmer::GetOrigin(rURL) != pageOrigin) { result.crossOriginPrefetchCount++; }
+			prefetches[rURL] = time + FETCH_DURATION / 1000.0;
+			lastPrefetch = rURL;
+			lastPrefetchStart = time;
+			break;
+		case LinkWarmer::Command::CANCEL:
+			if (!lastPrefetch.empty() && time < prefetches[lastPrefetch]) // removal of hint aborts running request
+			{
+				prefetches.erase(lastPrefetch);
+				result.cancelledPrefetchCount++;
+			}
+			lastPrefetch.clear();
+			break;
+		case LinkWarmer::Command::NONE:
+			break;
+		}
+	};
+
+	std::uniform_int_distribution<int> safeLink(0, (int)links.size() - 6);
+	while (result.navigationCount < navigationCount)
+	{
+		// Saccade to next link, some fixations are upon links with side effects
+		const int index = chance(generator) < 0.1f
+			? (int)links.size() - 1 - (int)(chance(generator) * 4.99f)
+			: safeLink(generator);
+		const Link& rLink = links.at(index);
+		for (float t = 0; t < SACCADE_DURATION; t += FRAME_DURATION)
+		{
+			time += FRAME_DURATION;
+			std::string URL;
+			execute(warmer.Update(FRAME_DURATION, true, "", "", 0.f, URL), URL, rLink);
+		}
+
+		// Fixation upon link
+		const float duration = fixationDuration(generator);
+		for (float t = 0; t < duration; t += FRAME_DURATION)
+		{
+			time += FRAME_DURATION;
+			std::string URL;
+			execute(warmer.Update(FRAME_DURATION, true, rLink.URL, rLink.text, t, URL), URL, rLink);
+		}
+
+		// Longer fixations end more often in a click, links with side effects are not clicked
+		if (rLink.sideEffect || chance(generator) > (duration > 0.6f ? 0.25f : 0.05f)) { continue; }
+
+		// Navigation time with and without warming
+		const std::string URL = rLink.URL.substr(0, rLink.URL.find('#'));
+		const std::string origin = LinkWarmer::GetOrigin(URL);
+		const double unwarmed = (origin == pageOrigin ? 0.0 : HANDSHAKE_DURATION) + FETCH_DURATION;
+		double warmed = unwarmed;
+		auto prefetched = prefetches.find(URL);
+		auto connection = connections.find(origin);
+		if (prefetched != prefetches.end() && time - prefetched->second <= setup::LINK_PREFETCH_LIFETIME)
+		{
+			warmed = std::max(CACHE_DURATION, 1000.0 * (prefetched->second - time)); // may still be in flight
+			result.prefetchHitCount++;
+		}
+		else if (connection != connections.end() && time - connection->second <= setup::LINK_PRECONNECT_LIFETIME)
+		{
+			warmed = FETCH_DURATION;
+		}
+		result.navigationCount++;
+		result.navigationDuration += warmed;
+		result.unwarmedNavigationDuration += unwarmed;
+		time += warmed / 1000.0;
+
+		// Load new page, its connection stays open
+		warmer.NotifyNavigationStart();
+		warmer.NotifyNavigationURL(URL);
+		warmer.NotifyNavigationEnd();
+		pageOrigin = origin;
+		connections[origin] = time;
+		links = GeneratePage(pageOrigin, generator);
+		lastPrefetch.clear();
+	}
+	return result;
+}
+
+int main(int argc, char* argv[])
+{
+	unsigned int navigationCount = 2000;
+	for (int i = 1; i < argc; i++)
+	{
+		const std::string argument = argv[i];
+		if (argument.find("--navigations=") == 0) { navigationCount = (unsigned int)std::stoul(argument.substr(14)); }
+	}
+
+	// Classification of links
+	struct Case { std::string URL; std::string text; std::string pageOrigin; bool prefetchable; };
+	const std::vector<Case> cases = {
+		{ "https://news.example.com/article/1", "Read more", "https://news.example.com", true },
+		{ "https://NEWS.example.com:443/article/1", "Read more", "https://news.example.com:443", true },
+		{ "https://other.example.com/article/1", "Read more", "https://news.example.com", false },
+		{ "http://news.example.com/article/1", "Read more", "https://news.example.com", false },
+		{ "https://news.example.com/logout", "Account", "https://news.example.com", false },
+		{ "https://news.example.com/Log-Out", "Account", "https://news.example.com", false },
+		{ "https://news.example.com/user?id=1", "Sign out", "https://news.example.com", false },
+		{ "https://news.example.com/post/5?action=delete", "Post", "https://news.example.com", false },
+		{ "https://news.example.com/list", "Unsubscribe", "https://news.example.com", false },
+		{ "javascript:void(0)", "Menu", "https://news.example.com", false } };
+	int failures = 0;
+	for (const auto& rCase : cases)
+	{
+		if (LinkWarmer::IsPrefetchable(rCase.URL, rCase.text, rCase.pageOrigin) != rCase.prefetchable)
+		{
+			std::cout << "Misclassified " << rCase.URL << " (" << rCase.text << ")" << std::endl;
+			failures++;
+		}
+	}
+
+	// Replays
+	std::cout << std::fixed << std::setprecision(1);
+	for (bool prefetch : { false, true })
+	{
+		const Result result = Replay(prefetch, navigationCount);
+		const unsigned int wastedCount = result.prefetchCount - result.prefetchHitCount - result.cancelledPrefetchCount;
+		std::cout << "### Prefetch " << (prefetch ? "on" : "off") << " ###" << std::endl
+			<< "navigations: " << result.navigationCount
+			<< ", mean navigation: " << result.navigationDuration / result.navigationCount << " ms"
+			<< " (" << result.unwarmedNavigationDuration / result.navigationCount << " ms without warming)" << std::endl
+			<< "preconnects: " << result.preconnectCount
+			<< ", prefetches: " << result.prefetchCount
+			<< " (" << result.prefetchHitCount << " hit, " << result.cancelledPrefetchCount << " cancelled, "
+			<< wastedCount << " wasted, " << wastedCount * PREFETCH_SIZE / 1024.0 << " MB)" << std::endl
+			<< "prefetches with side effects: " << result.unsafePrefetchCount
+			<< ", prefetches of other origins: " << result.crossOriginPrefetchCount << std::endl;
+		if (result.unsafePrefetchCount > 0 || result.crossOriginPrefetchCount > 0) { failures++; }
+	}
+
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,176 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Compares the precompiled phrase matcher against a full scan with plain
+// edit distance, like it was used for voice commands and link texts before.
+// Link texts are generated synthetically, queries are altered link texts.
+// Second part measures the pattern of clicking a link by voice: texts of the
+// links are collected for a single query with a large distance, so building
+// the matcher is part of the cost, and compares it to a linear scan with
+// bounded edit distance.
+
+#include "src/Utils/PhraseMatcher.h"
+#include <iostream>
+#include <random>
+#include <chrono>
+#include <algorithm>
+
+// Plain edit distance without any bound
+int FullDistance(const std::string& rA, const std::string& rB)
+{
+	std::vector<int> costs(rB.size() + 1);
+	for (size_t j = 0; j <= rB.size(); j++) { costs[j] = (int)j; }
+	for (size_t i = 0; i < rA.size(); i++)
+	{
+		int corner = costs[0];
+		costs[0] = (int)i + 1;
+		for (size_t j = 0; j < rB.size(); j++)
+		{
+			const int upper = costs[j + 1];
+			costs[j + 1] = (rA[i] == rB[j]) ? corner : std::min(corner, std::min(upper, costs[j])) + 1;
+			corner = upper;
+		}
+	}
+	return costs[rB.size()];
+}
+
+// Random phrase of some words
+std::string RandomPhrase(std::mt19937& rGenerator)
+{
+	static const std::vector<std::string> words =
+	{
+		"home", "news", "sports", "weather", "contact", "about", "login", "search", "video", "images",
+		"more", "read", "article", "world", "politics", "business", "science", "health", "travel", "music"
+	};
+	std::uniform_int_distribution<int> wordCount(1, 4);
+	std::uniform_int_distribution<int> word(0, (int)words.size() - 1);
+	std::uniform_int_distribution<int> number(0, 999);
+	std::string phrase;
+	const int count = wordCount(rGenerator);
+	for (int i = 0; i < count; i++)
+	{
+		phrase += words.at(word(rGenerator)) + " ";
+	}
+	return phrase + std::to_string(number(rGenerator));
+}
+
+// Alter some characters of phrase, like a transcript would
+std::string AlterPhrase(std::string phrase, std::mt19937& rGenerator)
+{
+	std::uniform_int_distribution<int> position(0, (int)phrase.size() - 1);
+	std::uniform_int_distribution<int> letter('a', 'z');
+	phrase[position(rGenerator)] = (char)letter(rGenerator);
+	return phrase;
+}
+
+int main()
+{
+	const int maxDistance = 2;
+	const int queryCount = 200;
+
+	std::cout << "### Repeated queries, distance " << maxDistance << " ###" << std::endl;
+
+	for (int linkCount : { 1000, 10000, 100000 })
+	{
+		std::mt19937 generator(42);
+
+		// Generate link texts and queries
+		std::vector<std::string> links;
+		for (int i = 0; i < linkCount; i++) { links.push_back(RandomPhrase(generator)); }
+		std::sort(links.begin(), links.end()); // matcher merges identical phrases, so scan should not count them twice
+		links.erase(std::unique(links.begin(), links.end()), links.end());
+		std::vector<std::string> queries;
+		std::uniform_int_distribution<int> link(0, (int)links.size() - 1);
+		for (int i = 0; i < queryCount; i++) { queries.push_back(AlterPhrase(links.at(link(generator)), generator)); }
+
+		// Full scan
+		auto start = std::chrono::steady_clock::now();
+		int scanHits = 0;
+		for (const auto& rQuery : queries)
+		{
+			for (const auto& rLink : links)
+			{
+				if (FullDistance(rQuery, rLink) <= maxDistance) { scanHits++; }
+			}
+		}
+		const double scanTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Precompiled matcher
+		start = std::chrono::steady_clock::now();
+		PhraseMatcher matcher(links);
+		const double buildTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		start = std::chrono::steady_clock::now();
+		int matcherHits = 0;
+		for (const auto& rQuery : queries)
+		{
+			matcherHits += (int)matcher.Find(rQuery, maxDistance).size();
+		}
+		const double matcherTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Report
+		std::cout << "links: " << links.size()
+			<< ", full scan: " << scanTime / queryCount << " ms/query"
+			<< ", matcher: " << matcherTime / queryCount << " ms/query"
+			<< " (build " << buildTime << " ms)"
+			<< ", hits: " << scanHits << "/" << matcherHits << std::endl;
+	}
+
+	// Single query per collection of link texts, like voice click does
+	const int clickDistance = 19;
+	const int clickCount = 200;
+	std::cout << "### Build and single query, distance " << clickDistance << " ###" << std::endl;
+	for (int linkCount : { 100, 1000, 10000 })
+	{
+		std::mt19937 generator(42);
+		std::vector<std::string> links;
+		for (int i = 0; i < linkCount; i++) { links.push_back(RandomPhrase(generator)); }
+		std::vector<std::string> queries;
+		std::uniform_int_distribution<int> link(0, (int)links.size() - 1);
+		for (int i = 0; i < clickCount; i++) { queries.push_back(AlterPhrase(links.at(link(generator)), generator)); }
+
+		// Full scan keeping the best match
+		auto start = std::chrono::steady_clock::now();
+		long long scanSum = 0;
+		for (const auto& rQuery : queries)
+		{
+			int best = clickDistance + 1;
+			for (const auto& rLink : links) { best = std::min(best, FullDistance(rQuery, rLink)); }
+			scanSum += best;
+		}
+		const double scanTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Linear scan with bound tightened by best match so far
+		start = std::chrono::steady_clock::now();
+		long long boundedSum = 0;
+		for (const auto& rQuery : queries)
+		{
+			int best = clickDistance + 1;
+			for (const auto& rLink : links) { best = std::min(best, PhraseMatcher::BoundedDistance(rQuery, rLink, best - 1)); }
+			boundedSum += best;
+		}
+		const double boundedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Matcher built for every query
+		start = std::chrono::steady_clock::now();
+		long long matcherSum = 0;
+		for (const auto& rQuery : queries)
+		{
+			PhraseMatcher matcher;
+			for (const auto& rLink : links) { matcher.Add(rLink); }
+			int best = clickDistance + 1;
+			for (const auto& rMatch : matcher.Find(rQuery, clickDistance)) { best = std::min(best, rMatch.distance); }
+			matcherSum += best;
+		}
+		const double matcherTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		// Report, sums of best distances must be equal
+		std::cout << "links: " << links.size()
+			<< ", full scan: " << scanTime / clickCount << " ms/click"
+			<< ", bounded scan: " << boundedTime / clickCount << " ms/click"
+			<< ", matcher: " << matcherTime / clickCount << " ms/click"
+			<< ", distance sums: " << scanSum << "/" << boundedSum << "/" << matcherSum << std::endl;
+	}
+
+	return 0;
+}
@@ -0,0 +1,179 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Round trip of browser side connection, tracker host process and mock plugin.
+// Must be placed next to TrackerHost and MockPlugin, like the browser. Checks
+// that samples are delivered and calibration is answered, that the host is
+// restarted after it has been killed or hangs in calibration, and that the
+// host exits by itself on shutdown. Returns non-zero when a check fails.
+//
+// Usage: TrackerHostRoundTrip
+
+#include "src/Input/TrackerHostConnection.h"
+#include "src/Global.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+// Timing
+static const int SUPERVISION_INTERVAL = 10; // milliseconds
+static const int WAIT_TIMEOUT_MS = 15000; // milliseconds
+static const int CALIBRATION_TIMEOUT = 2000; // milliseconds
+
+// Count of failed checks
+static int failures = 0;
+
+// Report result of check
+static void Check(bool condition, const std::string& rDescription)
+{
+	std::cout << (condition ? "[ OK ] " : "[FAIL] ") << rDescription << std::endl;
+	if (!condition) { failures++; }
+}
+
+// Wait until condition holds, returns whether it did before timeout
+static bool WaitFor(std::function<bool()> condition, int timeout = WAIT_TIMEOUT_MS)
+{
+	const int64_t deadline = sample_ring::Now() + timeout;
+	while (!condition())
+	{
+		if (sample_ring::Now() > deadline) { return false; }
+		std::this_thread::sleep_for(std::chrono::milliseconds(SUPERVISION_INTERVAL));
+	}
+	return true;
+}
+
+// Fetch samples for given time, returns their count
+static size_t CountSamples(TrackerHostConnection& rConnection, int duration)
+{
+	SampleQueue spSamples = SampleQueue(new std::deque<SampleData>);
+	rConnection.FetchSamples(spSamples); // skip old ones
+	spSamples->clear();
+	std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+	rConnection.FetchSamples(spSamples);
+	return spSamples->size();
+}
+
+// Name of shared memory, which is passed to host of this process
+static std::string SharedMemoryName()
+{
+#ifdef _WIN32
+	return TRACKER_HOST_SHARED_MEMORY_NAME + std::to_string((unsigned long)GetCurrentProcessId());
+#else
+	return TRACKER_HOST_SHARED_MEMORY_NAME + std::to_string((unsigned long)getpid());
+#endif
+}
+
+#ifndef _WIN32
+// Pattern matching command line of host, but not the shell executing the search
+static std::string ProcessPattern()
+{
+	const std::string name = SharedMemoryName();
+	return "'[" + name.substr(0, 1) + "]" + name.substr(1) + "'";
+}
+#endif
+
+// Kill host of this process like a crash would
+static void KillHost()
+{
+#ifdef _WIN32
+	std::system(("taskkill /F /IM " + TRACKER_HOST_EXECUTABLE_NAME + ".exe > NUL").c_str());
+#else
+	std::system(("pkill -KILL -f " + ProcessPattern()).c_str());
+#endif
+}
+
+// Whether host of this process is running
+static bool IsHostRunning()
+{
+#ifdef _WIN32
+	return std::system(("tasklist /FI \"IMAGENAME eq " + TRACKER_HOST_EXECUTABLE_NAME + ".exe\" | find /I \"" + TRACKER_HOST_EXECUTABLE_NAME + "\" > NUL").c_str()) == 0;
+#else
+	return std::system(("pgrep -f " + ProcessPattern() + " > /dev/null").c_str()) == 0;
+#endif
+}
+
+// Set environment variable inherited by host
+static void SetEnvironment(const char* pName, const char* pValue)
+{
+#ifdef _WIN32
+	_putenv_s(pName, pValue);
+#else
+	setenv(pName, pValue, 1);
+#endif
+}
+
+int main()
+{
+	SetEnvironment("GTW_MOCK_SAMPLERATE", "120");
+	SetEnvironment("GTW_MOCK_STALL_CALIBRATION", "0");
+
+	// Connection, supervised by own thread like in eye input
+	EyetrackerGeometry geometry;
+	std::unique_ptr<TrackerHostConnection> upConnection = std::unique_ptr<TrackerHostConnection>(
+		new TrackerHostConnection(geometry, { "MockPlugin" }, CALIBRATION_TIMEOUT));
+	if (!upConnection->IsValid())
+	{
+		std::cerr << "Failed to create shared memory." << std::endl;
+		return 1;
+	}
+	std::atomic<bool> supervising(true);
+	std::thread supervisor([&]()
+	{
+		while (supervising)
+		{
+			upConnection->Supervise();
+			std::this_thread::sleep_for(std::chrono::milliseconds(SUPERVISION_INTERVAL));
+		}
+	});
+	TrackerHostConnection& rConnection = *upConnection;
+
+	// Samples
+	Check(WaitFor([&]() { return rConnection.IsConnected(); }), "Host connects mock plugin");
+	Check(rConnection.GetPluginName() == "MockPlugin", "Plugin name is reported");
+	const size_t sampleCount = CountSamples(rConnection, 1000);
+	std::cout << "       " << sampleCount << " samples in one second" << std::endl;
+	Check(sampleCount >= 60, "Samples are delivered");
+
+	// Calibration
+	std::shared_ptr<CalibrationInfo> spInfo;
+	Check(rConnection.Calibrate(spInfo) == CALIBRATION_OK && spInfo && spInfo->size() == 5, "Calibration is answered");
+
+	// Restart after crash, restarted host stalls in calibration
+	SetEnvironment("GTW_MOCK_STALL_CALIBRATION", "1");
+	int restartCount = rConnection.GetRestartCount();
+	KillHost();
+	Check(WaitFor([&]() { return rConnection.GetRestartCount() > restartCount; }), "Killed host is detected");
+	Check(WaitFor([&]() { return rConnection.IsConnected(); }), "Host is restarted");
+	Check(CountSamples(rConnection, 1000) >= 60, "Samples resume after restart");
+
+	// Restart after hanging calibration
+	restartCount = rConnection.GetRestartCount();
+	const int64_t calibrationStart = sample_ring::Now();
+	Check(rConnection.Calibrate(spInfo) == CALIBRATION_FAILED, "Hanging calibration fails");
+	Check(sample_ring::Now() - calibrationStart < CALIBRATION_TIMEOUT + 1000, "Hanging calibration returns after timeout");
+	Check(WaitFor([&]() { return rConnection.GetRestartCount() > restartCount; }), "Host hanging in calibration is restarted");
+	Check(WaitFor([&]() { return rConnection.IsConnected(); }), "Host is restarted after calibration timeout");
+	restartCount = rConnection.GetRestartCount();
+	Check(CountSamples(rConnection, setup::TRACKER_HOST_HEARTBEAT_TIMEOUT + 1000) >= 60, "Samples resume after calibration timeout");
+	Check(rConnection.GetRestartCount() == restartCount, "Restarted host does not repeat calibration");
+
+	// Shutdown
+	supervising = false;
+	supervisor.join();
+	const int64_t shutdownStart = sample_ring::Now();
+	upConnection = nullptr;
+	Check(sample_ring::Now() - shutdownStart < setup::TRACKER_HOST_EXIT_TIMEOUT, "Host exits without being killed");
+	Check(!IsHostRunning(), "No host is left running");
+
+	std::cout << (failures == 0 ? "All checks passed." : std::to_string(failures) + " checks failed.") << std::endl;
+	return failures == 0 ? 0 : 1;
+}
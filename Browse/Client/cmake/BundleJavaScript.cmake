@@ -0,0 +1,17 @@
+# Bundles JavaScript files into a list of bytes, which is included as array
+# initializer by C++ code. Avoids limits of compilers on string literal length.
+#
+# Usage: cmake -DDIRECTORY=<folder> -DFILES=<a.js,b.js> -DOUTPUT=<file> -P BundleJavaScript.cmake
+
+string(REPLACE "," ";" FILES "${FILES}")
+
+set(BYTES "")
+foreach(FILE ${FILES})
+	file(READ "${DIRECTORY}/${FILE}" CONTENT HEX)
+	set(BYTES "${BYTES}${CONTENT}0a") # separate files by new line
+endforeach()
+
+# Format bytes as initializer, terminated by zero
+string(REGEX REPLACE "([0-9a-f][0-9a-f])" "0x\\1," BYTES "${BYTES}")
+string(REPLACE "0x0a," "0x0a,\n" BYTES "${BYTES}") # line breaks of scripts
+file(WRITE "${OUTPUT}" "// Generated by BundleJavaScript.cmake, do not edit\n${BYTES}0x00\n")
@@ -0,0 +1,151 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Layout of shared memory between browser and tracker host process. Samples
+// are written by the host into a ring of slots, each guarded by a sequence
+// number, so the browser reads them without locking. The sequence is odd
+// while a slot is written. Besides samples, the memory carries state of the
+// host, its heartbeat and commands of the browser. Memory is created by the
+// browser and survives restarts of the host.
+
+#ifndef SAMPLERING_H_
+#define SAMPLERING_H_
+
+#include <atomic>
+#include <cstdint>
+#include <chrono>
+
+#if ATOMIC_LLONG_LOCK_FREE != 2
+#error Shared memory transport requires lock free 64 bit atomics.
+#endif
+
+namespace sample_ring
+{
+	// Constants
+	static const uint32_t MAGIC = 0x47545752; // "GTWR"
+	static const uint32_t VERSION = 1;
+	static const uint32_t CAPACITY = 4096; // samples, more than a second of fastest trackers
+	static const int MAX_CALIBRATION_POINTS = 32;
+	static const int PLUGIN_NAME_LENGTH = 64;
+
+	// State of host
+	enum HostState : uint32_t
+	{
+		HOST_STARTING, // process started, no plugin loaded yet
+		HOST_CONNECTING, // trying to connect plugins
+		HOST_CONNECTED, // plugin connected eye tracker
+		HOST_NOT_AVAILABLE // no plugin could connect an eye tracker, host retries
+	};
+
+	// Slot of sample
+	struct Slot
+	{
+		std::atomic<uint64_t> sequence; // 2 * index + 2 when written
+		std::atomic<double> x;
+		std::atomic<double> y;
+		std::atomic<int64_t> timestamp; // milliseconds since epoch of system clock
+	};
+
+	// Calibration point as reported by plugin
+	struct CalibrationPointData
+	{
+		int32_t positionX;
+		int32_t positionY;
+		int32_t result;
+	};
+
+	// Complete shared memory
+	struct Ring
+	{
+		// Written by browser before host is started
+		uint32_t magic;
+		uint32_t version;
+		uint32_t capacity;
+		int32_t monitorWidth;
+		int32_t monitorHeight;
+		int32_t mountingAngle;
+		int32_t relativeDistanceHeight;
+		int32_t relativeDistanceDepth;
+
+		// Written by host
+		std::atomic<uint32_t> hostState;
+		std::atomic<uint32_t> tracking;
+		std::atomic<int32_t> samplerate; // as reported by plugin
+		std::atomic<int32_t> measuredSamplerate; // samples written within last second
+		std::atomic<int64_t> hostHeartbeat; // milliseconds since epoch of system clock
+		char pluginName[PLUGIN_NAME_LENGTH]; // valid once state is connected
+
+		// Written by browser
+		std::atomic<int64_t> browserHeartbeat; // host exits when browser is gone
+		std::atomic<uint32_t> labStream; // whether lab stream should be sent
+		std::atomic<uint32_t> shutdown;
+
+		// Calibration, requested by browser through incrementing request
+		std::atomic<uint32_t> calibrationRequest;
+		std::atomic<uint32_t> calibrationDone;
+		int32_t calibrationResult;
+		int32_t calibrationPointCount;
+		CalibrationPointData calibrationPoints[MAX_CALIBRATION_POINTS];
+
+		// Samples
+		std::atomic<uint64_t> writeIndex; // count of samples ever written
+		Slot slots[CAPACITY];
+	};
+
+	// Current time as used for heartbeats
+	inline int64_t Now()
+	{
+		using namespace std::chrono;
+		return duration_cast<milliseconds>(system_clock::now().time_since_epoch()).count();
+	}
+
+	// Initialize memory, which is expected to be zeroed like fresh shared memory. Called by browser
+	inline void Initialize(Ring& rRing)
+	{
+		rRing.magic = MAGIC;
+		rRing.version = VERSION;
+		rRing.capacity = CAPACITY;
+		rRing.hostState = HOST_STARTING;
+		rRing.labStream = 1;
+		rRing.browserHeartbeat = Now();
+	}
+
+	// Whether memory has been initialized by compatible browser
+	inline bool IsCompatible(const Ring& rRing)
+	{
+		return rRing.magic == MAGIC && rRing.version == VERSION && rRing.capacity == CAPACITY;
+	}
+
+	// Append sample. Only one writer at a time
+	inline void Write(Ring& rRing, double x, double y, int64_t timestamp)
+	{
+		const uint64_t index = rRing.writeIndex.load(std::memory_order_relaxed);
+		Slot& rSlot = rRing.slots[index % CAPACITY];
+		rSlot.sequence.store(2 * index + 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_release);
+		rSlot.x.store(x, std::memory_order_relaxed);
+		rSlot.y.store(y, std::memory_order_relaxed);
+		rSlot.timestamp.store(timestamp, std::memory_order_relaxed);
+		rSlot.sequence.store(2 * index + 2, std::memory_order_release);
+		rRing.writeIndex.store(index + 1, std::memory_order_release);
+	}
+
+	// Read sample with given index. Returns false when it has been overwritten meanwhile
+	inline bool Read(const Ring& rRing, uint64_t index, double& rX, double& rY, int64_t& rTimestamp)
+	{
+		const Slot& rSlot = rRing.slots[index % CAPACITY];
+		const uint64_t sequence = rSlot.sequence.load(std::memory_order_acquire);
+		if (sequence != 2 * index + 2)
+		{
+			return false;
+		}
+		rX = rSlot.x.load(std::memory_order_relaxed);
+		rY = rSlot.y.load(std::memory_order_relaxed);
+		rTimestamp = rSlot.timestamp.load(std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_acquire);
+		return rSlot.sequence.load(std::memory_order_relaxed) == sequence;
+	}
+}
+
+#endif // SAMPLERING_H_
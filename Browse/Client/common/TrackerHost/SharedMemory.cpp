@@ -0,0 +1,80 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "SharedMemory.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+SharedMemory::SharedMemory(std::string name, size_t size, bool create) : _name(name), _size(size), _owner(create)
+{
+#ifdef _WIN32
+	HANDLE handle = NULL;
+	if (create)
+	{
+		handle = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)size >> 32), (DWORD)(size & 0xFFFFFFFF), name.c_str());
+	}
+	else
+	{
+		handle = OpenFileMappingA(FILE_MAP_ALL_ACCESS, FALSE, name.c_str());
+	}
+	if (handle == NULL)
+	{
+		return;
+	}
+	_pData = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+	if (_pData == NULL)
+	{
+		CloseHandle(handle);
+		return;
+	}
+	_handle = handle;
+#else
+	const std::string path = "/" + name;
+	int descriptor = create ? shm_open(path.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600) : shm_open(path.c_str(), O_RDWR, 0600);
+	if (descriptor < 0)
+	{
+		return;
+	}
+	if (create && ftruncate(descriptor, (off_t)size) != 0)
+	{
+		close(descriptor);
+		shm_unlink(path.c_str());
+		return;
+	}
+	void* pData = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, descriptor, 0);
+	close(descriptor); // mapping stays valid
+	if (pData == MAP_FAILED)
+	{
+		if (create) { shm_unlink(path.c_str()); }
+		return;
+	}
+	_pData = pData;
+#endif
+}
+
+SharedMemory::~SharedMemory()
+{
+	if (_pData == nullptr)
+	{
+		return;
+	}
+#ifdef _WIN32
+	UnmapViewOfFile(_pData);
+	CloseHandle((HANDLE)_handle); // memory is gone when last handle is closed
+#else
+	munmap(_pData, _size);
+	if (_owner)
+	{
+		shm_unlink(("/" + _name).c_str());
+	}
+#endif
+}
@@ -0,0 +1,43 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Named shared memory, mapped into address space of the process. Creating
+// process owns the name and removes it on destruction.
+
+#ifndef SHAREDMEMORY_H_
+#define SHAREDMEMORY_H_
+
+#include <string>
+#include <cstddef>
+
+class SharedMemory
+{
+public:
+
+	// Constructor, creates new memory or opens existing one. Check IsValid afterwards
+	SharedMemory(std::string name, size_t size, bool create);
+
+	// Destructor
+	virtual ~SharedMemory();
+
+	// Whether memory could be mapped
+	bool IsValid() const { return _pData != nullptr; }
+
+	// Pointer to mapped memory
+	void* GetData() const { return _pData; }
+
+	// Name of memory
+	std::string GetName() const { return _name; }
+
+private:
+
+	// Members
+	std::string _name;
+	size_t _size;
+	bool _owner;
+	void* _pData = nullptr;
+	void* _handle = nullptr; // only used on Windows
+};
+
+#endif // SHAREDMEMORY_H_
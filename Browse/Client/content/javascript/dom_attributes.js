@@ -3,8 +3,6 @@
 // Author: Daniel Mueller (muellerd@uni-koblenz.de)
 //============================================================================
 
-ConsolePrint("Starting to import dom_attributes.js ...");
-
 // Filled using C++
 window.attrStrToInt = new Map();
 function AddDOMAttribute(attrStr, attrInt)
@@ -112,4 +110,3 @@ function FetchAndEncodeAttribute(domObj, attrStr)
 
 
 
-ConsolePrint("Successfully imported dom_attributes.js!");
\ No newline at end of file
@@ -3,8 +3,6 @@
 // Author: Daniel Mueller (muellerd@uni-koblenz.de)
 //============================================================================
 
-ConsolePrint("Starting to import dom_fixed_elements.js ...");
-
 window.domFixedElements = [];
 /**
  * REFACTORING TODOs
@@ -265,4 +263,3 @@ function IsRectContained(rect, container)
 
     return false;
 }
-ConsolePrint("Successfully imported dom_fixed_elements.js!");
\ No newline at end of file
@@ -0,0 +1,25 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Scripts are registered once as extension of the render process and executed
+// in every new context. They only define functions and data, so nothing happens
+// on a page until the render process calls DOMInit for its main frame.
+
+// Initialize page, returns duration of script setup in milliseconds
+function DOMInit()
+{
+    var t_start = performance.now();
+    window.starting_time_ = t_start;
+
+    // Variables which are read after page finished loading
+    window._pageWidth = -1;
+    window._pageHeight = -1;
+    window.favIconHeight = -1;
+    window.favIconWidth = -1;
+
+    DocumentHandlersInit();
+    MutationObserverInit();
+
+    return window._domScriptImportTime + (performance.now() - t_start);
+}
@@ -2,140 +2,143 @@
 // Distributed under the Apache License, Version 2.0.
 // Author: Daniel Mueller (muellerd@uni-koblenz.de)
 //============================================================================
-ConsolePrint("Starting to import dom_mutationobserver.js ...");
-
-// Log which type of HTML element was clicked
-document.onclick = function(e){
-	if (e && e.target && e.target.tagName)
-	{
-	    SendDataMessage(e.target.tagName.toLowerCase() + "," + e.target.id + "," + e.pageX + "," + e.pageY);
+// Register handlers on document and window. Called by DOMInit, because scripts
+// are imported into every context of the render process
+function DocumentHandlersInit()
+{
+	// Log which type of HTML element was clicked
+	document.onclick = function(e){
+		if (e && e.target && e.target.tagName)
+		{
+		    SendDataMessage(e.target.tagName.toLowerCase() + "," + e.target.id + "," + e.pageX + "," + e.pageY);
+		}
 	}
-}
 
-// window.appendedSubtreeRoots = new Set();
+	// window.appendedSubtreeRoots = new Set();
 
-// Trigger DOM data update on changing document loading status
-document.onreadystatechange = function()
-{
-	console.log("document.readyState == "+document.readyState);
-	ConsolePrint("document.readyState == "+document.readyState);
-
-	// TODO: First change of OccBitmask isn't recognized by CEF!
-	if(document.readyState === "loading" || document.readyState === "complete")
+	// Trigger DOM data update on changing document loading status
+	document.onreadystatechange = function()
 	{
-		window.domNodes.forEach((list) => {
-			// Force send message about attribute changes
-			list.forEach((o) => { SendAttributeChangesToCEF("OccBitmask", o); });
-		});
-	}
+		console.log("document.readyState == "+document.readyState);
+		ConsolePrint("document.readyState == "+document.readyState);
 
-	if(document.readyState === "complete")
-	{
-		var keywords = document.querySelector("meta[name='keywords']");
-		if(keywords && keywords.content)
+		// TODO: First change of OccBitmask isn't recognized by CEF!
+		if(document.readyState === "loading" || document.readyState === "complete")
 		{
-			SendToMsgRouter("#meta#keywords#"+keywords.content+"#");
+			window.domNodes.forEach((list) => {
+				// Force send message about attribute changes
+				list.forEach((o) => { SendAttributeChangesToCEF("OccBitmask", o); });
+			});
 		}
-		else
+
+		if(document.readyState === "complete")
 		{
-			SendToMsgRouter("#meta#keywords##");
+			var keywords = document.querySelector("meta[name='keywords']");
+			if(keywords && keywords.content)
+			{
+				SendToMsgRouter("#meta#keywords#"+keywords.content+"#");
+			}
+			else
+			{
+				SendToMsgRouter("#meta#keywords##");
+			}
 		}
-	}
 
-	// BUGFIX
-	// if (document.readyState === "complete")
-	// 	ForEveryChild(document.documentElement, AnalyzeNode);
+		// BUGFIX
+		// if (document.readyState === "complete")
+		// 	ForEveryChild(document.documentElement, AnalyzeNode);
 
-	// domOverflowElements.forEach(
-	// 	(o) => { o.checkIfOverflown(); }
-	// );
+		// domOverflowElements.forEach(
+		// 	(o) => { o.checkIfOverflown(); }
+		// );
 
-	// if(document.readyState === "complete")
-	// {
-	// 	console.log("Marking all available nodes...");
-	// 	ForEveryChild(document.documentElement, (n) => {n.seen = true; })
-	// }
+		// if(document.readyState === "complete")
+		// {
+		// 	console.log("Marking all available nodes...");
+		// 	ForEveryChild(document.documentElement, (n) => {n.seen = true; })
+		// }
 
-	// INFO: Not analyzed nodes are more commenly added after page load completion!
-	//if(document.readyState === "complete")
-		// CountAnalyzedNodes();
-}
+		// INFO: Not analyzed nodes are more commenly added after page load completion!
+		//if(document.readyState === "complete")
+			// CountAnalyzedNodes();
+	}
 
-window.onwebkitfullscreenchange = function()
-{
-	UpdateDOMRects("onwebkitfullscreenchange");
-}
+	window.onwebkitfullscreenchange = function()
+	{
+		UpdateDOMRects("onwebkitfullscreenchange");
+	}
 
-window.onresize = function()
-{
-	//UpdateDOMRects();
-	// TODO: Update fixed elements' Rects too?
-	ConsolePrint("Javascript detected window resize, update of fixed element Rects.");
-}
+	window.onresize = function()
+	{
+		//UpdateDOMRects();
+		// TODO: Update fixed elements' Rects too?
+		ConsolePrint("Javascript detected window resize, update of fixed element Rects.");
+	}
 
 
-// Update rects if CSS transition took place (TODO: Needed if parent's rects didn't change?)
-document.addEventListener('transitionend', function(event){
-	// Tree, whose children have to be check for rect updates
-	var root = event.target;
+	// Update rects if CSS transition took place (TODO: Needed if parent's rects didn't change?)
+	document.addEventListener('transitionend', function(event){
+		// Tree, whose children have to be check for rect updates
+		var root = event.target;
 
-	// TODO: Hiding reason should be shared with children, altough
-	var fixedElem = GetFixedElementByNode(root);
-	if(fixedElem !== undefined)
-	{
-		// If root is fixed element, subtree will be updated by simply calling updateRects
-		fixedElem.updateRects();
-		return;
-	}
+		// TODO: Hiding reason should be shared with children, altough
+		var fixedElem = GetFixedElementByNode(root);
+		if(fixedElem !== undefined)
+		{
+			// If root is fixed element, subtree will be updated by simply calling updateRects
+			fixedElem.updateRects();
+			return;
+		}
 
-	// DOMObjects might not be visible if any parent has opacity == 0, so store information about
-	// possible hidding parents as node attributes, check these in DOMNode.updateRects
-	var hiding_reason = undefined;
-	var cs = window.getComputedStyle(root, null);
-	if(cs.getPropertyValue("opacity") === "0")
-		hiding_reason = "opacity";
+		// DOMObjects might not be visible if any parent has opacity == 0, so store information about
+		// possible hidding parents as node attributes, check these in DOMNode.updateRects
+		var hiding_reason = undefined;
+		var cs = window.getComputedStyle(root, null);
+		if(cs.getPropertyValue("opacity") === "0")
+			hiding_reason = "opacity";
 
-	// Update rects of given root node
-	var obj = GetCorrespondingDOMObject(root);
-	if(obj !== undefined)
-		obj.updateRects();
+		// Update rects of given root node
+		var obj = GetCorrespondingDOMObject(root);
+		if(obj !== undefined)
+			obj.updateRects();
 
-	// Update rects of whole subtree beneath root node
-	ForEveryChild(root, 
-		(child) => {
-			if(typeof(child.getAttribute) !== "function")
-				return;
+		// Update rects of whole subtree beneath root node
+		ForEveryChild(root, 
+			(child) => {
+				if(typeof(child.getAttribute) !== "function")
+					return;
 
-			if(hiding_reason !== undefined && child.hidden_by === undefined)
-				child.hidden_by = new Map();
+				if(hiding_reason !== undefined && child.hidden_by === undefined)
+					child.hidden_by = new Map();
 
-			if(hiding_reason === undefined && child.hidden_by !== undefined && child.hidden_by.has(root))
-				child.hidden_by.delete(root);
+				if(hiding_reason === undefined && child.hidden_by !== undefined && child.hidden_by.has(root))
+					child.hidden_by.delete(root);
 
-			if(hiding_reason !== undefined)
-				child.hidden_by.set(root, hiding_reason);
+				if(hiding_reason !== undefined)
+					child.hidden_by.set(root, hiding_reason);
 
 
-			var fixedElem = GetFixedElementByNode(child);
-			if(fixedElem === undefined)
-			{
-				var obj = GetCorrespondingDOMObject(child);
-				if (obj !== undefined)
+				var fixedElem = GetFixedElementByNode(child);
+				if(fixedElem === undefined)
 				{
-					obj.updateRects();
+					var obj = GetCorrespondingDOMObject(child);
+					if (obj !== undefined)
+					{
+						obj.updateRects();
+					}
 				}
+				else
+					fixedElem.updateRects();
+			},
+			(child) => {
+				// Abort rect update of childs subtree, if child is fixed element
+				// With child as fixed element, rect updates for subtree will be triggered anyway
+				return (GetFixedElementByNode(child) !== undefined);
 			}
-			else
-				fixedElem.updateRects();
-		},
-		(child) => {
-			// Abort rect update of childs subtree, if child is fixed element
-			// With child as fixed element, rect updates for subtree will be triggered anyway
-			return (GetFixedElementByNode(child) !== undefined);
-		}
-	); // ForEveryChild end
+		); // ForEveryChild end
 
-}, false);
+	}, false);
+}
 
 
 
@@ -846,8 +849,6 @@ function CreateCustomMutationObserver(node, attrFunc, childFunc)
 }
 
 
-ConsolePrint("Successfully imported dom_mutationobserver.js!");
-
 
 // window.onchange = function(e){ConsolePrint("Window changes: "+e);};
 
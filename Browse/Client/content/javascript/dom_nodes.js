@@ -8,8 +8,6 @@
  * getters. Attribute setting will be handled by the MutationObserver.
  * Methods for user interaction with node objects can be found in dom_nodes_interaction.js
  */
-ConsolePrint("Starting to import dom_nodes.js ...");
-
 /*
     ____  ____  __  ____   __          __   
    / __ \/ __ \/  |/  / | / /___  ____/ /__ 
@@ -703,4 +701,3 @@ DOMCheckbox.prototype.getCheckedState = function()
     return this.node.checked;
 }
 
-ConsolePrint("Successfully imported dom_nodes.js!");
@@ -4,8 +4,6 @@
 //============================================================================
 
 
-ConsolePrint("Starting to import dom_nodes_helpers.js ...");
-
 DOMNode.prototype.setCppReady = function(){
     this.cppReady = true;
 }
@@ -40,4 +38,3 @@ DOMNode.prototype.setRectsToZero = function(){
 }
 
 
-ConsolePrint("Successfully imported dom_nodes_helpers.js!");
\ No newline at end of file
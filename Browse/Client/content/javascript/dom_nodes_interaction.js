@@ -1,5 +1,3 @@
-ConsolePrint("Starting to import dom_nodes_interaction.js ...");
-
 
 
 DOMTextInput.prototype.inputText = function(text, submit){
@@ -142,6 +140,15 @@ DOMOverflowElement.prototype.scroll = function(gazeX, gazeY, fixedIds){
 	
 }
 
+DOMOverflowElement.prototype.scrollBy = function(deltaX, deltaY){
+	if(this.hidden_overflow)
+		return [0,0];
+
+	this.node.scrollLeft += deltaX;
+	this.node.scrollTop += deltaY;
+	return [deltaX, deltaY];
+}
+
 DOMVideo.prototype.setPlaying = function(playing)
 {
     if (playing)
@@ -277,4 +284,3 @@ DOMCheckbox.prototype.setChecked = function(state)
 	console.log("DOMCheckbox, "+this.getId()+": Setting to checked to '"+checked+"'.");
 }
 
-ConsolePrint("Successfully imported dom_nodes_interaction.js!");
@@ -6,6 +6,10 @@
 // Helper function for console output
 function ConsolePrint(msg)
 {
+    // Message router is only available after context creation
+    if(window.cefQuery === undefined)
+        return;
+
     window.cefQuery({ 
         request: ("" + msg), 
         persistent : false, 
@@ -20,8 +24,6 @@ function SendToMsgRouter(msg)
     ConsolePrint(msg);
 }
 
-ConsolePrint("Starting to import helpers.js ...");
-
 
 // TODO: Move CEF callable functions to separate js-file
 function CefPoll(num_partitions, update_partition)
@@ -636,4 +638,3 @@ function SetOverflowObjectViaId(node, id)
     return undefined;
 }
 
-ConsolePrint("Successfully imported helpers.js!");
\ No newline at end of file
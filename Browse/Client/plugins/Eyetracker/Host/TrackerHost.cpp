@@ -0,0 +1,295 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Process that loads an eye tracker plugin and writes its samples into shared
+// memory created by the browser. A crashing or hanging vendor library takes
+// down this process only, which is restarted by the browser. Host exits when
+// browser requests shutdown or its heartbeat stops.
+//
+// Usage: TrackerHost <shared memory name> <plugin> [<plugin> ...]
+
+#include "plugins/Eyetracker/Interface/EyetrackerSample.h"
+#include "plugins/Eyetracker/Interface/EyetrackerInfo.h"
+#include "plugins/Eyetracker/Interface/EyetrackerGeometry.h"
+#include "common/TrackerHost/SampleRing.h"
+#include "common/TrackerHost/SharedMemory.h"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstring>
+
+#ifdef _WIN32
+#include <windows.h>
+#define PLUGIN_CALL __cdecl
+#else
+#include <dlfcn.h>
+#include <unistd.h>
+#include <climits>
+#define PLUGIN_CALL
+#endif
+
+// Procedures of plugin
+typedef EyetrackerInfo(PLUGIN_CALL *CONNECT)(EyetrackerGeometry);
+typedef bool(PLUGIN_CALL *IS_TRACKING)();
+typedef bool(PLUGIN_CALL *DISCONNECT)();
+typedef void(PLUGIN_CALL *FETCH_SAMPLES)(SampleQueue&);
+typedef CalibrationResult(PLUGIN_CALL *CALIBRATE)(std::shared_ptr<CalibrationInfo>&);
+typedef void(PLUGIN_CALL *CONTINUE_LAB_STREAM)();
+typedef void(PLUGIN_CALL *PAUSE_LAB_STREAM)();
+
+// Timing
+static const int LOOP_INTERVAL = 1; // milliseconds
+static const int TRACKING_CHECK_INTERVAL = 100; // milliseconds
+static const int CONNECT_RETRY_INTERVAL = 3000; // milliseconds
+static const int BROWSER_TIMEOUT = 5000; // milliseconds
+
+// Loaded plugin
+class Plugin
+{
+public:
+
+	// Constructor, loads library. Check IsValid afterwards
+	Plugin(std::string name)
+	{
+#ifdef _WIN32
+		const std::string path = name + ".dll";
+		_handle = (void*)LoadLibraryA(path.c_str());
+#else
+		// Plugins are placed next to host executable
+		std::string directory = ".";
+		char buffer[PATH_MAX];
+		const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+		if (length > 0)
+		{
+			directory = std::string(buffer, length);
+			directory = directory.substr(0, directory.find_last_of('/'));
+		}
+		const std::string path = name.find('/') != std::string::npos ? name : directory + "/lib" + name + ".so";
+		_handle = dlopen(path.c_str(), RTLD_NOW | RTLD_LOCAL);
+		if (_handle == nullptr)
+		{
+			std::cerr << "TrackerHost: " << dlerror() << std::endl;
+		}
+#endif
+		if (_handle == nullptr)
+		{
+			return;
+		}
+		procConnect = (CONNECT)Resolve("Connect");
+		procIsTracking = (IS_TRACKING)Resolve("IsTracking");
+		procDisconnect = (DISCONNECT)Resolve("Disconnect");
+		procFetchSamples = (FETCH_SAMPLES)Resolve("FetchSamples");
+		procCalibrate = (CALIBRATE)Resolve("Calibrate");
+		procContinueLabStream = (CONTINUE_LAB_STREAM)Resolve("ContinueLabStream");
+		procPauseLabStream = (PAUSE_LAB_STREAM)Resolve("PauseLabStream");
+	}
+
+	// Destructor, unloads library
+	virtual ~Plugin()
+	{
+		if (_handle == nullptr)
+		{
+			return;
+		}
+#ifdef _WIN32
+		FreeLibrary((HINSTANCE)_handle);
+#else
+		dlclose(_handle);
+#endif
+	}
+
+	// Whether library is loaded and provides the necessary procedures
+	bool IsValid() const
+	{
+		return _handle != nullptr && procConnect != nullptr && procIsTracking != nullptr && procFetchSamples != nullptr && procCalibrate != nullptr;
+	}
+
+	// Procedures, optional ones may be null
+	CONNECT procConnect = nullptr;
+	IS_TRACKING procIsTracking = nullptr;
+	DISCONNECT procDisconnect = nullptr;
+	FETCH_SAMPLES procFetchSamples = nullptr;
+	CALIBRATE procCalibrate = nullptr;
+	CONTINUE_LAB_STREAM procContinueLabStream = nullptr;
+	PAUSE_LAB_STREAM procPauseLabStream = nullptr;
+
+private:
+
+	// Resolve procedure by name
+	void* Resolve(const char* pName) const
+	{
+#ifdef _WIN32
+		return (void*)GetProcAddress((HINSTANCE)_handle, pName);
+#else
+		return dlsym(_handle, pName);
+#endif
+	}
+
+	// Members
+	void* _handle = nullptr;
+};
+
+// Try plugins in given order, returns connected one or null
+static std::unique_ptr<Plugin> ConnectPlugin(const std::vector<std::string>& rNames, sample_ring::Ring& rRing)
+{
+	EyetrackerGeometry geometry;
+	geometry.monitorWidth = rRing.monitorWidth;
+	geometry.monitorHeight = rRing.monitorHeight;
+	geometry.mountingAngle = rRing.mountingAngle;
+	geometry.relativeDistanceHeight = rRing.relativeDistanceHeight;
+	geometry.relativeDistanceDepth = rRing.relativeDistanceDepth;
+
+	for (const auto& rName : rNames)
+	{
+		std::unique_ptr<Plugin> upPlugin = std::unique_ptr<Plugin>(new Plugin(rName));
+		if (!upPlugin->IsValid())
+		{
+			std::cerr << "TrackerHost: Failed to load " << rName << "." << std::endl;
+			continue;
+		}
+		const EyetrackerInfo info = upPlugin->procConnect(geometry);
+		if (info.connected)
+		{
+			std::cout << "TrackerHost: Connected eye tracker via " << rName << "." << std::endl;
+			std::strncpy(rRing.pluginName, rName.c_str(), sample_ring::PLUGIN_NAME_LENGTH - 1);
+			rRing.samplerate = info.samplerate;
+			return upPlugin;
+		}
+		std::cout << "TrackerHost: No eye tracker connected via " << rName << "." << std::endl;
+	}
+	return nullptr;
+}
+
+// Execute calibration requested by browser
+static void Calibrate(Plugin& rPlugin, sample_ring::Ring& rRing)
+{
+	std::shared_ptr<CalibrationInfo> spInfo = std::make_shared<CalibrationInfo>();
+	const CalibrationResult result = rPlugin.procCalibrate(spInfo);
+	int count = 0;
+	if (spInfo)
+	{
+		for (const auto& rPoint : *spInfo)
+		{
+			if (count >= sample_ring::MAX_CALIBRATION_POINTS) { break; }
+			rRing.calibrationPoints[count].positionX = rPoint.positionX;
+			rRing.calibrationPoints[count].positionY = rPoint.positionY;
+			rRing.calibrationPoints[count].result = (int32_t)rPoint.result;
+			count++;
+		}
+	}
+	rRing.calibrationPointCount = count;
+	rRing.calibrationResult = (int32_t)result;
+}
+
+int main(int argc, char* argv[])
+{
+	if (argc < 3)
+	{
+		std::cerr << "Usage: TrackerHost <shared memory name> <plugin> [<plugin> ...]" << std::endl;
+		return 1;
+	}
+
+	// Open shared memory of browser
+	SharedMemory memory(argv[1], sizeof(sample_ring::Ring), false);
+	if (!memory.IsValid() || !sample_ring::IsCompatible(*(sample_ring::Ring*)memory.GetData()))
+	{
+		std::cerr << "TrackerHost: Could not open shared memory " << argv[1] << "." << std::endl;
+		return 1;
+	}
+	sample_ring::Ring& rRing = *(sample_ring::Ring*)memory.GetData();
+	const std::vector<std::string> pluginNames(argv + 2, argv + argc);
+
+	// State
+	std::unique_ptr<Plugin> upPlugin;
+	uint32_t calibrationRequest = rRing.calibrationDone; // requests from before restart are answered
+	bool labStream = true;
+	int64_t lastConnectAttempt = 0;
+	int64_t lastTrackingCheck = 0;
+	int64_t measureStart = sample_ring::Now();
+	uint64_t measureStartIndex = rRing.writeIndex;
+
+	// Loop until shutdown
+	while (!rRing.shutdown && sample_ring::Now() - rRing.browserHeartbeat.load() < BROWSER_TIMEOUT)
+	{
+		const int64_t now = sample_ring::Now();
+		rRing.hostHeartbeat = now;
+
+		// Connect eye tracker
+		if (!upPlugin)
+		{
+			if (now - lastConnectAttempt >= CONNECT_RETRY_INTERVAL)
+			{
+				rRing.hostState = sample_ring::HOST_CONNECTING;
+				upPlugin = ConnectPlugin(pluginNames, rRing);
+				lastConnectAttempt = sample_ring::Now();
+				if (upPlugin)
+				{
+					labStream = true; // plugins start streaming on connection
+					rRing.hostState = sample_ring::HOST_CONNECTED;
+				}
+				else
+				{
+					rRing.hostState = sample_ring::HOST_NOT_AVAILABLE;
+				}
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(LOOP_INTERVAL));
+			continue;
+		}
+
+		// Move samples into ring
+		SampleQueue spSamples = SampleQueue(new std::deque<SampleData>);
+		upPlugin->procFetchSamples(spSamples);
+		for (const auto& rSample : *spSamples)
+		{
+			sample_ring::Write(rRing, rSample.x, rSample.y, (int64_t)rSample.timestamp.count());
+		}
+
+		// Tracking state, polled less often as plugins may ask the device
+		if (now - lastTrackingCheck >= TRACKING_CHECK_INTERVAL)
+		{
+			rRing.tracking = upPlugin->procIsTracking() ? 1 : 0;
+			lastTrackingCheck = now;
+		}
+
+		// Measure sample rate
+		if (now - measureStart >= 1000)
+		{
+			const uint64_t writeIndex = rRing.writeIndex;
+			rRing.measuredSamplerate = (int32_t)((writeIndex - measureStartIndex) * 1000 / (uint64_t)(now - measureStart));
+			measureStart = now;
+			measureStartIndex = writeIndex;
+		}
+
+		// Lab stream policy
+		const bool requestedLabStream = rRing.labStream != 0;
+		if (requestedLabStream != labStream)
+		{
+			if (requestedLabStream && upPlugin->procContinueLabStream) { upPlugin->procContinueLabStream(); }
+			if (!requestedLabStream && upPlugin->procPauseLabStream) { upPlugin->procPauseLabStream(); }
+			labStream = requestedLabStream;
+		}
+
+		// Calibration blocks the loop, browser does not expect heartbeat meanwhile
+		const uint32_t request = rRing.calibrationRequest;
+		if (request != calibrationRequest)
+		{
+			Calibrate(*upPlugin, rRing);
+			calibrationRequest = request;
+			rRing.calibrationDone = request;
+		}
+
+		std::this_thread::sleep_for(std::chrono::milliseconds(LOOP_INTERVAL));
+	}
+
+	// Disconnect eye tracker
+	if (upPlugin && upPlugin->procDisconnect)
+	{
+		upPlugin->procDisconnect();
+	}
+	rRing.tracking = 0;
+	rRing.hostState = sample_ring::HOST_STARTING;
+	std::cout << "TrackerHost: Exit." << std::endl;
+	return 0;
+}
@@ -7,11 +7,15 @@
 #define EYETRACKER_H_
 
 // Decide about api style by define
+#ifdef _WIN32
 #ifdef DLL_IMPLEMENTATION  
 #define DLL_API __declspec(dllexport)   
 #else  
 #define DLL_API __declspec(dllimport)   
 #endif  
+#else
+#define DLL_API __attribute__((visibility("default"))) // shared objects are loaded by tracker host
+#endif
 
 #include "plugins/Eyetracker/Interface/EyetrackerSample.h"
 #include "plugins/Eyetracker/Interface/EyetrackerInfo.h"
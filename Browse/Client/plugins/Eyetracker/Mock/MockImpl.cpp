@@ -0,0 +1,144 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Plugin without device that generates fixations and saccades with noise, to
+// test the tracker host and input pipeline. Does not use lab streaming layer.
+// Environment variables:
+// GTW_MOCK_SAMPLERATE: samples per second, default is 120
+// GTW_MOCK_STALL_AFTER: seconds after connection when fetching hangs forever
+// GTW_MOCK_STALL_CALIBRATION: calibration hangs forever when set to 1
+
+// This is an implementation
+#define DLL_IMPLEMENTATION
+
+#include "plugins/Eyetracker/Interface/Eyetracker.h"
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <random>
+#include <cstdlib>
+
+// Global variables
+static std::mutex sampleMutex;
+static SampleQueue spSampleQueue = SampleQueue(new std::deque<SampleData>);
+static std::unique_ptr<std::thread> upGeneratorThread;
+static std::atomic<bool> generating(false);
+static std::chrono::steady_clock::time_point connectionTime;
+
+// Read integer from environment
+static int EnvironmentValue(const char* pName, int fallback)
+{
+	const char* pValue = std::getenv(pName);
+	return pValue != nullptr ? std::atoi(pValue) : fallback;
+}
+
+// Generate samples until stopped
+static void Generate(int samplerate)
+{
+	std::mt19937 generator(std::random_device{}());
+	std::uniform_real_distribution<double> positionX(100, 1820);
+	std::uniform_real_distribution<double> positionY(100, 980);
+	std::uniform_int_distribution<int> fixationSamples(samplerate / 5, samplerate); // 200 ms to 1 s
+	std::normal_distribution<double> noise(0, 5);
+
+	const auto interval = std::chrono::microseconds(1000000 / samplerate);
+	auto next = std::chrono::steady_clock::now();
+	double x = positionX(generator);
+	double y = positionY(generator);
+	int remaining = fixationSamples(generator);
+	while (generating)
+	{
+		// Saccade to next fixation
+		if (--remaining <= 0)
+		{
+			x = positionX(generator);
+			y = positionY(generator);
+			remaining = fixationSamples(generator);
+		}
+
+		// Push sample
+		{
+			using namespace std::chrono;
+			std::lock_guard<std::mutex> lock(sampleMutex);
+			spSampleQueue->push_back(SampleData(
+				x + noise(generator),
+				y + noise(generator),
+				SampleDataCoordinateSystem::SCREEN_PIXELS,
+				duration_cast<milliseconds>(system_clock::now().time_since_epoch())));
+			while (spSampleQueue->size() > 1000) { spSampleQueue->pop_front(); } // nobody fetches
+		}
+
+		next += interval;
+		std::this_thread::sleep_until(next);
+	}
+}
+
+EyetrackerInfo Connect(EyetrackerGeometry geometry)
+{
+	EyetrackerInfo info;
+	info.connected = true;
+	info.samplerate = EnvironmentValue("GTW_MOCK_SAMPLERATE", 120);
+	info.geometrySetupSuccessful = true;
+	connectionTime = std::chrono::steady_clock::now();
+	generating = true;
+	upGeneratorThread = std::unique_ptr<std::thread>(new std::thread(Generate, info.samplerate > 0 ? info.samplerate : 120));
+	return info;
+}
+
+bool IsTracking()
+{
+	return generating;
+}
+
+bool Disconnect()
+{
+	generating = false;
+	if (upGeneratorThread)
+	{
+		upGeneratorThread->join();
+		upGeneratorThread = nullptr;
+	}
+	return true;
+}
+
+void FetchSamples(SampleQueue& rspSamples)
+{
+	// Simulate hanging vendor library
+	const int stallAfter = EnvironmentValue("GTW_MOCK_STALL_AFTER", -1);
+	if (stallAfter >= 0 && std::chrono::steady_clock::now() - connectionTime > std::chrono::seconds(stallAfter))
+	{
+		while (true) { std::this_thread::sleep_for(std::chrono::seconds(1)); }
+	}
+
+	std::lock_guard<std::mutex> lock(sampleMutex);
+	rspSamples->insert(rspSamples->end(), spSampleQueue->begin(), spSampleQueue->end());
+	spSampleQueue->clear();
+}
+
+CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspInfo)
+{
+	// Simulate hanging vendor library
+	if (EnvironmentValue("GTW_MOCK_STALL_CALIBRATION", 0) == 1)
+	{
+		while (true) { std::this_thread::sleep_for(std::chrono::seconds(1)); }
+	}
+
+	rspInfo = std::make_shared<CalibrationInfo>();
+	rspInfo->push_back(CalibrationPoint(192, 108, CALIBRATION_POINT_OK));
+	rspInfo->push_back(CalibrationPoint(1728, 108, CALIBRATION_POINT_OK));
+	rspInfo->push_back(CalibrationPoint(960, 540, CALIBRATION_POINT_OK));
+	rspInfo->push_back(CalibrationPoint(192, 972, CALIBRATION_POINT_OK));
+	rspInfo->push_back(CalibrationPoint(1728, 972, CALIBRATION_POINT_BAD));
+	return CALIBRATION_OK;
+}
+
+void ContinueLabStream()
+{
+	// No lab streaming layer
+}
+
+void PauseLabStream()
+{
+	// No lab streaming layer
+}
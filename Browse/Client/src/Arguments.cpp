@@ -5,4 +5,7 @@
 
 #include "src/Arguments.h"
 
-Argument::Localization Argument::localization = Argument::Localization::English;
\ No newline at end of file
+Argument::Localization Argument::localization = Argument::Localization::English;
+std::string Argument::speechRecognitionURL = "";
+bool Argument::traceLatency = false;
+std::string Argument::simulationScenario = "";
\ No newline at end of file
@@ -3,7 +3,10 @@
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
 // Program arguments parsed at CefInitialization by MainCefApp and before
-// construction of Master.
+// construction of Master. When simulating, CEF is not initialized and main
+// lets MainCefApp parse the arguments directly.
+
+#include <string>
 
 class Argument
 {
@@ -14,4 +17,13 @@ public:
 		English, Greek, Hebrew
 	};
 	static Localization localization;
+
+	// Endpoint for speech recognition, empty if default should be used
+	static std::string speechRecognitionURL;
+
+	// Whether latency of frames is traced, dumped into user directory
+	static bool traceLatency;
+
+	// Scenario file of simulation, which runs without CEF. Empty if not simulating
+	static std::string simulationScenario;
 };
\ No newline at end of file
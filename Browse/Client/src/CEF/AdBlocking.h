@@ -0,0 +1,17 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Daniel Mueller (muellerd@uni-koblenz.de)
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Matching of requested URLs against list of ad servers. Does not depend on
+// CEF, so it is part of the core library.
+
+#ifndef ADBLOCKING_H_
+#define ADBLOCKING_H_
+
+#include <string>
+
+// Whether URL belongs to an ad server
+bool IsAdURL(std::string URL);
+
+#endif // ADBLOCKING_H_
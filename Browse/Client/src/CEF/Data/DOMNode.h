@@ -71,6 +71,9 @@ public:
 	bool IsFixed() const { return (_fixedId >= 0); }
 	bool IsOccluded() const { return _occluded; }
 
+	// Simulation sets attributes of synthetic nodes without IPC
+	friend class Simulation;
+
 private:
 
 	// Setter
@@ -152,6 +155,8 @@ public:
 	std::string GetHTMLId() const { return _htmlId; }
 	std::string GetHTMLClass() const { return _htmlClass; }
 
+	friend class Simulation; // sets attributes of synthetic nodes
+
 private:
 
 	typedef DOMNode super;
@@ -222,6 +227,8 @@ public:
 	std::string GetText() const { return _text; }
 	std::string GetUrl() const { return _url; }
 
+	friend class Simulation; // sets attributes of synthetic nodes
+
 private:
 
 	typedef DOMNode super;
@@ -286,6 +293,8 @@ public:
 	// Custom getter
 	std::vector<std::string> GetOptions() const { return _options; }
 
+	friend class Simulation; // sets attributes of synthetic nodes
+
 private:
 
 	typedef DOMNode super;
@@ -348,6 +357,8 @@ public:
 	std::pair<int, int> GetMaxScrolling() const { return std::make_pair(_scrollLeftMax, _scrollTopMax); }
 	std::pair<int, int> GetCurrentScrolling() const { return std::make_pair(_scrollLeft, _scrollTop); }
 
+	friend class Simulation; // sets attributes of synthetic nodes
+
 private:
 
 	typedef DOMNode super;
@@ -464,6 +475,8 @@ public:
 
 	std::vector<DOMAttribute> GetAttributes() { return _description; }
 
+	friend class Simulation; // sets attributes of synthetic nodes
+
 private:
 	typedef DOMNode super;
 
@@ -163,6 +163,9 @@ public:
 	// TODO taking gaze, should take scrolling offset
 	// Send IPC message to JS in order to execute scrolling function
 	void Scroll(int x, int y, std::vector<int> fixedIds = {}) { SendExecuteFunctionMessage("scroll", x, y, fixedIds); }
+
+	// Send IPC message to JS in order to scroll by given pixels
+	void ScrollBy(int deltaX, int deltaY) { SendExecuteFunctionMessage("scrollBy", deltaX, deltaY); }
 };
 
 // Interaction with select field
@@ -119,7 +119,7 @@ void Handler::OnLoadStart(CefRefPtr<CefBrowser> browser, CefRefPtr<CefFrame> fra
 
     if (frame->IsMain())
     {
-		_pMediator->ResetFavicon(browser);
+		_pMediator->ResetFavicon(browser, frame->GetURL().ToString());
 		//LogDebug("Handler: Started loading frame id = ", frame->GetIdentifier(), " (main = ", frame->IsMain(), "), browserID = ", browser->GetIdentifier());
 
         // Set zoom level according to Tab's settings
@@ -391,31 +391,23 @@ bool Handler::OnBeforeUnloadDialog(
 	return true;
 }
 
-void Handler::ResizeBrowsers()
+void Handler::ResizeBrowser(CefRefPtr<CefBrowser> browser)
 {
     CEF_REQUIRE_UI_THREAD();
 
-    BrowserList::iterator bit = _browserList.begin();
-    for (; bit != _browserList.end(); ++bit)
-    {
-        LogDebug("Handler: Browser (id = ", bit->get()->GetIdentifier(), " was resized.");
-
-        bit->get()->GetHost()->WasResized();
+    LogDebug("Handler: Browser (id = ", browser->GetIdentifier(), ") was resized.");
 
-        // Resize may cause change in page size
-        UpdatePageResolution(bit->get());
+    browser->GetHost()->NotifyScreenInfoChanged(); // render scale may have changed
+    browser->GetHost()->WasResized();
 
-		// TODO / NOTE: 
-		// It might be better to perform that Rect Update not simultaneously on every browser.
-		// Instead save it and execute it when you switch to the target tab
+    // Resize may cause change in page size
+    UpdatePageResolution(browser);
 
-		bit->get()->GetMainFrame()->ExecuteJavaScript("console.log('Browser resized, updating DOM Rects!');" \
-			"UpdateDOMRects();", "", 0);
+	browser->GetMainFrame()->ExecuteJavaScript("console.log('Browser resized, updating DOM Rects!');" \
+		"UpdateDOMRects();", "", 0);
 
-        // EXPERIMENTAL
-        //GetFixedElements(bit->get());
-
-    }
+    // EXPERIMENTAL
+    //GetFixedElements(browser);
 }
 
 void Handler::LoadPage(CefRefPtr<CefBrowser> browser, std::string url)
@@ -487,6 +479,39 @@ void Handler::ResetMainFramesScrolling(CefRefPtr<CefBrowser> browser)
     browser->GetMainFrame()->ExecuteJavaScript(resetScrolling, browser->GetMainFrame()->GetURL(), 0);
 }
 
+void Handler::ScrollMainFrame(CefRefPtr<CefBrowser> browser, double x, double y)
+{
+    const std::string scrolling = "window.scrollTo(" + std::to_string(x) + ", " + std::to_string(y) + ");";
+    browser->GetMainFrame()->ExecuteJavaScript(scrolling, browser->GetMainFrame()->GetURL(), 0);
+}
+
+void Handler::WarmLink(CefRefPtr<CefBrowser> browser, std::string URL, bool prefetch)
+{
+    // Escape URL for string literal in JavaScript
+    std::string literal;
+    for (char c : URL)
+    {
+        if (c == '\\' || c == '\'') { literal += '\\'; }
+        if (c == '\n' || c == '\r') { continue; }
+        literal += c;
+    }
+
+    // Preconnect opens DNS, TCP and TLS to origin, prefetch fetches target with lowest priority into cache
+    const std::string rels = prefetch ? "['prefetch']" : "['dns-prefetch', 'preconnect']";
+    const std::string warming =
+        "(function() { var parent = document.head || document.documentElement; if (!parent) { return; }"
+        + rels + ".forEach(function(rel) { var link = document.createElement('link'); link.rel = rel; link.href = '" + literal + "';"
+        "if (rel === 'prefetch') { link.as = 'document'; } link.setAttribute('data-gtw-warming', ''); parent.appendChild(link); }); })();";
+    browser->GetMainFrame()->ExecuteJavaScript(warming, browser->GetMainFrame()->GetURL(), 0);
+}
+
+void Handler::CancelLinkWarming(CefRefPtr<CefBrowser> browser)
+{
+    // Removal of prefetch hint aborts its request when still running
+    const std::string cancel = "Array.prototype.forEach.call(document.querySelectorAll('link[data-gtw-warming]'), function(link) { link.parentNode.removeChild(link); });";
+    browser->GetMainFrame()->ExecuteJavaScript(cancel, browser->GetMainFrame()->GetURL(), 0);
+}
+
 void Handler::SetZoomLevel(CefRefPtr<CefBrowser> browser, bool definitelyChanged)
 {
 
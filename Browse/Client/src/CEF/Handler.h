@@ -116,8 +116,8 @@ public:
 	// Reply JavaScript dialog callback
 	void ReplyJSDialog(CefRefPtr<CefBrowser> browser, bool clicked_ok, std::string user_input);
 
-    // Called by CefMediator, when window resize happens
-    void ResizeBrowsers();
+    // Called by CefMediator for each browser that has to adapt to resized window
+    void ResizeBrowser(CefRefPtr<CefBrowser> browser);
 
     // Emulation of mouse buttons in specific browser
     void EmulateMouseCursor(CefRefPtr<CefBrowser> browser, double x, double y, bool leftButtonPressed);
@@ -126,6 +126,11 @@ public:
 
     
     void ResetMainFramesScrolling(CefRefPtr<CefBrowser> browser);
+    void ScrollMainFrame(CefRefPtr<CefBrowser> browser, double x, double y);
+
+    // Hint links into main frame, so connection or target is ready before navigation. Cancel removes all hints
+    void WarmLink(CefRefPtr<CefBrowser> browser, std::string URL, bool prefetch);
+    void CancelLinkWarming(CefRefPtr<CefBrowser> browser);
 
     // Bool value indicates need to reload DOM node data, true when called from outside of Tab due to changes
     void SetZoomLevel(CefRefPtr<CefBrowser> browser, bool definitelyChanged = true);
@@ -15,14 +15,6 @@ const std::string src = CONTENT_PATH "/javascript/";
 // List of all available JS code file paths and how to access them with JSCode enum
 const std::map<JSFile, std::string> findJSFile =
 {
-	// MutationObserver & DOMNodes
-    std::make_pair<JSFile, std::string>(HELPERS, src + "helpers.js"),
-    std::make_pair<JSFile, std::string>(DOM_NODES, src + "dom_nodes.js"),
-    std::make_pair<JSFile, std::string>(DOM_NODES_INTERACTION, src + "dom_nodes_interaction.js"),
-	std::make_pair<JSFile, std::string>(DOM_MUTATIONOBSERVER, src + "dom_mutationobserver.js"),
-	std::make_pair<JSFile, std::string>(DOM_FIXED_ELEMENTS, src + "dom_fixed_elements.js"),
-	std::make_pair<JSFile, std::string>(DOM_ATTRIBUTES, src + "dom_attributes.js"),
-	std::make_pair<JSFile, std::string>(DOM_NODES_HELPERS, src + "dom_nodes_helpers.js"),
 	// Various
 	std::make_pair<JSFile, std::string>(REMOVE_CSS_SCROLLBAR, src + "old/remove_css_scrollbar.js")
 };
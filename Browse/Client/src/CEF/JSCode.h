@@ -23,17 +23,10 @@
 *
 */
 
+// Scripts for DOM node extraction are bundled at build time, see src/CEF/RenderProcess/DOMScript.h
 enum JSFile
 {
-    REMOVE_CSS_SCROLLBAR,
-	// MutationObserver & DOMNodes
-	DOM_MUTATIONOBSERVER,
-	DOM_NODES,
-	DOM_NODES_INTERACTION,
-	DOM_FIXED_ELEMENTS,
-	HELPERS,
-	DOM_ATTRIBUTES,
-	DOM_NODES_HELPERS
+    REMOVE_CSS_SCROLLBAR
 };
 
 std::string GetJSCode(JSFile file);
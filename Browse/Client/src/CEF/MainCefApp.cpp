@@ -34,6 +34,18 @@ void MainCefApp::OnBeforeCommandLineProcessing(const CefString& process_type, Ce
 		else if (rString.compare("--localization=hebrew") == 0)
 		{
 			Argument::localization = Argument::Localization::Hebrew;
+		}
+		else if (rString.ToString().find("--speech-url=") == 0)
+		{
+			Argument::speechRecognitionURL = rString.ToString().substr(std::string("--speech-url=").length());
+		}
+		else if (rString.compare("--trace-latency") == 0)
+		{
+			Argument::traceLatency = true;
+		}
+		else if (rString.ToString().find("--simulate=") == 0)
+		{
+			Argument::simulationScenario = rString.ToString().substr(std::string("--simulate=").length());
 		} // no else!
 	}
 
@@ -13,8 +13,10 @@
 #include "src/CEF/Data/DOMNode.h"
 #include "src/Utils/Logger.h"
 #include "src/Global.h"
+#include "src/Master/Simulation.h"
 #include "include/cef_app.h"
 #include "include/wrapper/cef_helpers.h"
+#include <cmath>
 
 
 void Mediator::SetMaster(MasterNotificationInterface* pMaster)
@@ -22,8 +24,20 @@ void Mediator::SetMaster(MasterNotificationInterface* pMaster)
 	_pMaster = pMaster;
 }
 
+void Mediator::SetSimulation(Simulation* pSimulation)
+{
+	_pSimulation = pSimulation;
+}
+
 void Mediator::RegisterTab(TabCEFInterface* pTab, std::string URL)
 {
+	// Simulation feeds synthetic page instead of a browser
+	if (_pSimulation)
+	{
+		_pSimulation->RegisterTab(pTab, URL.empty() ? BLANK_PAGE_URL : URL);
+		return;
+	}
+
     CEF_REQUIRE_UI_THREAD();
 
     /*Following information might be changed and used in the future
@@ -66,6 +80,7 @@ void Mediator::RegisterTab(TabCEFInterface* pTab, std::string URL)
 
 void Mediator::UnregisterTab(TabCEFInterface* pTab)
 {
+	if (_pSimulation) { _pSimulation->UnregisterTab(pTab); }
     if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
     {
         // Close corresponding CefBrowser in Handler
@@ -76,11 +91,14 @@ void Mediator::UnregisterTab(TabCEFInterface* pTab)
         LogDebug("Mediator: Unregistering Tab corresponding to browserID = ", browserID);
         _tabs.erase(browserID);
         _browsers.erase(pTab);
+		_staleTabs.erase(pTab);
+		_pendingResizes.erase(browserID);
     }
 }
 
 void Mediator::LoadURLInTab(TabCEFInterface * pTab, std::string URL)
 {
+	if (_pSimulation) { _pSimulation->LoadURL(pTab, URL); }
     if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
     {
         // Get Tab object and load Tab's URL in CefBrowser
@@ -90,6 +108,7 @@ void Mediator::LoadURLInTab(TabCEFInterface * pTab, std::string URL)
 
 void Mediator::ReloadTab(TabCEFInterface * pTab)
 {
+	if (_pSimulation) { _pSimulation->ReloadTab(pTab); }
     if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
     {
         _handler->Reload(browser);
@@ -130,6 +149,8 @@ void Mediator::ReplyJSDialog(TabCEFInterface* pTab, bool clicked_ok, std::string
 
 void Mediator::DoMessageLoopWork()
 {
+	// CEF is not initialized while simulating
+	if (_pSimulation) { return; }
     CefDoMessageLoopWork();
 }
 
@@ -154,17 +175,18 @@ void Mediator::EmulateLeftMouseButtonClick(TabCEFInterface * pTab, double x, dou
 
 void Mediator::EmulateMouseWheelScrolling(TabCEFInterface * pTab, double deltaX, double deltaY)
 {
+	if (_pSimulation) { _pSimulation->Scroll(pTab, deltaX, deltaY); }
     if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
     {
         _handler->EmulateMouseWheelScrolling(browser, deltaX, deltaY);
     }
 }
 
-void Mediator::ResetFavicon(CefRefPtr<CefBrowser> browser)
+void Mediator::ResetFavicon(CefRefPtr<CefBrowser> browser, std::string URL)
 {
     if (TabCEFInterface* pTab = GetTab(browser))
     {
-        pTab->ResetFaviconBytes();
+        pTab->ResetFaviconBytes(URL);
     }
 }
 
@@ -300,6 +322,7 @@ void Mediator::SetActiveTab(TabCEFInterface * pTab)
 {
 	// Remember currently active Tab
 	_activeTab = pTab;
+	if (_pSimulation) { _pSimulation->SetActiveTab(pTab); }
 
 	for (const auto& key : _browsers)
 	{
@@ -308,6 +331,9 @@ void Mediator::SetActiveTab(TabCEFInterface * pTab)
 		{
 			// Activate the given Tab's rendering
 			browser->GetHost()->WasHidden(false);
+
+			// Catch up on window resizing which happened while Tab was in background
+			RefreshTab(pTab);
 		}
 		else
 		{
@@ -374,12 +400,48 @@ void Mediator::RemoveDOMVideo(CefRefPtr<CefBrowser> browser, int id)
 
 void Mediator::ResetScrolling(TabCEFInterface * pTab)
 {
+	if (_pSimulation) { _pSimulation->ResetScrolling(pTab); }
     if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
     {
         _handler->ResetMainFramesScrolling(browser);
     }
 }
 
+void Mediator::ScrollTo(TabCEFInterface* pTab, double x, double y)
+{
+	if (_pSimulation) { _pSimulation->ScrollTo(pTab, x, y); }
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		_handler->ScrollMainFrame(browser, x, y);
+	}
+}
+
+void Mediator::PreconnectLink(TabCEFInterface* pTab, std::string origin)
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		LogDebug("Mediator: Preconnecting to ", origin, ".");
+		_handler->WarmLink(browser, origin, false);
+	}
+}
+
+void Mediator::PrefetchLink(TabCEFInterface* pTab, std::string URL)
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		LogDebug("Mediator: Prefetching ", URL, ".");
+		_handler->WarmLink(browser, URL, true);
+	}
+}
+
+void Mediator::CancelLinkWarming(TabCEFInterface* pTab)
+{
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		_handler->CancelLinkWarming(browser);
+	}
+}
+
 void Mediator::SetURL(CefRefPtr<CefBrowser> browser)
 {
     if (TabCEFInterface* pTab = GetTab(browser))
@@ -755,7 +817,93 @@ void Mediator::GetResolution(CefRefPtr<CefBrowser> browser, int& width, int& hei
     }
 }
 
+float Mediator::GetScale(CefRefPtr<CefBrowser> browser) const
+{
+	if (TabCEFInterface* pTab = GetTab(browser))
+	{
+		return pTab->GetWebRenderScale();
+	}
+	else if (_pendingTab)
+	{
+		return _pendingTab->GetWebRenderScale();
+	}
+	return 1.f;
+}
+
+void Mediator::NotifyPaint(CefRefPtr<CefBrowser> browser, int width, int height, double paintDuration, double uploadDuration)
+{
+	_painted = true;
+
+	// Report costs of paint to Tab. Other work of message loop, like IPC and DOM updates, is not caused by painting
+	if (TabCEFInterface* pTab = GetTab(browser))
+	{
+		pTab->ReportPaint(width, height, paintDuration, uploadDuration);
+	}
+
+	auto iter = _pendingResizes.find(browser->GetIdentifier());
+	if (iter != _pendingResizes.end())
+	{
+		// Paints in old resolution might still arrive after resize request. CEF rounds scaled size
+		int expectedWidth = 0, expectedHeight = 0;
+		GetResolution(browser, expectedWidth, expectedHeight);
+		const float scale = GetScale(browser);
+		if (std::abs(width - expectedWidth * scale) <= 1.f && std::abs(height - expectedHeight * scale) <= 1.f)
+		{
+			const double latency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - iter->second).count();
+			LogDebug("Mediator: Browser (id = ", browser->GetIdentifier(), ") painted ", width, "x", height, " after ", latency, "ms of resizing.");
+			_pendingResizes.erase(iter);
+		}
+	}
+}
+
+bool Mediator::ConsumePaint()
+{
+	bool painted = _painted;
+	_painted = false;
+	return painted;
+}
+
 void Mediator::ResizeTabs()
 {
-    _handler->ResizeBrowsers();
+	for (const auto& key : _browsers)
+	{
+		if (key.first == _activeTab)
+		{
+			ResizeTab(key.first, key.second);
+		}
+		else
+		{
+			// Hidden browsers do not paint anyway, so resize them when they are needed again
+			_staleTabs.insert(key.first);
+		}
+	}
+}
+
+void Mediator::RefreshTab(TabCEFInterface* pTab)
+{
+	if (_staleTabs.find(pTab) != _staleTabs.end())
+	{
+		if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+		{
+			ResizeTab(pTab, browser);
+		}
+	}
+}
+
+void Mediator::RescaleTab(TabCEFInterface* pTab)
+{
+	// Simulation paints in current scale anyway
+	if (CefRefPtr<CefBrowser> browser = GetBrowser(pTab))
+	{
+		ResizeTab(pTab, browser);
+	}
+}
+
+void Mediator::ResizeTab(TabCEFInterface* pTab, CefRefPtr<CefBrowser> browser)
+{
+	_staleTabs.erase(pTab);
+
+	// Keep earliest request when resizing continues before browser has painted
+	_pendingResizes.emplace(browser->GetIdentifier(), std::chrono::steady_clock::now());
+	_handler->ResizeBrowser(browser);
 }
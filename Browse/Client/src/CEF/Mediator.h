@@ -17,6 +17,7 @@
 #include <memory>
 #include <queue>
 #include <functional>
+#include <chrono>
 
 /**
 *	Expand CefApp by methods and attributes used to communicate with Master and
@@ -34,6 +35,7 @@ class DOMLink;
 class DOMSelectField;
 class DOMVideo;
 class DOMCheckbox;
+class Simulation;
 
 typedef int BrowserID;
 
@@ -44,6 +46,9 @@ public:
 	// Setter for master pointer (MUST be called before usage)
 	void SetMaster(MasterNotificationInterface* pMaster);
 
+	// Setter for simulation, which replaces browsers of Tabs. Must be set before first Tab is registered
+	void SetSimulation(Simulation* pSimulation);
+
     // Receive tab specific commands
     void RegisterTab(TabCEFInterface* pTab, std::string URL);
     void UnregisterTab(TabCEFInterface* pClosing);
@@ -65,9 +70,25 @@ public:
     // Get resolution of rendering
     void GetResolution(CefRefPtr<CefBrowser> browser, int& width, int& height) const;
 
-    // Called by Master when window resize happens
+	// Get scale of rendering, which is applied as device scale factor on top of resolution
+	float GetScale(CefRefPtr<CefBrowser> browser) const;
+
+	// Renderer::OnPaint calls this method to measure how long resizing took until the first frame in new size
+	// and to report costs of painting. Paint duration covers copy and upload in OnPaint, durations in milliseconds
+	void NotifyPaint(CefRefPtr<CefBrowser> browser, int width, int height, double paintDuration, double uploadDuration);
+
+	// Returns whether any browser painted since last call
+	bool ConsumePaint();
+
+    // Called by Master when window resize happens. Only active Tab is resized, others are marked as stale
     void ResizeTabs();
 
+	// Resize Tab if it became stale while in background, e.g. before its preview is displayed
+	void RefreshTab(TabCEFInterface* pTab);
+
+	// Called by Tab when scale of rendering changed
+	void RescaleTab(TabCEFInterface* pTab);
+
     // Call from Master to do message loop work
     void DoMessageLoopWork();
 
@@ -78,6 +99,12 @@ public:
     void EmulateMouseWheelScrolling(TabCEFInterface* pTab, double deltaX, double deltaY);
 
     void ResetScrolling(TabCEFInterface* pTab);
+    void ScrollTo(TabCEFInterface* pTab, double x, double y); // CEFPixel offset of main frame
+
+	// Warm up link before navigation, preconnect takes origin and prefetch URL of target
+	void PreconnectLink(TabCEFInterface* pTab, std::string origin);
+	void PrefetchLink(TabCEFInterface* pTab, std::string URL);
+	void CancelLinkWarming(TabCEFInterface* pTab);
 
     // Sets Tab's URL attribute, called by Handler when main frame starts loading a page
     void SetURL(CefRefPtr<CefBrowser> browser);
@@ -92,7 +119,7 @@ public:
 
 
 	// ### FAVICON SETTING ###
-	void ResetFavicon(CefRefPtr<CefBrowser> browser);
+	void ResetFavicon(CefRefPtr<CefBrowser> browser, std::string URL);
 
 	// Get byte code from CefImage and send it to corresponding Tab
 	bool ForwardFaviconBytes(CefRefPtr<CefBrowser> browser, CefRefPtr<CefImage> img);
@@ -200,6 +227,18 @@ protected:
 
 	TabCEFInterface* _activeTab = NULL;
 
+	// Tabs which missed resizing of window while in background
+	std::set<TabCEFInterface*> _staleTabs;
+
+	// Time of resize request per browser until it paints in new resolution
+	std::map<BrowserID, std::chrono::steady_clock::time_point> _pendingResizes;
+
+	// Whether any browser painted since last consumption
+	bool _painted = false;
+
+	// Resize browser of Tab and start measurement of its latency
+	void ResizeTab(TabCEFInterface* pTab, CefRefPtr<CefBrowser> browser);
+
     TabCEFInterface* _pendingTab = NULL; // Used in Tab registration progress (at first, Renderer works to fast for map access)
 
 	// Simple internal clipboard
@@ -211,6 +250,9 @@ protected:
 
 	// Pointer to master (but only functions exposed through the interface)
 	MasterNotificationInterface* _pMaster = NULL;
+
+	// Pointer to simulation, only set when simulating without CEF
+	Simulation* _pSimulation = NULL;
 };
 
 
@@ -0,0 +1,34 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "DOMScript.h"
+#include "src/CEF/Data/DOMAttribute.h"
+
+// Bundled scripts as bytes, terminated by zero. Generated by cmake/BundleJavaScript.cmake
+const unsigned char domScriptBundle[] =
+{
+#include "DOMScriptBundle.inc"
+};
+
+std::string GetDOMScript()
+{
+	// Measure time V8 spends executing the extension in a new context
+	std::string code = "var _domScriptImportStart = window.performance.now();\n";
+
+	// Bundled scripts, without terminating zero
+	code.append(reinterpret_cast<const char*>(domScriptBundle), sizeof(domScriptBundle) - 1);
+
+	// Table of DOM attributes
+	int attrId = 0;
+	std::string attrStr = DOMAttrToString((DOMAttribute)attrId);
+	while (attrStr.size() >= 3) // there won't exist any attribute name with less than 3 characters
+	{
+		code += "AddDOMAttribute('" + attrStr + "', " + std::to_string(attrId) + ");\n";
+		attrStr = DOMAttrToString((DOMAttribute)(++attrId));
+	}
+
+	code += "window._domScriptImportTime = window.performance.now() - _domScriptImportStart;\n";
+	return code;
+}
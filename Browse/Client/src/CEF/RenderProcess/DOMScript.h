@@ -0,0 +1,24 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// JavaScript code extending pages by DOM node extraction and interaction.
+// Scripts from content/javascript are bundled at build time and completed
+// by the table of DOM attributes, so render process registers the code once
+// as V8 extension instead of injecting it into every page.
+
+#ifndef CEF_DOMSCRIPT_H_
+#define CEF_DOMSCRIPT_H_
+
+#include <string>
+
+// Name of extension in V8
+static const std::string DOM_SCRIPT_EXTENSION_NAME = "v8/gazetheweb";
+
+// Name of JavaScript function to call once per page in main frame. Returns setup time in milliseconds
+static const std::string DOM_SCRIPT_INIT_FUNCTION = "DOMInit";
+
+// Get complete code of extension
+std::string GetDOMScript();
+
+#endif // CEF_DOMSCRIPT_H_
@@ -5,9 +5,11 @@
 //============================================================================
 
 #include "RenderProcessHandler.h"
+#include "src/CEF/RenderProcess/DOMScript.h"
 #include "include/base/cef_logging.h"
 #include "include/wrapper/cef_helpers.h"
 #include <sstream>
+#include <chrono>
 
 #include "src/CEF/Data/DOMExtraction.h"
 #include "src/CEF/Data/DOMNode.h"		// TODO: Move descriptions to DOMExtraction to not need to include this header?
@@ -325,6 +327,12 @@ bool RenderProcessHandler::OnProcessMessageReceived(
     return _msgRouter->OnProcessMessageReceived(browser, sourceProcess, msg);
 }
 
+void RenderProcessHandler::OnWebKitInitialized()
+{
+	// Register JavaScript once, V8 compiles it once and executes it in every new context
+	CefRegisterExtension(DOM_SCRIPT_EXTENSION_NAME, GetDOMScript(), NULL);
+}
+
 void RenderProcessHandler::OnFocusedNodeChanged(
     CefRefPtr<CefBrowser> browser,
     CefRefPtr<CefFrame> frame,
@@ -342,68 +350,29 @@ void RenderProcessHandler::OnContextCreated(
 
     if (frame->IsMain())
     {
-		frame->ExecuteJavaScript("window.starting_time_ = window.performance.now();", "", 0);
-
 		// Clear previous DOM nodes in current Tab
 		CefRefPtr<CefProcessMessage> msg = CefProcessMessage::Create("OnContextCreated");
 		browser->SendProcessMessage(PID_BROWSER, msg);
 
-
-    // Create variables in Javascript which are to be read after page finished loading.
-    // Variables here contain the amount of needed objects in order to allocate arrays, which are just big enough
+		// Code has been executed by V8 extension already, just initialize page
         if (context->Enter())
         {
-            // Retrieve the context's window object.
-			CefRefPtr<CefV8Value> globalObj = context->GetGlobal();
-
-			// TODO (Daniel): Are those still neccessary? There might be a better way!
-            // Add attributes with their pre-set values to JS object |window|
-            globalObj->SetValue("_pageWidth", CefV8Value::CreateDouble(-1), V8_PROPERTY_ATTRIBUTE_NONE);
-            globalObj->SetValue("_pageHeight", CefV8Value::CreateDouble(-1), V8_PROPERTY_ATTRIBUTE_NONE);
-
-            // Create JS variables for width and height of favicon image
-            globalObj->SetValue("favIconHeight", CefV8Value::CreateInt(-1), V8_PROPERTY_ATTRIBUTE_NONE);
-            globalObj->SetValue("favIconWidth", CefV8Value::CreateInt(-1), V8_PROPERTY_ATTRIBUTE_NONE);
-
-			// Inject Javascript code which extends the current page's context by our methods
-			// and automatically creates a MutationObserver instance
-			for (const auto& dom_code : _js_dom_code)
+			const auto start = std::chrono::steady_clock::now();
+			CefRefPtr<CefV8Value> initFunc = context->GetGlobal()->GetValue(DOM_SCRIPT_INIT_FUNCTION);
+			if (initFunc->IsFunction())
 			{
-				frame->ExecuteJavaScript(dom_code.first, dom_code.second, 0);
-			}
-
-
-			const auto& add_attribute = context->GetGlobal()->GetValue("AddDOMAttribute");
-			if (add_attribute->IsFunction())
-			{
-				bool valid = true;
-				int attrId = 0;
-				while (valid)
-				{
-					const std::string& attrStr = DOMAttrToString((DOMAttribute) attrId);
-					valid = (attrStr.size() >= 3);	// There won't exist any attribute name with less than 4 characters
-					if (valid)
-						add_attribute->ExecuteFunction(
-							context->GetGlobal(),
-							{ CefV8Value::CreateString(attrStr), CefV8Value::CreateInt(attrId) }
-					);
-					attrId++;
-				}
+				// Script setup time covers execution of extension in this context and initialization
+				CefRefPtr<CefV8Value> setupTime = initFunc->ExecuteFunction(context->GetGlobal(), {});
+				const double duration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+				IPCLogDebug(browser, "Renderer: DOM script setup took "
+					+ std::to_string((setupTime && setupTime->IsDouble()) ? setupTime->GetDoubleValue() : -1.0)
+					+ "ms, initialization call " + std::to_string(duration) + "ms.");
 			}
 			else
 			{
-				IPCLog(browser, "Renderer: ERROR: Could not find JS function 'AddDOMAttribute'!");
+				IPCLog(browser, "Renderer: ERROR: Could not find JS function '" + DOM_SCRIPT_INIT_FUNCTION + "'!");
 			}
 
-			frame->ExecuteJavaScript("MutationObserverInit();", "", 0);
-
-
-			//IPCLog(browser, "LOADING FIXED ELEMENT JS FILE OVER AND OVER AGAIN");
-			//_js_dom_fixed_elements = GetJSCode(DOM_FIXED_ELEMENTS);
-			//frame->ExecuteJavaScript(_js_dom_fixed_elements, "", 0);
-
-
-
             context->Exit();
         }
         /*
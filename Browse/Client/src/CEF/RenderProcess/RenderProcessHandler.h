@@ -10,7 +10,6 @@
 #ifndef CEF_RENDERPROCESSHANDLER_H_
 #define CEF_RENDERPROCESSHANDLER_H_
 
-#include "src/CEF/JSCode.h"
 #include "include/wrapper/cef_message_router.h"
 #include "include/cef_render_process_handler.h"
 
@@ -26,6 +25,9 @@ public:
         CefProcessId sourceProcess,
         CefRefPtr<CefProcessMessage> msg) OVERRIDE;
 
+    // Callback, called once per render process after WebKit has been initialized
+    void OnWebKitInitialized() OVERRIDE;
+
     // Callback, called when DOM node under cursor changes
     virtual void OnFocusedNodeChanged(
         CefRefPtr<CefBrowser> browser,
@@ -55,26 +57,6 @@ private:
     // Message router instance
 	CefRefPtr<CefMessageRouterRendererSide> _msgRouter;
 
-    // JavaScript code as Strings
-	const std::string _js_dom_nodes				= GetJSCode(DOM_NODES);
-	const std::string _js_dom_nodes_interaction	= GetJSCode(DOM_NODES_INTERACTION);
-	const std::string _js_dom_mutationobserver	= GetJSCode(DOM_MUTATIONOBSERVER);
-	const std::string _js_dom_fixed_elements	= GetJSCode(DOM_FIXED_ELEMENTS);
-	const std::string _js_helpers				= GetJSCode(HELPERS);
-	const std::string _js_dom_attributes		= GetJSCode(DOM_ATTRIBUTES);
-	const std::string _js_dom_nodes_helpers		= GetJSCode(DOM_NODES_HELPERS);
-
-	std::vector<std::pair<std::string, std::string>> _js_dom_code = {
-		std::make_pair(_js_helpers, "helpers.js"),
-		std::make_pair(_js_dom_nodes, "dom_nodes.js"),
-		std::make_pair(_js_dom_nodes_helpers, "dom_nodes_helper.js"),
-		std::make_pair(_js_dom_nodes_interaction, "dom_nodes_interaction.js"),
-		std::make_pair(_js_dom_fixed_elements, "dom_fixed_elements.js"),
-		std::make_pair(_js_dom_mutationobserver, "dom_mutationobserver.js"),
-		std::make_pair(_js_dom_attributes, "dom_attributes.js")
-
-	};
-
     // Include CEF'S default reference counting implementation
     IMPLEMENT_REFCOUNTING(RenderProcessHandler);
 };
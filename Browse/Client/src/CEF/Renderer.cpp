@@ -9,6 +9,7 @@
 #include "src/Utils/Texture.h"
 #include "src/Utils/Logger.h"
 #include "include/wrapper/cef_helpers.h"
+#include <chrono>
 
 Renderer::Renderer(Mediator* pMediator)
 {
@@ -27,6 +28,17 @@ bool Renderer::GetViewRect(CefRefPtr<CefBrowser> browser, CefRect &rect)
     return true;
 }
 
+bool Renderer::GetScreenInfo(CefRefPtr<CefBrowser> browser, CefScreenInfo& screen_info)
+{
+    // Layout stays in size of view rect, texture is painted in scaled size
+    CefRect rect;
+    GetViewRect(browser, rect);
+    screen_info.device_scale_factor = _mediator->GetScale(browser);
+    screen_info.rect = rect;
+    screen_info.available_rect = rect;
+    return true;
+}
+
 void Renderer::OnPaint(
     CefRefPtr<CefBrowser> browser,
     PaintElementType type,
@@ -35,11 +47,17 @@ void Renderer::OnPaint(
     int width,
     int height)
 {
+    // Only work in here is caused by painting on this thread, rasterization happens in other processes
+    const auto start = std::chrono::steady_clock::now();
+
     // Look up corresponding texture
+    double uploadDuration = 0;
     if (auto spTexture = _mediator->GetTexture(browser).lock())
     {
         // Fill texture with rendered website
+        const auto upload = std::chrono::steady_clock::now();
         spTexture->Fill(width, height, GL_BGRA, (const unsigned char*) buffer);
+        uploadDuration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - upload).count();
 
 
 		// TESTING
@@ -58,6 +76,10 @@ void Renderer::OnPaint(
     {
         LogDebug("Renderer: OnPaint couldn't fill texture...");
     }
+
+    // Report paint for resize latency measurement and control of render scale
+    const double paintDuration = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    _mediator->NotifyPaint(browser, width, height, paintDuration, uploadDuration);
 }
 
 void Renderer::OnScrollOffsetChanged(CefRefPtr<CefBrowser> browser, double x, double y)
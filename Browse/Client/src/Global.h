@@ -21,6 +21,8 @@ static const std::string BLANK_PAGE_URL = "about:blank";
 static const int SLOTS_PER_TAB_OVERVIEW_PAGE = 5;
 static const int WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL = 3;
 static const int WEB_TAB_OVERVIEW_PREVIEW_MIP_MAP_LEVEL = 0;
+static const float WEB_TAB_DISCARD_CHECK_INTERVAL = 10.f; // seconds
+static const unsigned int LINK_WARMING_MAX_COUNT = 64; // recent warmings kept for measurement of hits
 static const glm::vec4 TAB_DEFAULT_COLOR_ACCENT = glm::vec4(96.f / 255.f, 125.f / 255.f, 139.f / 255.f, 1.f);
 static const int TAB_ACCENT_COLOR_SAMPLING_POINTS = 100;
 static const float TAB_SCROLLING_SENSOR_WIDTH = 0.2f;
@@ -31,15 +33,36 @@ static const float TAB_TRIGGER_BADGE_SIZE = 0.035f;
 static const glm::vec2 TAB_TRIGGER_BADGE_OFFSET = glm::vec2(0.05f, 0.05f);
 static const float TAB_LOADING_ICON_FRAME_DURATION = 0.25f;
 static const float TAB_GET_PAGE_RES_INTERVAL = 1.0f;
+static const float SCROLL_PREDICTION_RECONCILIATION_DELAY = 0.3f; // seconds after last wheel delta until prediction falls back to offset reported by CEF
+static const float SCROLL_PREDICTION_RECONCILIATION_SPEED = 10.f; // fraction of remaining difference per second
+static const double SCROLL_CONTROLLER_MAX_INTEGRATION_STEP = 0.1; // seconds
+static const float TAB_SCROLLING_EVENT_RATE = 30.f; // maximum scroll events per second sent to page or overflow element
+static const float TAB_AUTO_SCROLLING_SPEED = 1200.f; // pixels per second at full auto scrolling value
+static const float TAB_SCROLLING_SENSOR_SPEED = 1000.f; // pixels per second at full penetration of scrolling sensor
+static const float TAB_OVERFLOW_SCROLLING_SPEED = 600.f; // pixels per second when gazing at border of overflow element
+static const float TAB_OVERFLOW_SCROLLING_BORDER = 0.2f; // relative size of border of overflow element in which is scrolled
 static const int TAB_DEBUGGING_GAZE_COUNT = 10;
 static const float MASTER_PAUSE_ALPHA = 0.35f;
+static const float FRAME_SCHEDULER_STATISTICS_INTERVAL = 60.f; // seconds between logging of composed and idle frames
 static const float EYEINPUT_MOUSE_OVERRIDE_INIT_FRAME_DURATION = 0.25f; // duration between mouse movement is expected. Triggered by initial movement
 static const float EYEINPUT_MOUSE_OVERRIDE_INIT_DISTANCE = 100.f; // pixels on screen (not best but works)
 static const float EYEINPUT_MOUSE_OVERRIDE_STOP_DURATION = 1.5f; // duration until override is stopped when no mouse movement done
+static const float EYEINPUT_DISPLAY_LATENCY_SMOOTHING = 0.05f; // weight of latest frame in measured latency from sample to display
+static const std::string TRACKER_HOST_EXECUTABLE_NAME = "TrackerHost";
+static const std::string TRACKER_HOST_SHARED_MEMORY_NAME = "GazeTheWebSamples"; // id of browser process is appended
 static const std::string LOG_FILE_NAME = "log";
 static const std::string INTERACTION_FILE_NAME = "interaction";
+static const std::string LATENCY_TRACE_FILE_NAME = "latency_trace";
+static const std::string SIMULATION_REPORT_FILE_NAME = "simulation_report";
+static const unsigned int SIMULATION_TRACE_FRAME_COUNT = 36000; // frames kept by latency trace while simulating, ten minutes at 60 fps
+static const float SIMULATION_FIXED_ELEMENT_HEIGHT = 60.f; // pixels of generated fixed bars
+static const float SIMULATION_NESTED_NODE_RATIO = 0.1f; // chance of generated node to be placed in overflow or fixed element
+static const float SIMULATION_FIXATION_RADIUS = 30.f; // pixels gaze of trace may move within fixation
 static const int LOG_FILE_MAX_SIZE = 1024 * 1024;
 static const int LOG_FILE_COUNT = 5;
+static const int LOG_QUEUE_CAPACITY = 8192; // records in queue to background writer of log
+static const int LOG_WRITER_INTERVAL = 10; // milliseconds between background writer empties queue
+static const std::string DIAGNOSTICS_FILE_NAME = "diagnostics";
 static const float MOUSE_CURSOR_RELATIVE_SIZE = 0.1f;
 static const glm::vec3 DOM_TRIGGER_DEBUG_COLOR = glm::vec3(0, 1, 0);
 static const glm::vec3 DOM_TEXT_LINKS_DEBUG_COLOR = glm::vec3(0, 0, 1);
@@ -50,6 +73,7 @@ static const float BLUR_PERIPHERY_MULTIPLIER = 0.7f;
 static const std::string BOOKMARKS_FILE = "bookmarks.xml";
 static const std::string HISTORY_FILE = "history.xml";
 static const std::string SETTINGS_FILE = "settings.xml";
+static const std::string FAVICON_CACHE_FILE = "favicons.bin";
 static const int URL_INPUT_BOOKMARKS_ROWS_ON_SCREEN = 6;
 static const int HISTORY_ROWS_ON_SCREEN = 6;
 static const int HISTORY_DISPLAY_COUNT = 20;
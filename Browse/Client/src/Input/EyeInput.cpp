@@ -7,19 +7,52 @@
 #include "src/Utils/Logger.h"
 #include "src/Setup.h"
 #include "src/Input/Filters/WeightedAverageFilter.h"
+#include "src/Input/Filters/PredictiveFilter.h"
 #include <cmath>
 #include <functional>
+#include <algorithm>
 
 EyeInput::EyeInput(MasterThreadsafeInterface* _pMasterThreadsafeInterface, EyetrackerGeometry geometry) :
-	_spFilter(std::shared_ptr<Filter>(
-		new WeightedAverageFilter(
-			setup::FILTER_KERNEL,
-			setup::FILTER_WINDOW_SIZE,
-			setup::FILTER_USE_OUTLIER_REMOVAL)))
+	_spFilter(setup::FILTER_TYPE == FilterType::PREDICTIVE
+		? std::shared_ptr<Filter>(
+			new PredictiveFilter(
+				setup::FILTER_PREDICTIVE_MIN_CUTOFF,
+				setup::FILTER_PREDICTIVE_BETA,
+				setup::FILTER_PREDICTIVE_DERIVATIVE_CUTOFF,
+				setup::FILTER_PREDICTIVE_WINDOW_DURATION))
+		: std::shared_ptr<Filter>(
+			new WeightedAverageFilter(
+				setup::FILTER_KERNEL,
+				setup::FILTER_WINDOW_SIZE,
+				setup::FILTER_USE_OUTLIER_REMOVAL))),
+	_shouldStop(false),
+	_windowX(0),
+	_windowY(0),
+	_windowWidth(0),
+	_windowHeight(0)
 {
+	// Prepare tracker host, which tries plugins in the same order as below
+	if (setup::EYEINPUT_USE_TRACKER_HOST)
+	{
+		std::vector<std::string> plugins;
+		if (setup::CONNECT_OPEN_GAZE) { plugins.push_back("OpenGazePlugin"); }
+		if (setup::CONNECT_SMI_IVIEWX) { plugins.push_back("SMIiViewXPlugin"); }
+		if (setup::CONNECT_VI_MYGAZE) { plugins.push_back("VImyGazePlugin"); }
+		if (setup::CONNECT_TOBII_EYEX) { plugins.push_back("TobiiEyeXPlugin"); }
+		if (setup::CONNECT_MOCK) { plugins.push_back("MockPlugin"); }
+		_upTrackerHost = std::unique_ptr<TrackerHostConnection>(new TrackerHostConnection(geometry, plugins));
+	}
+
 	// Create thread for connection to eye tracker
 	_upConnectionThread = std::unique_ptr<std::thread>(new std::thread([this, _pMasterThreadsafeInterface, geometry]()
 	{
+		// Connection thread keeps supervising tracker host
+		if (_upTrackerHost)
+		{
+			RunTrackerHostSupervision(_pMasterThreadsafeInterface);
+			return;
+		}
+
 #ifdef _WIN32
 
 		// Define procedure signature for connection
@@ -144,6 +177,13 @@ EyeInput::EyeInput(MasterThreadsafeInterface* _pMasterThreadsafeInterface, Eyetr
 			{
 				_procPauseLabStream(); // pause streaming immediatelly
 			}
+
+			// Filter samples on own thread
+			if (setup::EYEINPUT_FILTER_ON_INPUT_THREAD)
+			{
+				LogInfo("EyeInput: Filtering samples on input thread.");
+				_upInputThread = std::unique_ptr<std::thread>(new std::thread(&EyeInput::RunInputThread, this));
+			}
 		}
 #endif // _WIN32
 	}));
@@ -153,8 +193,23 @@ EyeInput::~EyeInput()
 {
 	// First, wait for eye tracker connection thread to join
 	LogInfo("EyeInput: Make sure that eye tracker connection thread is joined.");
+	_shouldStop = true; // input thread started after this exits immediately
 	_upConnectionThread->join();
 
+	// Input thread has to be stopped before disconnecting eye tracker
+	if (_upInputThread)
+	{
+		LogInfo("EyeInput: Make sure that input thread is joined.");
+		_upInputThread->join();
+	}
+
+	// Tracker host disconnects eye tracker by itself
+	if (_upTrackerHost)
+	{
+		LogInfo("EyeInput: About to stop tracker host.");
+		_upTrackerHost = nullptr;
+	}
+
 #ifdef _WIN32
 
 	// Check whether necessary to disconnect
@@ -210,16 +265,28 @@ std::shared_ptr<Input> EyeInput::Update(
 	// Bool whether eye tracker is tracking
 	bool isTracking = false;
 
-#ifdef _WIN32
+	// Tell input thread about window geometry
+	_windowX = windowX;
+	_windowY = windowY;
+	_windowWidth = windowWidth;
+	_windowHeight = windowHeight;
+
+	// Eye tracker may be connected or lost by other thread meanwhile
+	const bool connected = IsConnected();
 
-	if (_info.connected && _procFetchGazeSamples != NULL && _procIsTracking != NULL)
+	if (connected && setup::EYEINPUT_FILTER_ON_INPUT_THREAD)
+	{
+		// Check, whether eye tracker is tracking. Filtering is done by input thread
+		isTracking = IsTracking();
+	}
+	else if (connected)
 	{
-		
+
 		// Prepare queue to fill
 		SampleQueue spSamples = SampleQueue(new std::deque<SampleData>);
 
 		// Fetch samples
-		_procFetchGazeSamples(spSamples); // shared pointered vector is filled by fetch procedure
+		FetchSamples(spSamples); // shared pointered vector is filled by fetch procedure
 
 		/*
 		// Expecting in screen pixel space
@@ -237,35 +304,22 @@ std::shared_ptr<Input> EyeInput::Update(
 		}
 		*/
 
-		// Convert parameters to double (use same values for all samples,
-		double windowXDouble = (double)windowX;
-		double windowYDouble = (double)windowY;
-		double windowWidthDouble = (double)windowWidth;
-		double windowHeightDouble = (double)windowHeight;
-
 		// Go over available samples and bring into window space
-		for (auto& sample : *spSamples)
-		{
-			// Do some clamping according to window coordinates for gaze x
-			sample.x = sample.x - windowXDouble;
-			sample.x = sample.x > 0.0 ? sample.x : 0.0;
-			sample.x = sample.x < windowWidthDouble ? sample.x : windowWidthDouble;
-
-			// Do some clamping according to window coordinates for gaze y
-			sample.y = sample.y - windowYDouble;
-			sample.y = sample.y > 0.0 ? sample.y : 0.0;
-			sample.y = sample.y < windowHeightDouble ? sample.y : windowHeightDouble;
-		}
+		TransformToWindow(spSamples, windowX, windowY, windowWidth, windowHeight);
 
 		// Update filter algorithm and provide local variables as reference
 		_spFilter->Update(spSamples);
 
+		// Remember timestamps for latency tracing
+		using namespace std::chrono;
+		_gazeSnapshot.sampleTimestamp = _spFilter->GetTimestamp();
+		_gazeSnapshot.filterTimestamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+		_gazeSnapshot.samplesReceived = _spFilter->IsTimestampSetOnce();
+
 		// Check, whether eye tracker is tracking
-		isTracking = _procIsTracking();
+		isTracking = IsTracking();
 	}
 
-#endif // _WIN32
-
 	// ### MOUSE INPUT ###
 
 	// Mouse override of eye tracker
@@ -332,7 +386,7 @@ std::shared_ptr<Input> EyeInput::Update(
 
 	// Bool to indicate mouse usage for gaze coordinates
 	bool gazeEmulated =
-		!_info.connected // eye tracker not connected
+		!connected // eye tracker not connected
 		|| _mouseOverride // eye tracker overriden by mouse
 		|| !isTracking; // eye tracker not available
 
@@ -340,13 +394,49 @@ std::shared_ptr<Input> EyeInput::Update(
 	_mouseX = mouseX;
 	_mouseY = mouseY;
 
-	// Get data from filter
-	double filteredGazeX = _spFilter->GetFilteredGazeX();
-	double filteredGazeY = _spFilter->GetFilteredGazeY();
+	// Get data from filter or latest snapshot of input thread
+	double filteredGazeX = 0;
+	double filteredGazeY = 0;
+	double rawGazeX = 0;
+	double rawGazeY = 0;
+	float gazeAge = 0;
+	float fixationDuration = 0;
+	if (setup::EYEINPUT_FILTER_ON_INPUT_THREAD)
+	{
+		_gazeSnapshot = _gazeSnapshots.Read();
+		filteredGazeX = _gazeSnapshot.filteredGazeX;
+		filteredGazeY = _gazeSnapshot.filteredGazeY;
+		rawGazeX = _gazeSnapshot.rawGazeX;
+		rawGazeY = _gazeSnapshot.rawGazeY;
+		gazeAge = FILTER_MAXIMUM_SAMPLE_AGE;
+		if (_gazeSnapshot.samplesReceived)
+		{
+			// Age and fixation duration continue to grow until next snapshot
+			using namespace std::chrono;
+			milliseconds now = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+			gazeAge = std::min(FILTER_MAXIMUM_SAMPLE_AGE, (float)((double)(now - _gazeSnapshot.sampleTimestamp).count() / 1000.0));
+			if (_gazeSnapshot.fixationDuration > 0)
+			{
+				fixationDuration = _gazeSnapshot.fixationDuration + (float)((double)(now - _gazeSnapshot.filterTimestamp).count() / 1000.0);
+			}
+		}
+	}
+	else
+	{
+		filteredGazeX = _spFilter->GetFilteredGazeX();
+		filteredGazeY = _spFilter->GetFilteredGazeY();
+		rawGazeX = _spFilter->GetRawGazeX();
+		rawGazeY = _spFilter->GetRawGazeY();
+		gazeAge = _spFilter->GetAge();
+		fixationDuration = _spFilter->GetFixationDuration();
+	}
 
-	// Get raw data
-	double rawGazeX = _spFilter->GetRawGazeX();
-	double rawGazeY = _spFilter->GetRawGazeY();
+	// Measure latency from sample to display, assuming display after one frame
+	if (!gazeEmulated && gazeAge < setup::MAX_AGE_OF_USED_GAZE)
+	{
+		_displayLatency += (gazeAge + tpf - _displayLatency) * EYEINPUT_DISPLAY_LATENCY_SMOOTHING;
+		_spFilter->SetPredictionHorizon(_displayLatency);
+	}
 
 	// Use mouse when gaze is emulated
 	if (gazeEmulated)
@@ -377,11 +467,11 @@ std::shared_ptr<Input> EyeInput::Update(
 		filteredGazeY, // gazeY,
 		rawGazeX, // rawGazeX
 		rawGazeY, // rawGazeY
-		_spFilter->GetAge(), // gazeAge
+		gazeAge, // gazeAge
 		gazeEmulated, // gazeEmulated,
 		false, // gazeUponGUI,
 		false, // instantInteraction,
-		_spFilter->GetFixationDuration()); // fixationDuration
+		fixationDuration); // fixationDuration
 
 	// Return whether gaze coordinates comes from eye tracker
 	return spInput;
@@ -390,6 +480,10 @@ std::shared_ptr<Input> EyeInput::Update(
 CalibrationResult EyeInput::Calibrate(std::shared_ptr<CalibrationInfo>& rspCalibrationInfo)
 {
 	CalibrationResult result = CALIBRATION_NOT_SUPPORTED;
+	if (_upTrackerHost)
+	{
+		return _upTrackerHost->Calibrate(rspCalibrationInfo);
+	}
 #ifdef _WIN32
 	if (_info.connected && _procCalibrate != NULL)
 	{
@@ -401,11 +495,31 @@ CalibrationResult EyeInput::Calibrate(std::shared_ptr<CalibrationInfo>& rspCalib
 
 bool EyeInput::SamplesReceived() const
 {
+	if (setup::EYEINPUT_FILTER_ON_INPUT_THREAD)
+	{
+		return _gazeSnapshot.samplesReceived; // snapshot of last update
+	}
 	return _spFilter->IsTimestampSetOnce();
 }
 
+bool EyeInput::GetSampleTimestamps(std::chrono::milliseconds& rSampleTimestamp, std::chrono::milliseconds& rFilterTimestamp) const
+{
+	if (!_gazeSnapshot.samplesReceived)
+	{
+		return false;
+	}
+	rSampleTimestamp = _gazeSnapshot.sampleTimestamp;
+	rFilterTimestamp = _gazeSnapshot.filterTimestamp;
+	return true;
+}
+
 void EyeInput::ContinueLabStream()
 {
+	if (_upTrackerHost)
+	{
+		_upTrackerHost->ContinueLabStream(); // also applied after host restarts
+		return;
+	}
 #ifdef _WIN32
 	if (_info.connected && _procContinueLabStream != NULL)
 	{
@@ -416,6 +530,11 @@ void EyeInput::ContinueLabStream()
 
 void EyeInput::PauseLabStream()
 {
+	if (_upTrackerHost)
+	{
+		_upTrackerHost->PauseLabStream();
+		return;
+	}
 #ifdef _WIN32
 	if (_info.connected && _procPauseLabStream != NULL)
 	{
@@ -428,3 +547,176 @@ std::weak_ptr<CustomTransformationInterface> EyeInput::GetCustomTransformationIn
 {
 	return _spFilter;
 }
+
+void EyeInput::TransformToWindow(SampleQueue& rspSamples, int windowX, int windowY, int windowWidth, int windowHeight)
+{
+	// Convert parameters to double (use same values for all samples)
+	double windowXDouble = (double)windowX;
+	double windowYDouble = (double)windowY;
+	double windowWidthDouble = (double)windowWidth;
+	double windowHeightDouble = (double)windowHeight;
+
+	// Go over available samples and bring into window space
+	for (auto& sample : *rspSamples)
+	{
+		// Do some clamping according to window coordinates for gaze x
+		sample.x = sample.x - windowXDouble;
+		sample.x = sample.x > 0.0 ? sample.x : 0.0;
+		sample.x = sample.x < windowWidthDouble ? sample.x : windowWidthDouble;
+
+		// Do some clamping according to window coordinates for gaze y
+		sample.y = sample.y - windowYDouble;
+		sample.y = sample.y > 0.0 ? sample.y : 0.0;
+		sample.y = sample.y < windowHeightDouble ? sample.y : windowHeightDouble;
+	}
+}
+
+void EyeInput::RunInputThread()
+{
+	while (!_shouldStop)
+	{
+		// Fetch samples that arrived since last iteration
+		SampleQueue spSamples = SampleQueue(new std::deque<SampleData>);
+		FetchSamples(spSamples);
+
+		// Filter and publish result
+		if (!spSamples->empty())
+		{
+			TransformToWindow(spSamples, _windowX, _windowY, _windowWidth, _windowHeight);
+			_spFilter->Update(spSamples);
+
+			using namespace std::chrono;
+			GazeSnapshot& rSnapshot = _gazeSnapshots.GetBack();
+			rSnapshot.filteredGazeX = _spFilter->GetFilteredGazeX();
+			rSnapshot.filteredGazeY = _spFilter->GetFilteredGazeY();
+			rSnapshot.rawGazeX = _spFilter->GetRawGazeX();
+			rSnapshot.rawGazeY = _spFilter->GetRawGazeY();
+			rSnapshot.fixationDuration = _spFilter->GetFixationDuration();
+			rSnapshot.sampleTimestamp = spSamples->back().timestamp;
+			rSnapshot.filterTimestamp = duration_cast<milliseconds>(system_clock::now().time_since_epoch());
+			rSnapshot.samplesReceived = true;
+			_gazeSnapshots.Publish();
+		}
+
+		// Wait for further samples
+		std::this_thread::sleep_for(std::chrono::milliseconds(setup::EYEINPUT_INPUT_THREAD_POLL_INTERVAL));
+	}
+}
+
+void EyeInput::RunTrackerHostSupervision(MasterThreadsafeInterface* pMasterThreadsafeInterface)
+{
+	// Trying to connect
+	pMasterThreadsafeInterface->threadsafe_NotifyEyeTrackerStatus(EyeTrackerStatus::TRYING_TO_CONNECT, EyeTrackerDevice::NONE);
+	if (!_upTrackerHost->IsValid())
+	{
+		LogInfo("EyeInput: Tracker host not available. Input emulated by mouse.");
+		pMasterThreadsafeInterface->threadsafe_NotifyEyeTrackerStatus(EyeTrackerStatus::DISCONNECTED, EyeTrackerDevice::NONE);
+		return;
+	}
+
+	// Setup current policy about data transfer, host applies it after every connection
+	if (pMasterThreadsafeInterface->threadsafe_MayTransferData())
+	{
+		_upTrackerHost->ContinueLabStream();
+	}
+	else
+	{
+		_upTrackerHost->PauseLabStream();
+	}
+
+	// Supervise host until stopped
+	using namespace std::chrono;
+	bool connected = false;
+	bool unavailabilityNotified = false;
+	steady_clock::time_point lastDiagnostics = steady_clock::now();
+	while (!_shouldStop)
+	{
+		const sample_ring::HostState state = _upTrackerHost->Supervise();
+		const bool hostConnected = _upTrackerHost->IsConnected();
+
+		// Report changes of connection
+		if (hostConnected && !connected)
+		{
+			const std::string plugin = _upTrackerHost->GetPluginName();
+			LogInfo("EyeInput: Tracker host connected eye tracker via ", plugin, ".");
+			pMasterThreadsafeInterface->threadsafe_NotifyEyeTrackerStatus(EyeTrackerStatus::CONNECTED, GetDevice(plugin));
+			unavailabilityNotified = false;
+
+			// Filter samples on own thread
+			if (setup::EYEINPUT_FILTER_ON_INPUT_THREAD && !_upInputThread)
+			{
+				LogInfo("EyeInput: Filtering samples on input thread.");
+				_upInputThread = std::unique_ptr<std::thread>(new std::thread(&EyeInput::RunInputThread, this));
+			}
+		}
+		else if (!hostConnected && connected)
+		{
+			LogInfo("EyeInput: Tracker host lost eye tracker. Input emulated by mouse until reconnection.");
+			pMasterThreadsafeInterface->threadsafe_NotifyEyeTrackerStatus(EyeTrackerStatus::DISCONNECTED, EyeTrackerDevice::NONE);
+		}
+		else if (!hostConnected && state == sample_ring::HOST_NOT_AVAILABLE && !unavailabilityNotified)
+		{
+			LogInfo("EyeInput: No eye tracker connected. Input emulated by mouse.");
+			pMasterThreadsafeInterface->threadsafe_NotifyEyeTrackerStatus(EyeTrackerStatus::DISCONNECTED, EyeTrackerDevice::NONE);
+			unavailabilityNotified = true;
+		}
+		connected = hostConnected;
+
+		// Diagnostics
+		if (steady_clock::now() - lastDiagnostics >= seconds(setup::TRACKER_HOST_DIAGNOSTICS_INTERVAL))
+		{
+			LogInfo("EyeInput: Tracker host measured ", _upTrackerHost->GetMeasuredSamplerate(), " of ", _upTrackerHost->GetSamplerate(),
+				" Hz, dropped samples: ", _upTrackerHost->GetDroppedSampleCount(), ", restarts: ", _upTrackerHost->GetRestartCount(), ".");
+			lastDiagnostics = steady_clock::now();
+		}
+
+		std::this_thread::sleep_for(milliseconds(100));
+	}
+}
+
+bool EyeInput::IsConnected() const
+{
+	if (_upTrackerHost)
+	{
+		return _upTrackerHost->IsConnected();
+	}
+	return _info.connected;
+}
+
+bool EyeInput::IsTracking() const
+{
+	if (_upTrackerHost)
+	{
+		return _upTrackerHost->IsTracking();
+	}
+#ifdef _WIN32
+	return _procIsTracking != NULL && _procIsTracking();
+#else
+	return false;
+#endif // _WIN32
+}
+
+void EyeInput::FetchSamples(SampleQueue& rspSamples)
+{
+	if (_upTrackerHost)
+	{
+		_upTrackerHost->FetchSamples(rspSamples);
+		return;
+	}
+#ifdef _WIN32
+	if (_procFetchGazeSamples != NULL)
+	{
+		_procFetchGazeSamples(rspSamples);
+	}
+#endif // _WIN32
+}
+
+EyeTrackerDevice EyeInput::GetDevice(std::string plugin)
+{
+	if (plugin == "OpenGazePlugin") { return EyeTrackerDevice::OPEN_GAZE; }
+	if (plugin == "SMIiViewXPlugin") { return EyeTrackerDevice::SMI_REDN; }
+	if (plugin == "VImyGazePlugin") { return EyeTrackerDevice::VI_MYGAZE; }
+	if (plugin == "TobiiEyeXPlugin") { return EyeTrackerDevice::TOBII_EYEX; }
+	if (plugin == "MockPlugin") { return EyeTrackerDevice::MOCK; }
+	return EyeTrackerDevice::NONE;
+}
@@ -4,7 +4,12 @@
 //============================================================================
 // Abstracts input from eyetracker and mouse into general eye input. Does fallback
 // to mouse cursor input provided by GLFW when no eyetracker available. Handles
-// override of eyetracking input when mouse is moved.
+// override of eyetracking input when mouse is moved. Samples are either filtered
+// once per frame or, when set in setup, by an input thread at the rate of the
+// eye tracker. Latter publishes its results as snapshot for the main loop.
+// Plugins are either loaded into this process (Windows only) or, when set in
+// setup, by a separate tracker host process, which is supervised by the
+// connection thread and delivers samples through shared memory.
 
 #ifndef EYEINPUT_H_
 #define EYEINPUT_H_
@@ -13,13 +18,17 @@
 #include "src/Master/MasterThreadsafeInterface.h"
 #include "src/Input/EyeTrackerStatus.h"
 #include "src/Input/Filters/Filter.h"
+#include "src/Input/TrackerHostConnection.h"
 #include "src/Input/Input.h"
+#include "src/Utils/TripleBuffer.h"
 #include "plugins/Eyetracker/Interface/EyetrackerSample.h"
 #include "plugins/Eyetracker/Interface/EyetrackerInfo.h"
 #include "plugins/Eyetracker/Interface/EyetrackerGeometry.h"
 #include <memory>
 #include <vector>
 #include <thread>
+#include <atomic>
+#include <chrono>
 
 // Necessary for dynamic DLL loading in Windows
 #ifdef _WIN32
@@ -58,6 +67,10 @@ public:
 	// Delegation of filter. Indicated whether age of input does say something...
 	bool SamplesReceived() const;
 
+	// Timestamp of newest sample used by last update and time it was filtered, both since epoch of system
+	// clock. Returns false when no samples were received so far
+	bool GetSampleTimestamps(std::chrono::milliseconds& rSampleTimestamp, std::chrono::milliseconds& rFilterTimestamp) const;
+
 	// Continue lab streaming layer streaming of eye gaze data
 	void ContinueLabStream();
 
@@ -69,9 +82,64 @@ public:
 
 private:
 
+	// Result of filtering, published by input thread
+	struct GazeSnapshot
+	{
+		double filteredGazeX = -1;
+		double filteredGazeY = -1;
+		double rawGazeX = -1;
+		double rawGazeY = -1;
+		float fixationDuration = 0; // at time of filtering
+		std::chrono::milliseconds sampleTimestamp; // timestamp of newest sample
+		std::chrono::milliseconds filterTimestamp; // time of filtering
+		bool samplesReceived = false;
+	};
+
+	// Bring samples from screen into window space
+	static void TransformToWindow(SampleQueue& rspSamples, int windowX, int windowY, int windowWidth, int windowHeight);
+
+	// Executed by input thread. Fetches and filters samples until stopped
+	void RunInputThread();
+
+	// Executed by connection thread when using tracker host. Supervises host until stopped
+	void RunTrackerHostSupervision(MasterThreadsafeInterface* pMasterThreadsafeInterface);
+
+	// Whether eye tracker is connected, either in this process or by tracker host
+	bool IsConnected() const;
+
+	// Whether connected eye tracker is tracking
+	bool IsTracking() const;
+
+	// Append samples from connected eye tracker
+	void FetchSamples(SampleQueue& rspSamples);
+
+	// Device of plugin by name
+	static EyeTrackerDevice GetDevice(std::string plugin);
+
 	// Thread that connects to eye tracking device
 	std::unique_ptr<std::thread> _upConnectionThread;
 
+	// Thread that filters samples as they arrive, started by connection thread
+	std::unique_ptr<std::thread> _upInputThread;
+
+	// Indicates input thread and supervision of tracker host to stop
+	std::atomic<bool> _shouldStop;
+
+	// Connection to tracker host, only used when set in setup
+	std::unique_ptr<TrackerHostConnection> _upTrackerHost;
+
+	// Window geometry used by input thread, written by main thread
+	std::atomic<int> _windowX;
+	std::atomic<int> _windowY;
+	std::atomic<int> _windowWidth;
+	std::atomic<int> _windowHeight;
+
+	// Snapshots from input thread to main thread
+	TripleBuffer<GazeSnapshot> _gazeSnapshots;
+
+	// Snapshot used in current frame. Only timestamps are filled when filtering once per frame
+	GazeSnapshot _gazeSnapshot;
+
 	// ###################################
 	// ### Variables written by thread ###
 	// ###################################
@@ -115,6 +183,9 @@ private:
 
 	// Filter of gaze data
 	std::shared_ptr<Filter> _spFilter;
+
+	// Smoothed duration from sample to display, in seconds
+	float _displayLatency = 0;
 };
 
 #endif // EYEINPUT_H_
\ No newline at end of file
@@ -15,7 +15,7 @@ enum class EyeTrackerStatus
 // Enumeration about available eye trackers
 enum class EyeTrackerDevice
 {
-	OPEN_GAZE, SMI_REDN, VI_MYGAZE, TOBII_EYEX, NONE
+	OPEN_GAZE, SMI_REDN, VI_MYGAZE, TOBII_EYEX, MOCK, NONE
 };
 
 #endif EYETRACKERSTATUS_H_
\ No newline at end of file
@@ -22,6 +22,8 @@ Filter::~Filter()
 
 void Filter::Update(const SampleQueue spSamples)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	// Only work with non-empty sample queue
 	if (!spSamples->empty())
 	{
@@ -138,13 +140,25 @@ float Filter::GetAge() const
 	}
 }
 
+std::chrono::milliseconds Filter::GetTimestamp() const
+{
+	return _timestamp;
+}
+
 bool Filter::IsTimestampSetOnce() const
 {
 	return _timestampSetOnce;
 }
 
+void Filter::SetPredictionHorizon(float seconds)
+{
+	// Nothing to do
+}
+
 bool Filter::RegisterCustomTransformation(std::string name, FilterTransformation transformation)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	// Check whether custom transformation already exists
 	auto it = _customTransformations.find(name);
 	if (it == _customTransformations.end())
@@ -172,6 +186,7 @@ bool Filter::RegisterCustomTransformation(std::string name, FilterTransformation
 
 bool Filter::ChangeCustomTransformation(std::string name, FilterTransformation transformation)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	auto it = _customTransformations.find(name);
 	if (it != _customTransformations.end())
 	{
@@ -183,6 +198,8 @@ bool Filter::ChangeCustomTransformation(std::string name, FilterTransformation t
 
 bool Filter::UnregisterCustomTransformation(std::string name)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	// Check whether custom transformation exists
 	auto it = _customTransformations.find(name);
 	if (it != _customTransformations.end())
@@ -198,10 +215,12 @@ bool Filter::UnregisterCustomTransformation(std::string name)
 
 double Filter::GetFilteredGazeX(std::string name) const
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	return _customTransformations.at(name).gazeX;
 }
 
 double Filter::GetFilteredGazeY(std::string name) const
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	return _customTransformations.at(name).gazeY;
 }
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include "src/Input/Filters/CustomTransformationInteface.h"
 #include "plugins/Eyetracker/Interface/EyetrackerSample.h"
 #include <map>
+#include <mutex>
 
 
 // Filter class
@@ -23,10 +24,11 @@ public:
 	// Destructor
 	virtual ~Filter() = 0;
 
-	// Update. Takes samples in window pixel coordinates
+	// Update. Takes samples in window pixel coordinates. May be called by other thread
+	// than the one using the custom transformation interface
 	void Update(const SampleQueue spSamples);
 
-	// Various getters
+	// Various getters. Must be called by same thread as update
 	double GetRawGazeX() const;
 	double GetRawGazeY() const;
 	double GetFilteredGazeX() const;
@@ -36,9 +38,15 @@ public:
 	// Getter for age of last used sample
 	float GetAge() const;
 
+	// Getter for timestamp of last used sample
+	std::chrono::milliseconds GetTimestamp() const;
+
 	// Getter which returns whether timestamp was actively set at least once (aka at least one sample received)
 	bool IsTimestampSetOnce() const;
 
+	// Set duration from newest sample until filtered gaze is displayed. Only used by filters that extrapolate
+	virtual void SetPredictionHorizon(float seconds);
+
 	// #######################################
 	// ### CUSTOM TRANSFORMATION INTERFACE ###
 	// #######################################
@@ -90,6 +98,9 @@ private:
 	double _gazeX = -1; // filtered
 	double _gazeY = -1; // filtered
 	float _fixationDuration = 0;
+
+	// Mutex guarding samples and custom transformations, as those are accessed by update and interface
+	mutable std::mutex _mutex;
 };
 
 #endif FILTER_H_
\ No newline at end of file
@@ -0,0 +1,16 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Filter type enumeration.
+
+#ifndef FILTERTYPE_H_
+#define FILTERTYPE_H_
+
+enum class FilterType
+{
+	WEIGHTED_AVERAGE, // weighted average over current fixation, see FilterKernel for weights
+	PREDICTIVE // saccade aware one euro filter, extrapolated to time of display
+};
+
+#endif // FILTERTYPE_H_
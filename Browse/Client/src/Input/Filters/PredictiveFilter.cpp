@@ -0,0 +1,106 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "PredictiveFilter.h"
+#include "src/Utils/Helper.h"
+#include "src/Setup.h"
+
+// Smoothing factor of exponential filter for given cutoff frequency and time step
+static double SmoothingFactor(double cutoff, double timeStep)
+{
+	const double tau = 1.0 / (2.0 * 3.14159265358979 * cutoff);
+	return 1.0 / (1.0 + tau / timeStep);
+}
+
+PredictiveFilter::PredictiveFilter(float minCutoff, float beta, float derivativeCutoff, float windowDuration) :
+	_minCutoff(minCutoff), _beta(beta), _derivativeCutoff(derivativeCutoff), _windowDuration(windowDuration), _predictionHorizon(0.f)
+{
+	// Nothing to do
+}
+
+void PredictiveFilter::SetPredictionHorizon(float seconds)
+{
+	_predictionHorizon = glm::clamp(seconds, 0.f, setup::FILTER_PREDICTIVE_MAX_HORIZON);
+}
+
+void PredictiveFilter::ApplyFilter(const SampleQueue& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration) const
+{
+	// Nothing to filter
+	if (rSamples->empty())
+	{
+		rFixationDuration = 0;
+		return;
+	}
+
+	// Find oldest sample within window
+	const int size = (int)rSamples->size();
+	const auto windowStart = rSamples->back().timestamp - std::chrono::milliseconds((long long)(_windowDuration * 1000.f));
+	int startIndex = size - 1;
+	while (startIndex > 0 && rSamples->at(startIndex - 1).timestamp >= windowStart)
+	{
+		--startIndex;
+	}
+
+	// Filter state
+	glm::dvec2 gaze;
+	glm::dvec2 velocity; // pixels per second
+	int fixationIndex = -1; // index of sample where current fixation started
+
+	// Go over samples from oldest to latest
+	for (int i = startIndex; i < size; i++)
+	{
+		const auto& rSample = rSamples->at(i);
+		const glm::dvec2 sample(rSample.x, rSample.y);
+
+		// Restart at first sample and after saccades
+		if (fixationIndex < 0
+			|| glm::distance(sample, glm::dvec2(rSamples->at(i - 1).x, rSamples->at(i - 1).y)) > setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS)
+		{
+			gaze = sample;
+			velocity = glm::dvec2(0, 0);
+			fixationIndex = i;
+			continue;
+		}
+
+		// Time step, timestamps have millisecond resolution only
+		const double timeStep = glm::max(0.001, (double)(rSample.timestamp - rSamples->at(i - 1).timestamp).count() / 1000.0);
+
+		// Filter velocity
+		const glm::dvec2 rawVelocity = (sample - gaze) / timeStep;
+		velocity = glm::mix(velocity, rawVelocity, SmoothingFactor(_derivativeCutoff, timeStep));
+
+		// Filter gaze with cutoff adapted to speed
+		const double cutoff = _minCutoff + _beta * glm::length(velocity);
+		gaze = glm::mix(gaze, sample, SmoothingFactor(cutoff, timeStep));
+	}
+
+	// Extrapolate to time of display, fading in above minimum speed so resting gaze does not jitter more
+	const double speed = glm::length(velocity);
+	const double weight = glm::clamp((speed - setup::FILTER_PREDICTIVE_MIN_SPEED) / setup::FILTER_PREDICTIVE_MIN_SPEED, 0.0, 1.0);
+	glm::dvec2 extrapolation = velocity * (double)_predictionHorizon.load() * weight;
+	const double extrapolationLength = glm::length(extrapolation);
+	if (extrapolationLength > setup::FILTER_PREDICTIVE_MAX_EXTRAPOLATION)
+	{
+		extrapolation *= setup::FILTER_PREDICTIVE_MAX_EXTRAPOLATION / extrapolationLength;
+	}
+	rGazeX = gaze.x + extrapolation.x;
+	rGazeY = gaze.y + extrapolation.y;
+
+	// Fixation may have started before window
+	if (fixationIndex == startIndex)
+	{
+		while (fixationIndex > 0
+			&& glm::distance(
+				glm::dvec2(rSamples->at(fixationIndex).x, rSamples->at(fixationIndex).y),
+				glm::dvec2(rSamples->at(fixationIndex - 1).x, rSamples->at(fixationIndex - 1).y))
+			<= setup::FILTER_GAZE_FIXATION_PIXEL_RADIUS)
+		{
+			--fixationIndex;
+		}
+	}
+
+	// Calculate fixation duration (duration from now to receiving of oldest sample contributing to fixation)
+	rFixationDuration = (float)((double)std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch() - rSamples->at(fixationIndex).timestamp).count() / 1000.0);
+}
@@ -0,0 +1,45 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// One euro filter (Casiez et al., 2012) that adapts its smoothing to the speed
+// of the gaze. Distance between subsequent samples above fixation radius is
+// treated as saccade and restarts the filter at the new sample, so no sample
+// is held back. Filtered gaze is extrapolated along filtered velocity to the
+// time it is expected to be displayed. Filter is recomputed on recent samples
+// at every update, as custom transformations filter their own sample queues.
+
+#ifndef PREDICTIVEFILTER_H_
+#define PREDICTIVEFILTER_H_
+
+#include "src/Input/Filters/Filter.h"
+#include <atomic>
+
+class PredictiveFilter : public Filter
+{
+public:
+
+	// Constructor
+	PredictiveFilter(
+		float minCutoff, // cutoff frequency in Hz while gaze rests
+		float beta, // increase of cutoff frequency per pixel per second of gaze speed
+		float derivativeCutoff, // cutoff frequency in Hz for gaze speed
+		float windowDuration); // seconds of samples that are filtered at every update
+
+	// Set duration from newest sample until filtered gaze is displayed
+	void SetPredictionHorizon(float seconds) override;
+
+private:
+
+	// Actual implementation of filtering
+	void ApplyFilter(const SampleQueue& rSamples, double& rGazeX, double& rGazeY, float& rFixationDuration) const override;
+
+	// Members
+	float _minCutoff;
+	float _beta;
+	float _derivativeCutoff;
+	float _windowDuration;
+	std::atomic<float> _predictionHorizon; // set by other thread than filtering
+};
+
+#endif // PREDICTIVEFILTER_H_
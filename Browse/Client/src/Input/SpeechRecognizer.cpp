@@ -0,0 +1,288 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "SpeechRecognizer.h"
+#include "src/Utils/Logger.h"
+#include "src/Setup.h"
+#include "submodules/json/src/json.hpp"
+#include "externals/curl/include/curl/curl.h"
+#include "externals/base64/base64.h"
+#include <algorithm>
+#include <cstring>
+
+using json = nlohmann::json;
+
+const std::string SpeechRecognizer::BODY_POSTFIX = "\"}}";
+
+// Write callback for CURL
+size_t WriteCallbackSpeech(void *contents, size_t size, size_t nmemb, void *userp)
+{
+	((std::string*)userp)->append((char*)contents, size * nmemb);
+	return size * nmemb;
+}
+
+// Progress callback for CURL, aborts transfer when worker thread should stop
+int ProgressCallbackSpeech(void *clientp, curl_off_t, curl_off_t, curl_off_t, curl_off_t)
+{
+	return *((const std::atomic<bool>*)clientp) ? 1 : 0;
+}
+
+SpeechRecognizer::SpeechRecognizer(std::string URL, std::string languageCode) :
+	_URL(URL), _languageCode(languageCode), _shouldStop(false), _pendingCount(0), _streaming(false)
+{
+	// Create worker thread that executes jobs sequentially
+	_upThread = std::unique_ptr<std::thread>(new std::thread([this]()
+	{
+		// Local job queue where jobs are moved to
+		std::deque<Job> localJobQueue;
+
+		// Work until told to stop and no jobs are left
+		while (true)
+		{
+			// Wait for jobs
+			{
+				std::unique_lock<std::mutex> lock(_jobMutex);
+				_jobConditionVariable.wait(lock, [this] { return !_jobQueue.empty() || _shouldStop; });
+				if (_jobQueue.empty() && _shouldStop) { break; }
+				localJobQueue = std::move(_jobQueue);
+				_jobQueue.clear();
+			}
+
+			// Execute jobs
+			for (const auto& rJob : localJobQueue)
+			{
+				rJob();
+				--_pendingCount;
+			}
+			localJobQueue.clear();
+		}
+	}));
+}
+
+SpeechRecognizer::~SpeechRecognizer()
+{
+	// Close potentially open stream, otherwise CURL would wait forever for data
+	EndStream();
+
+	// Tell thread to stop and wait for it
+	{
+		std::lock_guard<std::mutex> lock(_jobMutex);
+		_shouldStop = true;
+	}
+	_jobConditionVariable.notify_all();
+	_upThread->join();
+}
+
+void SpeechRecognizer::Recognize(std::shared_ptr<const std::vector<short> > spSamples, size_t sampleCount, int sampleRate, int channelCount)
+{
+	// Build body on calling thread, so worker never reads the sample buffer shared with the caller
+	sampleCount = std::min(sampleCount, spSamples->size());
+	std::shared_ptr<std::string> spBody = std::make_shared<std::string>(BuildBodyPrefix(sampleRate, channelCount));
+	spBody->append(base64_encode(
+		reinterpret_cast<const unsigned char*>(spSamples->data()),
+		(unsigned int)(sampleCount * sizeof(short)))); // LINEAR16 is plain PCM, no header required
+	spBody->append(BODY_POSTFIX);
+	PushBackJob([this, spBody]()
+	{
+		PushBackTranscript(PerformRequest(spBody.get()));
+	});
+}
+
+void SpeechRecognizer::BeginStream(int sampleRate, int channelCount)
+{
+	// Close any stream that is still open
+	EndStream();
+
+	// Create new stream, the request of a previous one may still read from that one
+	_spStream = std::make_shared<Stream>();
+	_spStream->buffer = BuildBodyPrefix(sampleRate, channelCount);
+	_streamRemainder.clear();
+	_streaming = true;
+
+	// Request reads from the stream until it is ended
+	auto spStream = _spStream;
+	PushBackJob([this, spStream]()
+	{
+		PushBackTranscript(PerformRequest(nullptr, spStream.get()));
+	});
+}
+
+void SpeechRecognizer::AppendToStream(const short* pSamples, int count)
+{
+	if (!_streaming || count <= 0) { return; }
+
+	// Collect bytes including remainder of last call
+	const unsigned char* pBytes = reinterpret_cast<const unsigned char*>(pSamples);
+	std::vector<unsigned char> bytes(std::move(_streamRemainder));
+	bytes.insert(bytes.end(), pBytes, pBytes + (count * sizeof(short)));
+
+	// Encode triplets only, keep rest for next call
+	const size_t encodable = bytes.size() - (bytes.size() % 3);
+	_streamRemainder.assign(bytes.begin() + encodable, bytes.end());
+	std::string encoded = base64_encode(bytes.data(), (unsigned int)encodable);
+
+	// Hand over to CURL read callback
+	{
+		std::lock_guard<std::mutex> lock(_spStream->mutex);
+		_spStream->buffer.append(encoded);
+	}
+	_spStream->conditionVariable.notify_all();
+}
+
+void SpeechRecognizer::EndStream()
+{
+	if (!_streaming) { return; }
+	_streaming = false;
+
+	// Encode remainder with padding and close the body
+	{
+		std::lock_guard<std::mutex> lock(_spStream->mutex);
+		_spStream->buffer.append(base64_encode(_streamRemainder.data(), (unsigned int)_streamRemainder.size()));
+		_spStream->buffer.append(BODY_POSTFIX);
+		_spStream->ended = true;
+	}
+	_spStream->conditionVariable.notify_all();
+	_streamRemainder.clear();
+	_spStream.reset();
+}
+
+bool SpeechRecognizer::FetchTranscript(std::string& rTranscript)
+{
+	std::lock_guard<std::mutex> lock(_transcriptMutex);
+	if (_transcripts.empty()) { return false; }
+	rTranscript = _transcripts.front();
+	_transcripts.pop_front();
+	return true;
+}
+
+void SpeechRecognizer::PushBackJob(Job job)
+{
+	++_pendingCount;
+	{
+		std::lock_guard<std::mutex> lock(_jobMutex);
+		_jobQueue.push_back(job);
+	}
+	_jobConditionVariable.notify_all();
+}
+
+std::string SpeechRecognizer::PerformRequest(const std::string* pBody, Stream* pStream)
+{
+	std::string answerBodyBuffer;
+
+	// Setup CURL
+	CURL* curl = curl_easy_init();
+	if (curl)
+	{
+		struct curl_slist* headers = nullptr; // init to NULL is important
+		headers = curl_slist_append(headers, "Content-Type: application/json"); // type is JSON
+		curl_easy_setopt(curl, CURLOPT_URL, _URL.c_str());
+		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
+		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallbackSpeech); // set callback for answer body
+		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
+		curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, setup::VOICE_REQUEST_CONNECT_TIMEOUT);
+		curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L); // enable progress callback
+		curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallbackSpeech); // aborts stalled request at shutdown
+		curl_easy_setopt(curl, CURLOPT_XFERINFODATA, &_shouldStop);
+
+		if (pBody != nullptr) // complete body available
+		{
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, pBody->c_str());
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, (long)pBody->size());
+			curl_easy_setopt(curl, CURLOPT_TIMEOUT, setup::VOICE_REQUEST_TIMEOUT);
+		}
+		else // body is read from stream while recording
+		{
+			headers = curl_slist_append(headers, "Transfer-Encoding: chunked");
+			curl_easy_setopt(curl, CURLOPT_POST, 1L);
+			curl_easy_setopt(curl, CURLOPT_READFUNCTION, ReadStreamCallback);
+			curl_easy_setopt(curl, CURLOPT_READDATA, pStream);
+		}
+		curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers); // apply header
+
+		// Execute request
+		CURLcode res = curl_easy_perform(curl);
+		if (res != CURLE_OK) // something went wrong
+		{
+			LogError("SpeechRecognizer: Request failed: ", curl_easy_strerror(res));
+			answerBodyBuffer.clear();
+		}
+
+		// Cleanup
+		curl_slist_free_all(headers); headers = nullptr;
+		curl_easy_cleanup(curl); curl = nullptr;
+	}
+	return answerBodyBuffer;
+}
+
+void SpeechRecognizer::PushBackTranscript(const std::string& rAnswer)
+{
+	std::string transcript = "";
+
+	// Parse answer and extract transcript of first alternative. Answer may be anything, e.g. an error page of a proxy
+	json jsonAnswer;
+	if (!rAnswer.empty())
+	{
+		try
+		{
+			jsonAnswer = json::parse(rAnswer);
+		}
+		catch (const std::exception& e)
+		{
+			LogError("SpeechRecognizer: Answer is no valid JSON: ", e.what());
+		}
+	}
+	if (jsonAnswer.is_object())
+	{
+		auto results = jsonAnswer.find("results");
+		if (results != jsonAnswer.end() && results->is_array() && !results->empty() && results->at(0).is_object())
+		{
+			auto alternatives = results->at(0).find("alternatives");
+			if (alternatives != results->at(0).end() && alternatives->is_array() && !alternatives->empty() && alternatives->at(0).is_object())
+			{
+				auto result = alternatives->at(0).find("transcript");
+				if (result != alternatives->at(0).end() && result->is_string())
+				{
+					transcript = result->get<std::string>();
+				}
+			}
+		}
+	}
+	if (transcript.empty())
+	{
+		LogError("SpeechRecognizer: No result returned");
+	}
+
+	// Store it for caller
+	std::lock_guard<std::mutex> lock(_transcriptMutex);
+	_transcripts.push_back(transcript);
+}
+
+std::string SpeechRecognizer::BuildBodyPrefix(int sampleRate, int channelCount) const
+{
+	const json config =
+	{
+		{ "encoding", "LINEAR16" },
+		{ "sampleRateHertz", sampleRate },
+		{ "audioChannelCount", channelCount },
+		{ "maxAlternatives", 1 },
+		{ "languageCode", _languageCode }
+	};
+	return "{\"config\":" + config.dump() + ",\"audio\":{\"content\":\"";
+}
+
+size_t SpeechRecognizer::ReadStreamCallback(char* pBuffer, size_t size, size_t nitems, void* pUserData)
+{
+	Stream* pStream = static_cast<Stream*>(pUserData);
+
+	// Wait until data is available or the stream has been ended
+	std::unique_lock<std::mutex> lock(pStream->mutex);
+	pStream->conditionVariable.wait(lock, [pStream] { return !pStream->buffer.empty() || pStream->ended; });
+
+	// Copy as much as fits into CURL buffer, zero tells CURL that the body is complete
+	const size_t count = std::min(size * nitems, pStream->buffer.size());
+	std::memcpy(pBuffer, pStream->buffer.data(), count);
+	pStream->buffer.erase(0, count);
+	return count;
+}
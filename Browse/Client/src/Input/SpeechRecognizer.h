@@ -0,0 +1,108 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Sends recorded audio to the speech recognition API. Requests are performed
+// in a thread of their own, so the caller never waits for the network. Audio
+// is encoded directly from memory. Optionally, the request is opened at the
+// start of recording and samples are streamed as chunked upload while the
+// user is still speaking. Transcripts are fetched by polling.
+
+#ifndef SPEECHRECOGNIZER_H_
+#define SPEECHRECOGNIZER_H_
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+
+class SpeechRecognizer
+{
+public:
+
+	// Constructor, starts worker thread. URL must include any API key
+	SpeechRecognizer(std::string URL, std::string languageCode);
+
+	// Destructor, aborts pending requests and joins worker thread
+	virtual ~SpeechRecognizer();
+
+	// Recognize first samples of complete recording. Samples are encoded before returning, request is performed by worker thread
+	void Recognize(std::shared_ptr<const std::vector<short> > spSamples, size_t sampleCount, int sampleRate, int channelCount);
+
+	// Open streaming request. Samples are appended until the stream is ended. Returns immediately
+	void BeginStream(int sampleRate, int channelCount);
+
+	// Append samples to open stream. Samples are encoded before returning, so caller may overwrite them
+	// afterwards. Called from the thread that called BeginStream
+	void AppendToStream(const short* pSamples, int count);
+
+	// End open stream, so the request can be completed. Returns immediately
+	void EndStream();
+
+	// Whether a stream is open
+	bool IsStreaming() const { return _streaming; }
+
+	// Whether some request is queued or running
+	bool IsBusy() const { return _pendingCount > 0; }
+
+	// Fetch transcript of finished request. Returns false if none available. Transcript is empty when nothing was recognized
+	bool FetchTranscript(std::string& rTranscript);
+
+private:
+
+	// Typedef of job executed by the worker thread
+	typedef std::function<void()> Job;
+
+	// Push job to worker thread
+	void PushBackJob(Job job);
+
+	// Stream of body data, written by caller and read by worker thread through CURL read callback
+	struct Stream
+	{
+		std::mutex mutex;
+		std::condition_variable conditionVariable;
+		std::string buffer; // encoded body data not yet read by CURL
+		bool ended = false;
+	};
+
+	// Perform request, either with complete body or by reading chunks of the stream. Returns answer body
+	std::string PerformRequest(const std::string* pBody, Stream* pStream = nullptr);
+
+	// Parse transcript from answer and push it to transcripts
+	void PushBackTranscript(const std::string& rAnswer);
+
+	// Build body parts around base64 encoded audio content
+	std::string BuildBodyPrefix(int sampleRate, int channelCount) const;
+	static const std::string BODY_POSTFIX;
+
+	// Read callback of CURL for streaming request
+	static size_t ReadStreamCallback(char* pBuffer, size_t size, size_t nitems, void* pUserData);
+
+	// Constants
+	const std::string _URL;
+	const std::string _languageCode;
+
+	// Worker thread
+	std::unique_ptr<std::thread> _upThread;
+	std::mutex _jobMutex;
+	std::condition_variable _jobConditionVariable;
+	std::deque<Job> _jobQueue;
+	std::atomic<bool> _shouldStop;
+	std::atomic<int> _pendingCount;
+
+	// Currently open stream, shared with the request reading it
+	std::shared_ptr<Stream> _spStream;
+	std::atomic<bool> _streaming;
+	std::vector<unsigned char> _streamRemainder; // bytes not yet encoded since base64 works on triplets
+
+	// Transcripts, written by worker thread and read by caller
+	std::mutex _transcriptMutex;
+	std::deque<std::string> _transcripts;
+};
+
+#endif // SPEECHRECOGNIZER_H_
@@ -0,0 +1,346 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "TrackerHostConnection.h"
+#include "src/Utils/Logger.h"
+#include "src/Setup.h"
+#include "src/Global.h"
+#include <thread>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <signal.h>
+#include <unistd.h>
+#include <climits>
+#include <sys/wait.h>
+extern char** environ;
+#endif
+
+// Path of directory containing executable of browser, where host is placed, too
+static std::string ExecutableDirectory()
+{
+#ifdef _WIN32
+	char buffer[MAX_PATH];
+	const DWORD length = GetModuleFileNameA(NULL, buffer, MAX_PATH);
+	std::string path(buffer, length);
+	return path.substr(0, path.find_last_of("\\/"));
+#else
+	char buffer[PATH_MAX];
+	const ssize_t length = readlink("/proc/self/exe", buffer, sizeof(buffer) - 1);
+	if (length <= 0)
+	{
+		return ".";
+	}
+	std::string path(buffer, length);
+	return path.substr(0, path.find_last_of('/'));
+#endif
+}
+
+// Id of process of browser, to make name of shared memory unique
+static unsigned long ProcessId()
+{
+#ifdef _WIN32
+	return (unsigned long)GetCurrentProcessId();
+#else
+	return (unsigned long)getpid();
+#endif
+}
+
+TrackerHostConnection::TrackerHostConnection(EyetrackerGeometry geometry, std::vector<std::string> plugins, int calibrationTimeout) :
+	_plugins(plugins), _hostStarted(false), _restartCount(0), _calibrating(false), _abandonHost(false), _calibrationTimeout(calibrationTimeout), _droppedSampleCount(0)
+{
+	// Create shared memory
+	const std::string name = TRACKER_HOST_SHARED_MEMORY_NAME + std::to_string(ProcessId());
+	_upMemory = std::unique_ptr<SharedMemory>(new SharedMemory(name, sizeof(sample_ring::Ring), true));
+	if (!_upMemory->IsValid())
+	{
+		LogError("TrackerHostConnection: Failed to create shared memory ", name, ".");
+		return;
+	}
+
+	// Initialize it
+	sample_ring::Ring& rRing = Ring();
+	sample_ring::Initialize(rRing);
+	rRing.monitorWidth = geometry.monitorWidth;
+	rRing.monitorHeight = geometry.monitorHeight;
+	rRing.mountingAngle = geometry.mountingAngle;
+	rRing.relativeDistanceHeight = geometry.relativeDistanceHeight;
+	rRing.relativeDistanceDepth = geometry.relativeDistanceDepth;
+}
+
+TrackerHostConnection::~TrackerHostConnection()
+{
+	if (_upMemory->IsValid())
+	{
+		Ring().shutdown = 1;
+		StopHost(setup::TRACKER_HOST_EXIT_TIMEOUT);
+	}
+}
+
+sample_ring::HostState TrackerHostConnection::Supervise()
+{
+	if (!_upMemory->IsValid())
+	{
+		return sample_ring::HOST_NOT_AVAILABLE;
+	}
+	sample_ring::Ring& rRing = Ring();
+	const int64_t now = sample_ring::Now();
+	rRing.browserHeartbeat = now;
+
+	// Check whether host is alive. Heartbeat stops while calibrating or before host opened memory,
+	// so a host hanging in calibration is only detected by timeout of calibration
+	if (_hostStarted)
+	{
+		const bool running = IsHostRunning();
+		const int timeout = rRing.hostState == sample_ring::HOST_CONNECTED ? setup::TRACKER_HOST_HEARTBEAT_TIMEOUT : setup::TRACKER_HOST_CONNECT_TIMEOUT;
+		const bool hanging = running
+			&& (_abandonHost
+				|| (!_calibrating && now - std::max(rRing.hostHeartbeat.load(), _hostStartTime) > timeout));
+		if (!running || hanging)
+		{
+			LogError("TrackerHostConnection: Tracker host ", hanging ? "stopped responding" : "exited", ", restarting it.");
+			StopHost(0);
+			rRing.hostState = sample_ring::HOST_STARTING;
+			rRing.tracking = 0;
+			_nextStartTime = now + _restartDelay;
+			_restartDelay = std::min(std::max(2 * _restartDelay, (int64_t)setup::TRACKER_HOST_MIN_RESTART_DELAY), (int64_t)setup::TRACKER_HOST_MAX_RESTART_DELAY);
+			_restartCount++;
+			_abandonHost = false;
+		}
+		else if (rRing.hostState == sample_ring::HOST_CONNECTED)
+		{
+			_restartDelay = 0; // host works, restart immediately next time
+		}
+	}
+
+	// Start host
+	if (!_hostStarted && now >= _nextStartTime)
+	{
+		_hostStarted = StartHost();
+		_hostStartTime = now;
+		if (!_hostStarted)
+		{
+			_nextStartTime = now + setup::TRACKER_HOST_MAX_RESTART_DELAY;
+		}
+	}
+
+	return (sample_ring::HostState)rRing.hostState.load();
+}
+
+bool TrackerHostConnection::IsConnected() const
+{
+	return _upMemory->IsValid() && _hostStarted && Ring().hostState == sample_ring::HOST_CONNECTED;
+}
+
+std::string TrackerHostConnection::GetPluginName() const
+{
+	if (!IsConnected())
+	{
+		return "";
+	}
+	const char* pName = Ring().pluginName;
+	return std::string(pName, std::find(pName, pName + sample_ring::PLUGIN_NAME_LENGTH, '\0'));
+}
+
+void TrackerHostConnection::FetchSamples(SampleQueue& rspSamples)
+{
+	if (!_upMemory->IsValid())
+	{
+		return;
+	}
+	const sample_ring::Ring& rRing = Ring();
+	const uint64_t writeIndex = rRing.writeIndex.load(std::memory_order_acquire);
+
+	// Skip samples that have been overwritten already
+	if (writeIndex - _readIndex > sample_ring::CAPACITY)
+	{
+		_droppedSampleCount += writeIndex - _readIndex - sample_ring::CAPACITY;
+		_readIndex = writeIndex - sample_ring::CAPACITY;
+	}
+
+	// Copy samples
+	for (; _readIndex < writeIndex; _readIndex++)
+	{
+		double x, y;
+		int64_t timestamp;
+		if (sample_ring::Read(rRing, _readIndex, x, y, timestamp))
+		{
+			rspSamples->push_back(SampleData(x, y, SampleDataCoordinateSystem::SCREEN_PIXELS, std::chrono::milliseconds(timestamp)));
+		}
+		else
+		{
+			_droppedSampleCount++; // overwritten while reading
+		}
+	}
+}
+
+bool TrackerHostConnection::IsTracking() const
+{
+	return IsConnected() && Ring().tracking != 0;
+}
+
+CalibrationResult TrackerHostConnection::Calibrate(std::shared_ptr<CalibrationInfo>& rspCalibrationInfo)
+{
+	if (!IsConnected())
+	{
+		return CALIBRATION_NOT_SUPPORTED;
+	}
+	std::lock_guard<std::mutex> lock(_calibrationMutex);
+	sample_ring::Ring& rRing = Ring();
+
+	// Request calibration and wait for host to finish it
+	_calibrating = true;
+	const uint32_t request = rRing.calibrationRequest.fetch_add(1) + 1;
+	const int64_t deadline = sample_ring::Now() + _calibrationTimeout;
+	while (rRing.calibrationDone != request)
+	{
+		if (!IsConnected()) // host restarted meanwhile
+		{
+			_calibrating = false;
+			return CALIBRATION_FAILED;
+		}
+		if (sample_ring::Now() > deadline) // vendor library hangs, let supervision restart host
+		{
+			LogError("TrackerHostConnection: Calibration timed out.");
+			rRing.calibrationDone = request; // restarted host must not repeat it
+			_abandonHost = true;
+			_calibrating = false;
+			return CALIBRATION_FAILED;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	_calibrating = false;
+
+	// Copy result
+	rspCalibrationInfo = std::make_shared<CalibrationInfo>();
+	for (int i = 0; i < rRing.calibrationPointCount && i < sample_ring::MAX_CALIBRATION_POINTS; i++)
+	{
+		const auto& rPoint = rRing.calibrationPoints[i];
+		rspCalibrationInfo->push_back(CalibrationPoint(rPoint.positionX, rPoint.positionY, (CalibrationPointResult)rPoint.result));
+	}
+	return (CalibrationResult)rRing.calibrationResult;
+}
+
+void TrackerHostConnection::ContinueLabStream()
+{
+	if (_upMemory->IsValid()) { Ring().labStream = 1; }
+}
+
+void TrackerHostConnection::PauseLabStream()
+{
+	if (_upMemory->IsValid()) { Ring().labStream = 0; }
+}
+
+int TrackerHostConnection::GetSamplerate() const
+{
+	return IsConnected() ? Ring().samplerate.load() : -1;
+}
+
+int TrackerHostConnection::GetMeasuredSamplerate() const
+{
+	return IsConnected() ? Ring().measuredSamplerate.load() : 0;
+}
+
+bool TrackerHostConnection::StartHost()
+{
+	// Compose arguments
+	std::vector<std::string> arguments;
+#ifdef _WIN32
+	arguments.push_back(ExecutableDirectory() + "\\" + TRACKER_HOST_EXECUTABLE_NAME + ".exe");
+#else
+	arguments.push_back(ExecutableDirectory() + "/" + TRACKER_HOST_EXECUTABLE_NAME);
+#endif
+	arguments.push_back(_upMemory->GetName());
+	arguments.insert(arguments.end(), _plugins.begin(), _plugins.end());
+	LogInfo("TrackerHostConnection: Starting tracker host ", arguments.front(), ".");
+
+#ifdef _WIN32
+	std::string commandLine;
+	for (const auto& rArgument : arguments)
+	{
+		commandLine += "\"" + rArgument + "\" ";
+	}
+	STARTUPINFOA startupInfo;
+	ZeroMemory(&startupInfo, sizeof(startupInfo));
+	startupInfo.cb = sizeof(startupInfo);
+	PROCESS_INFORMATION processInfo;
+	ZeroMemory(&processInfo, sizeof(processInfo));
+	if (!CreateProcessA(NULL, &commandLine[0], NULL, NULL, FALSE, CREATE_NO_WINDOW, NULL, NULL, &startupInfo, &processInfo))
+	{
+		LogError("TrackerHostConnection: Failed to start tracker host.");
+		return false;
+	}
+	CloseHandle(processInfo.hThread);
+	_processHandle = processInfo.hProcess;
+#else
+	std::vector<char*> argv;
+	for (auto& rArgument : arguments)
+	{
+		argv.push_back(&rArgument[0]);
+	}
+	argv.push_back(nullptr);
+	pid_t processId;
+	if (posix_spawn(&processId, argv[0], NULL, NULL, argv.data(), environ) != 0)
+	{
+		LogError("TrackerHostConnection: Failed to start tracker host.");
+		return false;
+	}
+	_processId = (int)processId;
+#endif
+	return true;
+}
+
+bool TrackerHostConnection::IsHostRunning()
+{
+#ifdef _WIN32
+	return _processHandle != nullptr && WaitForSingleObject((HANDLE)_processHandle, 0) == WAIT_TIMEOUT;
+#else
+	return _processId > 0 && waitpid((pid_t)_processId, NULL, WNOHANG) == 0;
+#endif
+}
+
+void TrackerHostConnection::StopHost(int timeout)
+{
+	if (!_hostStarted)
+	{
+		return;
+	}
+	_hostStarted = false;
+
+	// Wait for host to exit by itself
+	const int64_t deadline = sample_ring::Now() + timeout;
+	while (IsHostRunning() && sample_ring::Now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+
+	// Kill it otherwise
+#ifdef _WIN32
+	if (_processHandle != nullptr)
+	{
+		if (WaitForSingleObject((HANDLE)_processHandle, 0) == WAIT_TIMEOUT)
+		{
+			LogInfo("TrackerHostConnection: Killing tracker host.");
+			TerminateProcess((HANDLE)_processHandle, 1);
+		}
+		CloseHandle((HANDLE)_processHandle);
+		_processHandle = nullptr;
+	}
+#else
+	if (_processId > 0)
+	{
+		if (waitpid((pid_t)_processId, NULL, WNOHANG) == 0)
+		{
+			LogInfo("TrackerHostConnection: Killing tracker host.");
+			kill((pid_t)_processId, SIGKILL);
+			waitpid((pid_t)_processId, NULL, 0);
+		}
+		_processId = -1;
+	}
+#endif
+}
@@ -0,0 +1,109 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Browser side of tracker host process. Creates shared memory, starts host
+// and restarts it when it exits or its heartbeat stops. Samples are read from
+// shared memory without locking. Supervise is expected to be called regularly
+// by one thread and FetchSamples by one (possibly other) thread.
+
+#ifndef TRACKERHOSTCONNECTION_H_
+#define TRACKERHOSTCONNECTION_H_
+
+#include "common/TrackerHost/SampleRing.h"
+#include "common/TrackerHost/SharedMemory.h"
+#include "plugins/Eyetracker/Interface/EyetrackerSample.h"
+#include "plugins/Eyetracker/Interface/EyetrackerInfo.h"
+#include "plugins/Eyetracker/Interface/EyetrackerGeometry.h"
+#include "src/Setup.h"
+#include <string>
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <mutex>
+
+class TrackerHostConnection
+{
+public:
+
+	// Constructor, takes plugins tried by host in given order. Host is started by first supervision
+	TrackerHostConnection(
+		EyetrackerGeometry geometry,
+		std::vector<std::string> plugins,
+		int calibrationTimeout = setup::TRACKER_HOST_CALIBRATION_TIMEOUT);
+
+	// Destructor, asks host to exit and kills it if it does not
+	virtual ~TrackerHostConnection();
+
+	// Whether shared memory could be created
+	bool IsValid() const { return _upMemory->IsValid(); }
+
+	// Send heartbeat and restart host when necessary. Returns state of host
+	sample_ring::HostState Supervise();
+
+	// Whether host has connected an eye tracker
+	bool IsConnected() const;
+
+	// Name of plugin which connected eye tracker
+	std::string GetPluginName() const;
+
+	// Append samples written since last fetch
+	void FetchSamples(SampleQueue& rspSamples);
+
+	// Whether eye tracker is tracking
+	bool IsTracking() const;
+
+	// Calibrate eye tracker, blocks until host reports result or calibration timeout is
+	// reached. Host is restarted by next supervision in the latter case
+	CalibrationResult Calibrate(std::shared_ptr<CalibrationInfo>& rspCalibrationInfo);
+
+	// Control of lab streaming layer streaming in host
+	void ContinueLabStream();
+	void PauseLabStream();
+
+	// Diagnostics
+	int GetRestartCount() const { return _restartCount; }
+	uint64_t GetDroppedSampleCount() const { return _droppedSampleCount; }
+	int GetSamplerate() const; // as reported by plugin
+	int GetMeasuredSamplerate() const; // as measured by host over last second
+
+private:
+
+	// Start host process, returns whether successful
+	bool StartHost();
+
+	// Whether host process is still running
+	bool IsHostRunning();
+
+	// Stop host process, waits given time for exit before killing it
+	void StopHost(int timeout);
+
+	// Access to memory
+	sample_ring::Ring& Ring() const { return *(sample_ring::Ring*)_upMemory->GetData(); }
+
+	// Members
+	std::unique_ptr<SharedMemory> _upMemory;
+	std::vector<std::string> _plugins;
+	std::atomic<bool> _hostStarted;
+	int64_t _hostStartTime = 0; // milliseconds since epoch
+	int64_t _restartDelay = 0; // milliseconds, grows with repeated failures
+	int64_t _nextStartTime = 0; // milliseconds since epoch
+	std::atomic<int> _restartCount;
+	std::atomic<bool> _calibrating;
+	std::atomic<bool> _abandonHost; // set when calibration timed out
+	int _calibrationTimeout; // milliseconds
+	std::mutex _calibrationMutex;
+
+	// Reading of samples
+	uint64_t _readIndex = 0;
+	std::atomic<uint64_t> _droppedSampleCount;
+
+	// Process handle
+#ifdef _WIN32
+	void* _processHandle = nullptr;
+#else
+	int _processId = -1;
+#endif
+};
+
+#endif // TRACKERHOSTCONNECTION_H_
@@ -7,6 +7,7 @@
 #ifndef VOICEINPUT_H_
 #define VOICEINPUT_H_
 
+#include "src/Input/SpeechRecognizer.h"
 #include "submodules/eyeGUI/include/eyeGUI.h"
 #include "submodules/json/src/json.hpp"
 using json = nlohmann::json;
@@ -49,13 +50,22 @@ public:
 	// Method to start recording, returns whether successful (must be manually triggered right now)
 	bool StartAudioRecording();
 
-	// Method to end recording and do processing. Returns action for browser to perform. 
-	VoiceResult EndAndProcessAudioRecording();
+	// Method to end recording. Recognition is done asynchronously, returns whether audio was handed over
+	bool EndAudioRecording();
+
+	// Update streams audio while recording and returns action for browser to perform once recognition is done
+	VoiceResult Update();
 
 private:
 
+	// Parse transcript to action
+	VoiceResult ProcessTranscript(std::string transcript) const;
+
 	// Members
 	eyegui::GUI* _pGUI;
+	std::unique_ptr<SpeechRecognizer> _upSpeechRecognizer;
+	bool _recording = false;
+	size_t _streamedSampleCount = 0; // samples already appended to stream of recognizer
 };
 
 #endif // VOICEINPUT_H_
\ No newline at end of file
@@ -0,0 +1,103 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "FrameScheduler.h"
+#include "src/Global.h"
+#include "src/Utils/Logger.h"
+#include <algorithm>
+#include <cmath>
+#include <thread>
+
+FrameScheduler::FrameScheduler(
+	float lingerDuration,
+	float maxIdleDuration,
+	float idlePollRate,
+	float gazeThreshold)
+{
+	_lingerDuration = lingerDuration;
+	_maxIdleDuration = maxIdleDuration;
+	_idlePollRate = idlePollRate;
+	_gazeThreshold = gazeThreshold;
+	_lastPoll = std::chrono::steady_clock::now();
+}
+
+void FrameScheduler::AddDamage(Damage damage)
+{
+	_damaged = true;
+	_damageCounts[(int)damage]++;
+}
+
+void FrameScheduler::UpdateGaze(float gazeX, float gazeY)
+{
+	const float dX = gazeX - _lastGazeX;
+	const float dY = gazeY - _lastGazeY;
+	if (std::sqrt((dX * dX) + (dY * dY)) > _gazeThreshold)
+	{
+		AddDamage(Damage::GAZE);
+		_lastGazeX = gazeX;
+		_lastGazeY = gazeY;
+	}
+}
+
+bool FrameScheduler::ShouldCompose(float tpf)
+{
+	// Advance time
+	_timeSinceDamage += tpf;
+	_timeSinceComposition += tpf;
+	if (_damaged)
+	{
+		_timeSinceDamage = 0.f;
+		_damaged = false;
+	}
+
+	// Compose while damage is recent or when idle for too long, so nothing freezes on screen
+	const bool compose = _timeSinceDamage <= _lingerDuration || _timeSinceComposition >= _maxIdleDuration;
+	if (compose)
+	{
+		_timeSinceComposition = 0.f;
+		_composedFrameCount++;
+	}
+	else
+	{
+		_idleFrameCount++;
+	}
+
+	// Log statistics from time to time
+	_statisticsTime += tpf;
+	if (_statisticsTime >= FRAME_SCHEDULER_STATISTICS_INTERVAL)
+	{
+		LogStatistics();
+	}
+
+	return compose;
+}
+
+void FrameScheduler::WaitForNextPoll()
+{
+	// Sleep for remaining time of poll interval since last wait, work of iteration is part of interval
+	auto pollInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+		std::chrono::duration<float>(1.f / _idlePollRate));
+	std::this_thread::sleep_until(_lastPoll + pollInterval);
+	_lastPoll = std::chrono::steady_clock::now();
+}
+
+void FrameScheduler::LogStatistics()
+{
+	const unsigned int frameCount = _composedFrameCount + _idleFrameCount;
+	LogDebug("FrameScheduler: ", _composedFrameCount, " of ", frameCount, " frames composed within ", _statisticsTime, " seconds. ",
+		"Damage by web paint: ", _damageCounts[(int)Damage::WEB_PAINT],
+		", GUI: ", _damageCounts[(int)Damage::GUI],
+		", gaze: ", _damageCounts[(int)Damage::GAZE],
+		", input: ", _damageCounts[(int)Damage::INPUT],
+		", notification: ", _damageCounts[(int)Damage::NOTIFICATION],
+		", jobs: ", _damageCounts[(int)Damage::JOBS],
+		", window: ", _damageCounts[(int)Damage::WINDOW]);
+
+	// Reset statistics
+	_statisticsTime = 0.f;
+	_composedFrameCount = 0;
+	_idleFrameCount = 0;
+	std::fill(_damageCounts, _damageCounts + (int)Damage::COUNT, 0);
+}
@@ -0,0 +1,69 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Decides per iteration of the main loop whether a frame has to be composed.
+// Sources of damage are collected during the iteration. Frames keep being
+// composed for a while after the last damage, so animations of eyeGUI and
+// the states can settle. Otherwise, composition is skipped and the loop only
+// polls input at a lower rate. Statistics about composed and idle frames are
+// logged periodically.
+
+#ifndef FRAMESCHEDULER_H_
+#define FRAMESCHEDULER_H_
+
+#include <chrono>
+
+class FrameScheduler
+{
+public:
+
+	// Sources of damage
+	enum class Damage { WEB_PAINT, GUI, GAZE, INPUT, NOTIFICATION, JOBS, WINDOW, COUNT };
+
+	// Constructor
+	FrameScheduler(
+		float lingerDuration,
+		float maxIdleDuration,
+		float idlePollRate,
+		float gazeThreshold);
+
+	// Add damage which requires composition of frame
+	void AddDamage(Damage damage);
+
+	// Add gaze damage when gaze moved beyond threshold since last composed frame
+	void UpdateGaze(float gazeX, float gazeY);
+
+	// Decide whether current frame is composed, call once per iteration after damage has been added
+	bool ShouldCompose(float tpf);
+
+	// Sleep until next poll of input is due, call instead of swapping buffers of idle frame
+	void WaitForNextPoll();
+
+private:
+
+	// Log statistics of frames since last logging
+	void LogStatistics();
+
+	// Settings
+	float _lingerDuration;
+	float _maxIdleDuration;
+	float _idlePollRate;
+	float _gazeThreshold;
+
+	// State
+	bool _damaged = true; // compose first frame
+	float _timeSinceDamage = 0.f;
+	float _timeSinceComposition = 0.f;
+	float _lastGazeX = 0.f; // gaze of last composed frame
+	float _lastGazeY = 0.f;
+	std::chrono::steady_clock::time_point _lastPoll;
+
+	// Statistics
+	float _statisticsTime = 0.f;
+	unsigned int _composedFrameCount = 0;
+	unsigned int _idleFrameCount = 0;
+	unsigned int _damageCounts[(int)Damage::COUNT] = {};
+};
+
+#endif // FRAMESCHEDULER_H_
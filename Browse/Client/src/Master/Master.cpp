@@ -6,6 +6,7 @@
 #include "Master.h"
 #include "src/Utils/Helper.h"
 #include "src/Utils/Logger.h"
+#include "src/Utils/StartupProfiler.h"
 #include "src/Arguments.h"
 #include "submodules/glfw/include/GLFW/glfw3.h"
 #include "submodules/text-csv/include/text/csv/ostream.hpp"
@@ -104,7 +105,7 @@ const std::string simpleFragmentShaderSource =
 "   fragColor = texture(tex, uv);\n"
 "}\n";
 
-Master::Master(Mediator* pCefMediator, std::string userDirectory)
+Master::Master(Mediator* pCefMediator, std::string userDirectory, StartupPreload& rPreload)
 {
 
 	voiceResult.action = VoiceAction::NO_ACTION;
@@ -114,16 +115,26 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     _pCefMediator = pCefMediator;
 	_userDirectory = userDirectory;
 
+	// ### SIMULATION ###
+
+	// Replaces CEF, so it must be known by mediator before first Tab is created
+	if (!Argument::simulationScenario.empty())
+	{
+		_upSimulation = std::unique_ptr<Simulation>(new Simulation(Argument::simulationScenario));
+		_pCefMediator->SetSimulation(_upSimulation.get());
+	}
+
     // ### GLFW AND OPENGL ###
 
     // Create OpenGL context
+	StartupStep windowStep("Create window");
     LogInfo("Initializing GLFW...");
     glfwInit();
     LogInfo("..done.");
 
     // Window mode and size
     GLFWmonitor* usedMonitor = NULL;
-    if (setup::FULLSCREEN)
+    if (setup::FULLSCREEN && !_upSimulation)
     {
         LogInfo("Fullscreen mode");
         GLFWmonitor* monitor = glfwGetPrimaryMonitor();
@@ -142,6 +153,11 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
+	if (_upSimulation)
+	{
+		// Hidden window still provides context, e.g. of Mesa with LIBGL_ALWAYS_SOFTWARE=1 on a virtual display
+		glfwWindowHint(GLFW_VISIBLE, GL_FALSE);
+	}
     _pWindow = glfwCreateWindow(_width, _height, "GazeTheWeb - Browse", usedMonitor, NULL);
     glfwMakeContextCurrent(_pWindow);
     glfwSetInputMode(_pWindow, GLFW_CURSOR, GLFW_CURSOR_HIDDEN); // hide native mouse cursor
@@ -168,6 +184,12 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
         wglSwapIntervalEXT(1);
 #endif
 
+	// Simulation measures frame times, which waiting for display would hide
+	if (_upSimulation)
+	{
+		glfwSwapInterval(0);
+	}
+
     // Register callbacks to GLFW
     static std::function<void(int, int, int, int)> kC = [&](int k, int s, int a, int m) { this->GLFWKeyCallback(k, s, a, m); };
     glfwSetKeyCallback(_pWindow, [](GLFWwindow* window, int k, int s, int a, int m) { kC(k, s, a, m); });
@@ -180,6 +202,7 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 
     static std::function<void(int, int)> fC = [&](int w, int h) { this->GLFWResizeCallback(w, h); };
     glfwSetFramebufferSizeCallback(_pWindow, [](GLFWwindow* window, int w, int h) { fC(w, h); });
+	windowStep.End();
 
 	// ### WINDOW ICON ###
 
@@ -241,6 +264,7 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     eyegui::setWarningCallback(printGUICallback);
 
 	// Create GUI builder
+	StartupStep splashStep("Show splash screen");
 	LogInfo("Creating eyeGUI...");
 	eyegui::GUIBuilder guiBuilder;
 	guiBuilder.width = _width;
@@ -250,26 +274,25 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 	guiBuilder.fontTallSize = 0.07f;
 	guiBuilder.useDriftMap = false;
 
-	// Create splash screen GUI, render it one time and throw it away
-	eyegui::GUI* pSplashGUI = guiBuilder.construct();
-	eyegui::loadStyleSheet(pSplashGUI, "stylesheets/Global.seyegui"); // load styling
-	eyegui::addLayout(pSplashGUI, "layouts/Splash.xeyegui");
-	eyegui::updateGUI(pSplashGUI, 1.f, eyegui::Input()); // update GUI one time for resizing
-	eyegui::drawGUI(pSplashGUI);
+	// Construct GUI which is rendered on top of everything else. It shows the splash screen first, which is removed at its next update
+	_pSuperGUI = guiBuilder.construct();
+	eyegui::loadStyleSheet(_pSuperGUI, "stylesheets/Global.seyegui"); // load styling
+	eyegui::Layout* pSplashLayout = eyegui::addLayout(_pSuperGUI, "layouts/Splash.xeyegui");
+	eyegui::updateGUI(_pSuperGUI, 1.f, eyegui::Input()); // update GUI one time for resizing
+	eyegui::drawGUI(_pSuperGUI);
 	glfwSwapBuffers(_pWindow);
 	glfwPollEvents(); // poll events not necessary for GUI but lets display the icon in Windows taskbar earlier
-	eyegui::terminateGUI(pSplashGUI);
+	eyegui::removeLayout(_pSuperGUI, pSplashLayout);
+	splashStep.End();
 
     // Construct GUI
+	StartupStep guiStep("Construct GUI");
 	guiBuilder.useDriftMap = setup::USE_EYEGUI_DRIFT_MAP;
     _pGUI = guiBuilder.construct(); // standard GUI object used everywhere
-	guiBuilder.useDriftMap = false;
-    _pSuperGUI = guiBuilder.construct(); // GUI which is rendered on top of everything else
     LogInfo("..done.");
 
     // Load styling
     eyegui::loadStyleSheet(_pGUI, "stylesheets/Global.seyegui");
-	eyegui::loadStyleSheet(_pSuperGUI, "stylesheets/Global.seyegui");
 
 	// Load overriding styles for demo mode
 #ifdef CLIENT_DEMO
@@ -281,8 +304,12 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     std::function<void(int, int)> resizeGUICallback = [&](int width, int height) { this->GUIResizeCallback(width, height); };
     eyegui::setResizeCallback(_pGUI, resizeGUICallback); // only one GUI needs to callback it. Use standard for it
 
-    // Load dictionary
+	guiStep.End();
+
+    // Load dictionary on main thread, as eyeGUI is not thread-safe and only takes the file path to parse it itself
+	StartupStep dictionaryStep("Load dictionary");
     _dictonaryId = eyegui::addDictionary(_pGUI, "dictionaries/NewEnglishUS.dic");
+	dictionaryStep.End();
 
     // ### INTERACTION LOGGING ###
 
@@ -346,9 +373,10 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 
     // ### STATES ###
 
-    // Create states
-    _upWeb = std::unique_ptr<Web>(new Web(this, _pCefMediator, _dataTransfer));
-    _upSettings = std::unique_ptr<Settings>(new Settings(this));
+    // Create states, which take what has been loaded while CEF was initialized
+	StartupStep statesStep("Create states");
+    _upWeb = std::unique_ptr<Web>(new Web(this, _pCefMediator, _dataTransfer, rPreload));
+    _upSettings = std::unique_ptr<Settings>(new Settings(this, rPreload));
 
     // Set first state
     _currentState = StateType::WEB;
@@ -359,9 +387,12 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 	// _upWeb->AddTab("http://html5-demos.appspot.com/static/fullscreen.html");
 	 _upWeb->AddTab(std::string(CONTENT_PATH) + "/template/template.html");
 	//_upWeb->AddTab(_upSettings->GetHomepage());
+	statesStep.End();
+
     // ### SUPER LAYOUT ###
 
     // Load layouts (deleted at eyeGUI termination)
+	StartupStep layoutsStep("Load super layouts");
     _pSuperLayout = eyegui::addLayout(_pSuperGUI, "layouts/Super.xeyegui", EYEGUI_SUPER_LAYER, true);
 
 	// Load super calibration layout
@@ -392,12 +423,36 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
     _pCursorLayout = eyegui::addLayout(_pSuperGUI, "layouts/Empty.xeyegui", EYEGUI_CURSOR_LAYER, true); // placed over super layer
     eyegui::setInputUsageOfLayout(_pCursorLayout, false);
     _cursorFrameIndex = eyegui::addFloatingFrameWithBrick(_pCursorLayout, "bricks/Cursor.beyegui", 0, 0, 0, 0, true, false); // will be moved and sized in loop
+	layoutsStep.End();
 
     // ### EYE INPUT ###
+	StartupStep inputStep("Create eye and voice input");
 	_upEyeInput = std::unique_ptr<EyeInput>(new EyeInput(this, _upSettings->GetEyetrackerGeometry()));
 
 	// ### VOICE INPUT ###
 	_upVoiceInput = std::unique_ptr<VoiceInput>(new VoiceInput(_pGUI));
+	inputStep.End();
+
+	// ### LATENCY TRACE ###
+	if (_upSimulation)
+	{
+		// Frame times of whole scenario are reported
+		_upLatencyTrace = std::unique_ptr<LatencyTrace>(new LatencyTrace(SIMULATION_TRACE_FRAME_COUNT));
+	}
+	else if (Argument::traceLatency)
+	{
+		_upLatencyTrace = std::unique_ptr<LatencyTrace>(new LatencyTrace(setup::LATENCY_TRACE_FRAME_COUNT));
+	}
+
+	// ### FRAME SCHEDULER ###
+	if (setup::FRAME_SCHEDULING && !_upSimulation) // simulation composes every frame
+	{
+		_upFrameScheduler = std::unique_ptr<FrameScheduler>(new FrameScheduler(
+			setup::FRAME_SCHEDULER_LINGER_DURATION,
+			setup::FRAME_SCHEDULER_MAX_IDLE_DURATION,
+			setup::FRAME_SCHEDULER_IDLE_POLL_RATE,
+			setup::FRAME_SCHEDULER_GAZE_THRESHOLD));
+	}
 
     // ### FRAMEBUFFER ###
     _upFramebuffer = std::unique_ptr<Framebuffer>(new Framebuffer(_width, _height));
@@ -412,10 +467,13 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 
 	// ### FIREBASE MAILER ###
 
-	// Login (waits until complete)
-	std::promise<std::string> idTokenPromise; auto idTokenFuture = idTokenPromise.get_future(); // future provides initial idToken
-	bool pushedBack = FirebaseMailer::Instance().PushBack_Login(_upSettings->GetFirebaseEmail(), _upSettings->GetFirebasePassword(), &idTokenPromise);
-	if (pushedBack) { LogInfo(idTokenFuture.get()); };
+	// Login, which is not waited for. Later commands are executed after it by the mailer, so they know the start index
+	auto spLoginStep = std::make_shared<StartupStep>("Firebase login"); // ends when continuation is executed or dropped
+	FirebaseMailer::Instance().PushBack_Login(_upSettings->GetFirebaseEmail(), _upSettings->GetFirebasePassword(), [spLoginStep](bool success)
+	{
+		spLoginStep->End();
+		if (!success) { LogInfo("Master: Login into Firebase failed"); }
+	});
 
 	// ### JAVASCRIPT TO LAB STREAMING LAYER ###
 
@@ -503,8 +561,29 @@ Master::Master(Mediator* pCefMediator, std::string userDirectory)
 
 Master::~Master()
 {
+	// Keep latency trace of last frames
+	if (_upLatencyTrace)
+	{
+		DumpLatencyTrace();
+	}
+
+	// Report frame times of simulated scenario
+	if (_upSimulation)
+	{
+		std::string filepath = _upSimulation->GetReportFilepath();
+		if (_upLatencyTrace->DumpSummary(filepath))
+		{
+			LogInfo("Master: Simulation report written to ", filepath);
+		}
+		else
+		{
+			LogError("Master: Failed to write simulation report to ", filepath);
+		}
+	}
+
     // Manual destruction of Web. Otherwise there are errors in CEF at shutdown (TODO: understand why)
     _upWeb.reset();
+	_pCefMediator->SetSimulation(NULL);
 
 	// Wait for all async jobs to finish
 	UpdateAsyncJobs(true);
@@ -613,21 +692,14 @@ void Master::PushBackAsyncJob(std::function<bool()> job)
 void Master::SimplePushBackAsyncJob(FirebaseIntegerKey countKey, FirebaseJSONKey recordKey, nlohmann::json record)
 {
 	// Add data to record
-	record.emplace("startIndex", FirebaseMailer::Instance().GetStartIndex()); // start index
 	record.emplace("date", GetDate()); // add date
 	record.emplace("timestamp", GetTimestamp()); // add timestamp
 
-	// Push back the job
-	PushBackAsyncJob(
-		[countKey, recordKey, record]() // copy of date, start index and success
+	// Persist record after count has been increased. Continuation is executed by mailer after login, so start index is known
+	FirebaseMailer::Instance().PushBack_Transform(countKey, 1, [recordKey, record](int count) mutable // copy of date and success
 	{
-		// Persist record
-		std::promise<int> promise; auto future = promise.get_future(); // future provides index
-		bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(countKey, 1, &promise); // adds one to the count
-		if (pushedBack) { pushedBack = FirebaseMailer::Instance().PushBack_Put(recordKey, record, std::to_string(future.get() - 1)); } // send JSON to database
-
-		// Return some value (not used)
-		return true;
+		record.emplace("startIndex", FirebaseMailer::Instance().GetStartIndex()); // start index
+		FirebaseMailer::Instance().PushBack_Put(recordKey, record, std::to_string(count - 1)); // send JSON to database
 	});
 }
 
@@ -705,11 +777,16 @@ void Master::Loop()
 {
 	while (!_exit)
 	{
+		// Start tracing of frame
+		if (_upLatencyTrace) { _upLatencyTrace->BeginFrame(); }
+
 		// Update the async computations
+		const size_t asyncJobCount = _asyncJobs.size();
 		UpdateAsyncJobs(false); // do not wait until finished
+		if (_upFrameScheduler && _asyncJobs.size() != asyncJobCount) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::JOBS); }
 
-		// Call exit when window should close
-		if (glfwWindowShouldClose(_pWindow))
+		// Call exit when window should close or simulated scenario is over
+		if (glfwWindowShouldClose(_pWindow) || (_upSimulation && _upSimulation->IsFinished()))
 		{
 			Exit();
 			continue;
@@ -728,6 +805,7 @@ void Master::Loop()
 
 		// Execute thread jobs
 		_threadJobsMutex.lock(); // lock jobs
+		if (_upFrameScheduler && !_threadJobs.empty()) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::JOBS); }
 		for (auto& rJob : _threadJobs)
 		{
 			rJob->Execute();
@@ -745,6 +823,8 @@ void Master::Loop()
 			// Show next notification
 			if (!_notificationStack.empty())
 			{
+				if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::NOTIFICATION); }
+
 				// Fetch notification
 				auto notification = _notificationStack.front();
 				_notificationStack.pop();
@@ -798,6 +878,9 @@ void Master::Loop()
 		{
 			_notificationTime -= tpf;
 			_notificationTime = glm::max(0.f, _notificationTime);
+
+			// Notification is hidden in next frame
+			if (_upFrameScheduler && _notificationTime <= 0) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::NOTIFICATION); }
 		}
 
         // Get cursor coordinates
@@ -806,6 +889,7 @@ void Master::Loop()
         glfwGetCursorPos(_pWindow, &currentMouseX, &currentMouseY);
 
 		// Update eye input
+		if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::EYE_INPUT); }
 		int focused = glfwGetWindowAttrib(_pWindow, GLFW_FOCUSED);
 		int windowX = 0;
 		int windowY = 0;
@@ -820,6 +904,19 @@ void Master::Loop()
 			_width,
 			_height); // returns whether gaze was used (or emulated by mouse)
 
+		// Simulation replaces gaze of eye tracker
+		if (_upSimulation) { _upSimulation->ApplyInput(*spInput, _width, _height); }
+
+		// Gaze movement changes what is displayed
+		if (_upFrameScheduler) { _upFrameScheduler->UpdateGaze((float)spInput->gazeX, (float)spInput->gazeY); }
+
+		// Tell latency trace about used sample
+		std::chrono::milliseconds sampleTimestamp, filterTimestamp;
+		if (_upLatencyTrace && !spInput->gazeEmulated && _upEyeInput->GetSampleTimestamps(sampleTimestamp, filterTimestamp))
+		{
+			_upLatencyTrace->SetSample(sampleTimestamp, filterTimestamp);
+		}
+
 		// If last gaze sample age is too high, perform recalibration
 		if (
 			!setup::DEMO_MODE // do not do it in DEMO mode
@@ -847,7 +944,9 @@ void Master::Loop()
             MOUSE_CURSOR_RELATIVE_SIZE);
 
         // Pause visualization
+        const float previousPausedDimming = _pausedDimming.getValue();
         _pausedDimming.update(tpf, !_paused);
+        if (_upFrameScheduler && _pausedDimming.getValue() != previousPausedDimming) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::GUI); }
         eyegui::setStyleTreePropertyValue(
 			_pSuperGUI,
             "pause_background",
@@ -867,35 +966,49 @@ void Master::Loop()
 		eyegui::Input eyeGUIInput;
         eyeGUIInput.instantInteraction =
 			(_leftMouseButtonPressed && spInput->gazeEmulated) // in case of gaze emulation
-			|| (_enterKeyPressed && !spInput->gazeEmulated); // other
+			|| (_enterKeyPressed && !spInput->gazeEmulated) // other
+			|| (_upSimulation && spInput->instantInteraction); // scripted by simulation
         eyeGUIInput.gazeX = (int)spInput->gazeX;
         eyeGUIInput.gazeY = (int)spInput->gazeY;
 		eyeGUIInput.gazeUsed = spInput->gazeUponGUI;
 
         // Update super GUI, including pause button
+		if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::GUI_UPDATE); }
+		bool gazeAvailable = !eyeGUIInput.gazeUsed;
 		eyeGUIInput = eyegui::updateGUI(_pSuperGUI, tpf, eyeGUIInput); // update super GUI with pause button
+		bool gazeConsumedByGUI = gazeAvailable && eyeGUIInput.gazeUsed; // element reacts on gaze, e.g. by dwelling
         if(_paused)
         {
             // Do not pipe input to standard GUI if paused
 			eyeGUIInput.gazeUsed = true; // TODO: null pointer would be nicer
         }
+		gazeAvailable = !eyeGUIInput.gazeUsed;
 		eyeGUIInput = eyegui::updateGUI(_pGUI, tpf, eyeGUIInput); // update GUI
+		gazeConsumedByGUI |= gazeAvailable && eyeGUIInput.gazeUsed;
+		if (_upFrameScheduler)
+		{
+			if (gazeConsumedByGUI) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::GUI); }
+			if (eyeGUIInput.instantInteraction) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::INPUT); }
+		}
+		if (_upLatencyTrace) { _upLatencyTrace->MarkGUIUpdate(); }
 
         // Do message loop of CEF
+		if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::CEF_MESSAGE_LOOP); }
         _pCefMediator->DoMessageLoopWork(); // TODO: Breaks randomly after sometime in debug mode?
+		if (_upSimulation) { _upSimulation->Update(tpf); } // loads and paints pages instead of CEF
+		if (_upFrameScheduler && _pCefMediator->ConsumePaint()) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::WEB_PAINT); }
+		if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::STATE_UPDATE); }
 
         // Update our input structure
 		spInput->gazeUponGUI = eyeGUIInput.gazeUsed;
 		spInput->instantInteraction = eyeGUIInput.instantInteraction;
 
-        // Bind framebuffer
-        _upFramebuffer->Bind();
-
-        // Clearing of buffers
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-		// Disable depth test for drawing
-		glDisable(GL_DEPTH_TEST);
+		// Fetch result of voice recognition, if available
+		VoiceResult recognizedVoiceResult = _upVoiceInput->Update();
+		if (recognizedVoiceResult.IsSomething())
+		{
+			voiceResult = recognizedVoiceResult;
+		}
 
 		//VOICE COMMAND
 		if (voiceResult.action != VoiceAction::NO_ACTION)
@@ -905,21 +1018,95 @@ void Master::Loop()
 			_upWeb->actionsOfVoice(voiceResult, spInput);
 			voiceResult.action = VoiceAction::NO_ACTION;
 			voiceResult.keyworkds = "";
+			if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::INPUT); }
 		}
-        // Update current state and draw it (one should use here pointer instead of switch case)
+        // Update current state (one should use here pointer instead of switch case)
         StateType nextState = StateType::WEB;
         switch (_currentState)
         {
         case StateType::WEB:
             nextState = _upWeb->Update(tpf, spInput);
-            _upWeb->Draw();
             break;
         case StateType::SETTINGS:
             nextState = _upSettings->Update(tpf, spInput);
-            _upSettings->Draw();
             break;
         }
 
+		// Decide whether frame has to be composed
+		bool compose = !_upFrameScheduler || _upFrameScheduler->ShouldCompose(tpf);
+		if (compose)
+		{
+			if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::DRAW); }
+
+			// Bind framebuffer
+			_upFramebuffer->Bind();
+
+			// Clearing of buffers
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// Disable depth test for drawing
+			glDisable(GL_DEPTH_TEST);
+
+			// Draw current state
+			switch (_currentState)
+			{
+			case StateType::WEB:
+				_upWeb->Draw();
+				break;
+			case StateType::SETTINGS:
+				_upSettings->Draw();
+				break;
+			}
+
+			// Enable depth test again
+			glEnable(GL_DEPTH_TEST);
+
+			// Draw eyeGUI on top
+			eyegui::drawGUI(_pGUI);
+			eyegui::drawGUI(_pSuperGUI);
+
+			// Bind standard framebuffer
+			_upFramebuffer->Unbind();
+
+			// Clearing of buffers
+			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+			// Bind framebuffer as texture
+			glActiveTexture(GL_TEXTURE0);
+			glBindTexture(GL_TEXTURE_2D, _upFramebuffer->GetAttachment(0));
+
+			// Render screen filling quad
+			_upScreenFillingQuad->Bind();
+
+			// Fill uniforms when necessary
+			if(setup::BLUR_PERIPHERY)
+			{
+				_upScreenFillingQuad->GetShader()->UpdateValue("focusPixelPosition", glm::vec2(spInput->gazeX, _height - spInput->gazeY)); // OpenGL coordinate system
+				_upScreenFillingQuad->GetShader()->UpdateValue("focusPixelRadius", (float)glm::min(_width, _height) * BLUR_FOCUS_RELATIVE_RADIUS);
+				_upScreenFillingQuad->GetShader()->UpdateValue("peripheryMultiplier", BLUR_PERIPHERY_MULTIPLIER);
+			}
+
+			_upScreenFillingQuad->Draw(GL_POINTS);
+
+			// Swap front and back buffers
+			if (_upLatencyTrace) { _upLatencyTrace->BeginPhase(LatencyTrace::Phase::SWAP); }
+			glfwSwapBuffers(_pWindow);
+			if (_upLatencyTrace) { _upLatencyTrace->EndFrame(); } // idle frames are not recorded
+
+			// Startup is complete with first composed frame
+			if (!_firstFrameDisplayed)
+			{
+				_firstFrameDisplayed = true;
+				StartupMark("First frame displayed");
+				LogStartupTimeline();
+			}
+		}
+		else
+		{
+			// Nothing changed, so just wait before polling input again
+			_upFrameScheduler->WaitForNextPoll();
+		}
+
         // Check next state
         if (_currentState != nextState)
         {
@@ -947,48 +1134,31 @@ void Master::Loop()
 
             // Remember state
             _currentState = nextState;
+			if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::GUI); }
         }
 
-		// Enable depth test again
-		glEnable(GL_DEPTH_TEST);
-
-        // Draw eyeGUI on top
-        eyegui::drawGUI(_pGUI);
-        eyegui::drawGUI(_pSuperGUI);
-
-        // Bind standard framebuffer
-        _upFramebuffer->Unbind();
-
-        // Clearing of buffers
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
-        // Bind framebuffer as texture
-        glActiveTexture(GL_TEXTURE0);
-        glBindTexture(GL_TEXTURE_2D, _upFramebuffer->GetAttachment(0));
-
-        // Render screen filling quad
-        _upScreenFillingQuad->Bind();
-
-        // Fill uniforms when necessary
-        if(setup::BLUR_PERIPHERY)
-        {
-            _upScreenFillingQuad->GetShader()->UpdateValue("focusPixelPosition", glm::vec2(spInput->gazeX, _height - spInput->gazeY)); // OpenGL coordinate system
-            _upScreenFillingQuad->GetShader()->UpdateValue("focusPixelRadius", (float)glm::min(_width, _height) * BLUR_FOCUS_RELATIVE_RADIUS);
-            _upScreenFillingQuad->GetShader()->UpdateValue("peripheryMultiplier", BLUR_PERIPHERY_MULTIPLIER);
-        }
-
-         _upScreenFillingQuad->Draw(GL_POINTS);
-
         // Reset reminder BEFORE POLLING
         _leftMouseButtonPressed = false;
         _enterKeyPressed = false;
 
-        // Swap front and back buffers and poll events
-        glfwSwapBuffers(_pWindow);
+        // Poll events
         glfwPollEvents();
     }
 }
 
+void Master::DumpLatencyTrace() const
+{
+	std::string filepath = LogPath + LATENCY_TRACE_FILE_NAME + ".json";
+	if (_upLatencyTrace->Dump(filepath))
+	{
+		LogInfo("Master: Latency trace written to ", filepath);
+	}
+	else
+	{
+		LogError("Master: Failed to write latency trace to ", filepath);
+	}
+}
+
 void Master::UpdateAsyncJobs(bool wait)
 {
 	// Check asynchronous jobs
@@ -1023,6 +1193,7 @@ void Master::ShowSuperCalibrationLayout()
 {
 	// Display layout to recalibrate
 	eyegui::setVisibilityOfLayout(_pSuperCalibrationLayout, true, true, true);
+	if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::GUI); }
 
 	// Notify user via sound
 	eyegui::playSound(_pGUI, "sounds/GameAudio/FlourishSpacey-1.ogg");
@@ -1032,6 +1203,7 @@ void Master::GLFWKeyCallback(int key, int scancode, int action, int mods)
 {
     if (action == GLFW_PRESS)
     {
+		if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::INPUT); }
         switch (key)
         {
             case GLFW_KEY_ESCAPE: { Exit(); break; }
@@ -1043,6 +1215,7 @@ void Master::GLFWKeyCallback(int key, int scancode, int action, int mods)
 			case GLFW_KEY_6: { _upWeb->PushBackPointingEvaluationPipeline(PointingApproach::MAGNIFICATION); break; }
 			case GLFW_KEY_7: { _upWeb->PushBackPointingEvaluationPipeline(PointingApproach::FUTURE); break; }
 			case GLFW_KEY_9: { _pCefMediator->Poll(); break; } // poll everything
+			case GLFW_KEY_L: { if (_upLatencyTrace) { DumpLatencyTrace(); } break; } // write trace of last frames
 			case GLFW_KEY_SPACE: { _upVoiceInput->StartAudioRecording(); break; }
 			case GLFW_KEY_M: {
 
@@ -1065,13 +1238,9 @@ void Master::GLFWKeyCallback(int key, int scancode, int action, int mods)
 					{ "driftX", driftX },
 					{ "driftY", driftY }
 				};
-				PushBackAsyncJob(
-					[gridJSON]() // provide copy of data
+				FirebaseMailer::Instance().PushBack_Transform(FirebaseIntegerKey::GENERAL_DRIFT_GRID_COUNT, 1, [gridJSON](int count) // provide copy of data
 				{
-					std::promise<int> promise; auto future = promise.get_future(); // future provides index
-					bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(FirebaseIntegerKey::GENERAL_DRIFT_GRID_COUNT, 1, &promise); // adds one to the count
-					if (pushedBack) { FirebaseMailer::Instance().PushBack_Put(FirebaseJSONKey::GENERAL_DRIFT_GRID, gridJSON, std::to_string(future.get())); } // send JSON to database
-					return true; // give the future some value
+					FirebaseMailer::Instance().PushBack_Put(FirebaseJSONKey::GENERAL_DRIFT_GRID, gridJSON, std::to_string(count)); // send JSON to database
 				});
 
 				break;
@@ -1082,7 +1251,7 @@ void Master::GLFWKeyCallback(int key, int scancode, int action, int mods)
 	{
 		switch (key)
 		{
-			case GLFW_KEY_SPACE: { voiceResult = _upVoiceInput->EndAndProcessAudioRecording();  }
+			case GLFW_KEY_SPACE: { _upVoiceInput->EndAudioRecording(); break; } // result is delivered asynchronously
 		}
 	}
 }
@@ -1093,11 +1262,13 @@ void Master::GLFWMouseButtonCallback(int button, int action, int mods)
     {
         _leftMouseButtonPressed = true;
     }
+	if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::INPUT); }
 }
 
 void Master::GLFWCursorPosCallback(double xpos, double ypos)
 {
-    // Nothing to do, yet
+    // Cursor is drawn by eyeGUI
+	if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::INPUT); }
 }
 
 void Master::GLFWResizeCallback(int width, int height)
@@ -1106,6 +1277,9 @@ void Master::GLFWResizeCallback(int width, int height)
     _width = width;
     _height = height;
 
+	// Everything has to be composed in new size
+	if (_upFrameScheduler) { _upFrameScheduler->AddDamage(FrameScheduler::Damage::WINDOW); }
+
     // Tell it eyeGUI (which indirect tells its Tabs which tell it CEF...)
     eyegui::resizeGUI(_pGUI, _width, _height);
     eyegui::resizeGUI(_pSuperGUI, _width, _height);
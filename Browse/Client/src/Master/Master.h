@@ -22,10 +22,15 @@
 #include "src/Utils/LerpValue.h"
 #include "src/Utils/Framebuffer.h"
 #include "src/Utils/RenderItem.h"
+#include "src/Utils/LatencyTrace.h"
+#include "src/Master/FrameScheduler.h"
+#include "src/Master/StartupPreload.h"
+#include "src/Master/Simulation.h"
 #include "src/Input/Filters/CustomTransformationInteface.h"
 #include "externals/OGL/gl_core_3_3.h"
 #include "submodules/eyeGUI/include/eyeGUI.h"
 #include <queue>
+#include <future>
 
 // Forward declaration
 class Texture;
@@ -35,8 +40,8 @@ class Master : public MasterNotificationInterface, public MasterThreadsafeInterf
 {
 public:
 
-    // Constructor takes pointer to CefMediator
-    Master(Mediator* pMediator, std::string userDirectory);
+    // Constructor takes pointer to CefMediator and work preloaded while CEF was initialized
+    Master(Mediator* pMediator, std::string userDirectory, StartupPreload& rPreload);
 
     // Destructor
     virtual ~Master();
@@ -319,9 +324,24 @@ private:
 	// Voicde input
 	std::unique_ptr<VoiceInput> _upVoiceInput;
 
+	// Latency trace, only created when requested by argument
+	std::unique_ptr<LatencyTrace> _upLatencyTrace;
+
+	// Write latency trace into user directory
+	void DumpLatencyTrace() const;
+
+	// Frame scheduler, only created when frame scheduling is enabled
+	std::unique_ptr<FrameScheduler> _upFrameScheduler;
+
+	// Simulation of pages and gaze, only created when scenario is given by argument
+	std::unique_ptr<Simulation> _upSimulation;
+
     // Id of dictionary in eyeGUI
     unsigned int _dictonaryId = 0;
 
+	// Whether first frame has been displayed, which completes startup
+	bool _firstFrameDisplayed = false;
+
     // Time until input is accepted
     float _timeUntilInput = setup::DURATION_BEFORE_INPUT;
 
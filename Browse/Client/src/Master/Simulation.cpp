@@ -0,0 +1,649 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "Simulation.h"
+#include "src/State/Web/Tab/Interface/TabCEFInterface.h"
+#include "src/State/Web/Tab/Interface/TabInteractionInterface.h"
+#include "src/State/Web/Tab/Pipelines/ZoomClickPipeline.h"
+#include "src/CEF/Data/DOMNode.h"
+#include "src/Utils/Texture.h"
+#include "src/Utils/Logger.h"
+#include "src/Global.h"
+#include <fstream>
+#include <sstream>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <cmath>
+#include <limits>
+#include <chrono>
+
+Simulation::Simulation(std::string scenarioFilepath)
+{
+	_reportFilepath = LogPath + SIMULATION_REPORT_FILE_NAME + ".json";
+	if (Load(scenarioFilepath))
+	{
+		LogInfo("Simulation: Loaded scenario ", scenarioFilepath, " with ", _pages.size(), " pages and ", _events.size(), " events over ", _duration, " seconds.");
+	}
+	else
+	{
+		LogError("Simulation: Failed to load scenario ", scenarioFilepath, ", simulation ends immediately.");
+		_duration = 0;
+	}
+}
+
+void Simulation::RegisterTab(TabCEFInterface* pTab, std::string URL)
+{
+	Browser browser;
+	browser.pendingURL = URL;
+	_browsers[pTab] = browser;
+	_pActiveTab = pTab; // new Tab is active until told otherwise
+}
+
+void Simulation::UnregisterTab(TabCEFInterface* pTab)
+{
+	_browsers.erase(pTab);
+	if (_pActiveTab == pTab) { _pActiveTab = nullptr; }
+}
+
+void Simulation::LoadURL(TabCEFInterface* pTab, std::string URL)
+{
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		iter->second.pendingURL = URL;
+	}
+}
+
+void Simulation::ReloadTab(TabCEFInterface* pTab)
+{
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		iter->second.pendingURL = iter->second.URL;
+	}
+}
+
+void Simulation::SetActiveTab(TabCEFInterface* pTab)
+{
+	_pActiveTab = pTab;
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		iter->second.paintRemaining = 0; // paint as soon as displayed
+	}
+}
+
+void Simulation::Scroll(TabCEFInterface* pTab, double deltaX, double deltaY)
+{
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		SetScrolling(pTab, iter->second, iter->second.scrollX - deltaX, iter->second.scrollY - deltaY);
+	}
+}
+
+void Simulation::ResetScrolling(TabCEFInterface* pTab)
+{
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		SetScrolling(pTab, iter->second, 0, 0);
+	}
+}
+
+void Simulation::ScrollTo(TabCEFInterface* pTab, double x, double y)
+{
+	auto iter = _browsers.find(pTab);
+	if (iter != _browsers.end())
+	{
+		SetScrolling(pTab, iter->second, x, y);
+	}
+}
+
+void Simulation::Update(float tpf)
+{
+	_time += tpf;
+	_interaction = false;
+
+	// Execute events which are due
+	while (_nextEvent < _events.size() && _events.at(_nextEvent).time <= _time)
+	{
+		const Event& rEvent = _events.at(_nextEvent++);
+		auto iter = _browsers.find(_pActiveTab);
+		if (iter == _browsers.end()) { continue; }
+		switch (rEvent.type)
+		{
+		case Event::Type::LOAD:
+			iter->second.pendingURL = rEvent.value;
+			break;
+		case Event::Type::SCROLL:
+			SetScrolling(_pActiveTab, iter->second, iter->second.scrollX, rEvent.offset);
+			break;
+		case Event::Type::PIPELINE:
+			if (TabInteractionInterface* pTab = dynamic_cast<TabInteractionInterface*>(_pActiveTab))
+			{
+				if (rEvent.value == "zoom_click")
+				{
+					pTab->PushBackPipeline(std::unique_ptr<Pipeline>(new ZoomClickPipeline(pTab)));
+				}
+				else
+				{
+					LogError("Simulation: Unknown pipeline ", rEvent.value);
+				}
+			}
+			break;
+		case Event::Type::INTERACTION:
+			_interaction = true;
+			break;
+		}
+	}
+
+	// Update loading of pages
+	for (auto& rPair : _browsers)
+	{
+		Browser& rBrowser = rPair.second;
+		if (!rBrowser.pendingURL.empty())
+		{
+			rBrowser.URL = rBrowser.pendingURL;
+			rBrowser.pendingURL.clear();
+			StartLoading(rPair.first, rBrowser);
+		}
+		else if (rBrowser.loading)
+		{
+			rBrowser.loadRemaining -= tpf;
+			if (rBrowser.loadRemaining <= 0)
+			{
+				FinishLoading(rPair.first, rBrowser);
+			}
+		}
+	}
+
+	// Paint web view of active Tab, others are hidden and do not paint
+	auto iter = _browsers.find(_pActiveTab);
+	if (iter != _browsers.end())
+	{
+		iter->second.paintRemaining -= tpf;
+		if (iter->second.paintRemaining <= 0)
+		{
+			auto pageIter = _pages.find(iter->second.URL);
+			const float paintRate = pageIter != _pages.end() ? pageIter->second.paintRate : 1.f;
+			iter->second.paintRemaining = paintRate > 0 ? 1.f / paintRate : std::numeric_limits<float>::max();
+			Paint(_pActiveTab, iter->second);
+		}
+	}
+
+	// Gaze
+	UpdateGaze(tpf);
+}
+
+void Simulation::ApplyInput(Input& rInput, int windowWidth, int windowHeight) const
+{
+	const float x = _gazeRelative ? _gazeX * windowWidth : _gazeX;
+	const float y = _gazeRelative ? _gazeY * windowHeight : _gazeY;
+	rInput.windowFocused = true;
+	rInput.gazeX = x;
+	rInput.gazeY = y;
+	rInput.rawGazeX = x;
+	rInput.rawGazeY = y;
+	rInput.gazeAge = 0;
+	rInput.gazeEmulated = false;
+	rInput.instantInteraction = _interaction;
+	rInput.fixationDuration = _gazeFixationDuration;
+}
+
+bool Simulation::Load(std::string scenarioFilepath)
+{
+	std::ifstream file(scenarioFilepath);
+	if (!file.is_open()) { return false; }
+	nlohmann::json scenario;
+	try
+	{
+		file >> scenario;
+
+		// General
+		_duration = scenario.value("duration", 60.f);
+		if (scenario.count("report"))
+		{
+			_reportFilepath = scenario["report"].get<std::string>();
+		}
+
+		// Pages
+		if (scenario.count("pages"))
+		{
+			for (auto iter = scenario["pages"].begin(); iter != scenario["pages"].end(); ++iter)
+			{
+				const nlohmann::json& rDescription = iter.value();
+				Page page;
+				page.title = rDescription.value("title", iter.key());
+				page.width = rDescription.value("width", 0.0);
+				page.height = rDescription.value("height", 0.0);
+				page.seed = rDescription.value("seed", 0u);
+				page.links = rDescription.value("links", 0);
+				page.textInputs = rDescription.value("textInputs", 0);
+				page.selectFields = rDescription.value("selectFields", 0);
+				page.overflowElements = rDescription.value("overflowElements", 0);
+				page.checkboxes = rDescription.value("checkboxes", 0);
+				page.fixedElements = rDescription.value("fixedElements", 0);
+				page.loadDuration = rDescription.value("loadDuration", page.loadDuration);
+				page.paintRate = rDescription.value("paintRate", page.paintRate);
+				if (rDescription.count("nodes")) { page.nodes = rDescription["nodes"]; }
+				_pages[iter.key()] = page;
+			}
+		}
+
+		// Events
+		if (scenario.count("events"))
+		{
+			for (const auto& rDescription : scenario["events"])
+			{
+				Event event;
+				event.time = rDescription.value("time", 0.f);
+				if (rDescription.count("load"))
+				{
+					event.type = Event::Type::LOAD;
+					event.value = rDescription["load"].get<std::string>();
+				}
+				else if (rDescription.count("scroll"))
+				{
+					event.type = Event::Type::SCROLL;
+					event.offset = rDescription["scroll"].get<double>();
+				}
+				else if (rDescription.count("pipeline"))
+				{
+					event.type = Event::Type::PIPELINE;
+					event.value = rDescription["pipeline"].get<std::string>();
+				}
+				else if (rDescription.count("interaction"))
+				{
+					event.type = Event::Type::INTERACTION;
+				}
+				else
+				{
+					LogError("Simulation: Skipping event without known type at ", event.time, " seconds.");
+					continue;
+				}
+				_events.push_back(event);
+			}
+			std::stable_sort(_events.begin(), _events.end(), [](const Event& rA, const Event& rB) { return rA.time < rB.time; });
+		}
+
+		// Gaze
+		if (scenario.count("gaze"))
+		{
+			const nlohmann::json& rGaze = scenario["gaze"];
+			_fixationDuration = rGaze.value("fixations", _fixationDuration);
+			_gazeSeed = rGaze.value("seed", 0u);
+			if (rGaze.count("trace") && !LoadGazeTrace(rGaze["trace"].get<std::string>()))
+			{
+				LogError("Simulation: Failed to load gaze trace, generating fixations instead.");
+			}
+		}
+	}
+	catch (const std::exception& rException)
+	{
+		LogError("Simulation: ", rException.what());
+		return false;
+	}
+	return true;
+}
+
+bool Simulation::LoadGazeTrace(std::string filepath)
+{
+	std::ifstream file(filepath);
+	if (!file.is_open()) { return false; }
+	std::string line;
+	double firstTimestamp = -1;
+	while (std::getline(file, line))
+	{
+		std::replace(line.begin(), line.end(), ',', ' ');
+		std::replace(line.begin(), line.end(), ';', ' ');
+		std::istringstream stream(line);
+		double timestamp, x, y;
+		if (stream >> timestamp >> x >> y)
+		{
+			if (firstTimestamp < 0) { firstTimestamp = timestamp; }
+			_gazeTrace.push_back({ (float)((timestamp - firstTimestamp) / 1000.0), (float)x, (float)y });
+		}
+	}
+	_gazeRelative = _gazeTrace.empty();
+	return !_gazeTrace.empty();
+}
+
+void Simulation::StartLoading(TabCEFInterface* pTab, Browser& rBrowser)
+{
+	LogInfo("Simulation: Loading ", rBrowser.URL);
+
+	// Same order as callbacks of CEF
+	pTab->SetLoadingStatus(true, true);
+	pTab->ResetFaviconBytes(rBrowser.URL);
+	pTab->SetURL(rBrowser.URL);
+	pTab->ClearDOMNodes();
+	SetScrolling(pTab, rBrowser, 0, 0);
+
+	auto iter = _pages.find(rBrowser.URL);
+	rBrowser.loading = true;
+	rBrowser.loadRemaining = iter != _pages.end() ? iter->second.loadDuration : 0.f;
+}
+
+void Simulation::FinishLoading(TabCEFInterface* pTab, Browser& rBrowser)
+{
+	rBrowser.loading = false;
+
+	// Size of page is at least the size of web view
+	int renderWidth = 0, renderHeight = 0;
+	pTab->GetWebRenderResolution(renderWidth, renderHeight);
+	auto iter = _pages.find(rBrowser.URL);
+	if (iter != _pages.end())
+	{
+		const Page& rPage = iter->second;
+		rBrowser.pageWidth = std::max(rPage.width, (double)renderWidth);
+		rBrowser.pageHeight = std::max(rPage.height, (double)renderHeight);
+		FeedNodes(pTab, rPage, rBrowser.pageWidth, rBrowser.pageHeight);
+		pTab->SetTitle(rPage.title);
+	}
+	else
+	{
+		rBrowser.pageWidth = renderWidth;
+		rBrowser.pageHeight = renderHeight;
+		pTab->SetTitle(rBrowser.URL);
+	}
+	pTab->SetPageResolution(rBrowser.pageWidth, rBrowser.pageHeight);
+	pTab->SetLoadingStatus(false, true);
+	rBrowser.paintRemaining = 0;
+}
+
+void Simulation::FeedNodes(TabCEFInterface* pTab, const Page& rPage, double pageWidth, double pageHeight) const
+{
+	std::mt19937 generator(rPage.seed);
+	std::uniform_real_distribution<float> positionX(0.f, (float)pageWidth);
+	std::uniform_real_distribution<float> positionY(0.f, (float)pageHeight);
+	std::uniform_real_distribution<float> chance(0.f, 1.f);
+	const CefRefPtr<CefBrowser> browser; // nodes do not belong to a real browser
+
+	// Rectangle at random position of page
+	auto randomRect = [&](float width, float height)
+	{
+		const float left = std::min(positionX(generator), (float)pageWidth - width);
+		const float top = std::min(positionY(generator), (float)pageHeight - height);
+		return Rect(top, left, top + height, left + width);
+	};
+
+	// Explicit nodes, ids are counted per type
+	std::map<std::string, int> ids;
+	for (const auto& rDescription : rPage.nodes)
+	{
+		const std::string type = rDescription.value("type", std::string("link"));
+		std::vector<Rect> rects;
+		if (rDescription.count("rects"))
+		{
+			for (const auto& rRect : rDescription["rects"]) { rects.push_back(Rect(rRect.get<std::vector<float> >())); }
+		}
+		const int fixedId = rDescription.value("fixedId", -1);
+		const int overflowId = rDescription.value("overflowId", -1);
+		DOMNode* pNode = nullptr;
+		const int id = ids[type]++;
+		if (type == "link")
+		{
+			pTab->AddDOMLink(browser, id);
+			if (auto spLink = pTab->GetDOMLink(id).lock())
+			{
+				spLink->SetText(rDescription.value("text", std::string()));
+				spLink->SetUrl(rDescription.value("url", std::string()));
+				pNode = spLink.get();
+			}
+		}
+		else if (type == "textInput")
+		{
+			pTab->AddDOMTextInput(browser, id);
+			if (auto spInput = pTab->GetDOMTextInput(id).lock())
+			{
+				spInput->SetText(rDescription.value("text", std::string()));
+				spInput->SetPassword(rDescription.value("password", false));
+				pNode = spInput.get();
+			}
+		}
+		else if (type == "selectField")
+		{
+			pTab->AddDOMSelectField(browser, id);
+			if (auto spSelect = pTab->GetDOMSelectField(id).lock())
+			{
+				spSelect->SetOptions(rDescription.value("options", std::vector<std::string>()));
+				pNode = spSelect.get();
+			}
+		}
+		else if (type == "overflowElement")
+		{
+			pTab->AddDOMOverflowElement(browser, id);
+			if (auto spOverflow = pTab->GetDOMOverflowElement(id).lock())
+			{
+				spOverflow->SetMaxScrolling(rDescription.value("scrollTopMax", 0), rDescription.value("scrollLeftMax", 0));
+				pNode = spOverflow.get();
+			}
+		}
+		else if (type == "checkbox")
+		{
+			pTab->AddDOMCheckbox(browser, id);
+			if (auto spCheckbox = pTab->GetDOMCheckbox(id).lock())
+			{
+				spCheckbox->SetCheckedState(rDescription.value("checked", false));
+				pNode = spCheckbox.get();
+			}
+		}
+		else if (type == "fixedElement")
+		{
+			pTab->AddFixedElementsCoordinates(id, rects);
+		}
+		else
+		{
+			LogError("Simulation: Unknown node type ", type);
+		}
+		if (pNode)
+		{
+			pNode->SetRects(rects);
+			pNode->SetFixedId(fixedId);
+			pNode->SetOverflowId(overflowId);
+		}
+	}
+
+	// Fixed elements as bars at top of page
+	const int fixedIdOffset = ids["fixedElement"];
+	for (int i = 0; i < rPage.fixedElements; i++)
+	{
+		const float top = (float)i * SIMULATION_FIXED_ELEMENT_HEIGHT;
+		pTab->AddFixedElementsCoordinates(fixedIdOffset + i, { Rect(top, 0.f, top + SIMULATION_FIXED_ELEMENT_HEIGHT, (float)pageWidth) });
+	}
+
+	// Overflow elements, other nodes may be placed inside of them
+	const int overflowIdOffset = ids["overflowElement"];
+	std::vector<Rect> overflowRects;
+	for (int i = 0; i < rPage.overflowElements; i++)
+	{
+		const int id = overflowIdOffset + i;
+		pTab->AddDOMOverflowElement(browser, id);
+		if (auto spOverflow = pTab->GetDOMOverflowElement(id).lock())
+		{
+			const Rect rect = randomRect(400.f, 300.f);
+			spOverflow->SetRects({ rect });
+			spOverflow->SetMaxScrolling(1000, 0);
+			overflowRects.push_back(rect);
+		}
+	}
+
+	// Assign node to overflow or fixed element by chance, like nodes in real pages are nested
+	auto nest = [&](DOMNode* pNode, std::vector<Rect> rects)
+	{
+		if (!overflowRects.empty() && chance(generator) < SIMULATION_NESTED_NODE_RATIO)
+		{
+			const int overflowIndex = std::uniform_int_distribution<int>(0, (int)overflowRects.size() - 1)(generator);
+			const Rect& rOverflow = overflowRects.at(overflowIndex);
+			for (Rect& rRect : rects) // move into overflow element
+			{
+				const float height = rRect.Height();
+				const float width = std::min(rRect.Width(), rOverflow.Width());
+				rRect = Rect(rOverflow.top, rOverflow.left, rOverflow.top + height, rOverflow.left + width);
+			}
+			pNode->SetOverflowId(overflowIdOffset + overflowIndex);
+		}
+		else if (rPage.fixedElements > 0 && chance(generator) < SIMULATION_NESTED_NODE_RATIO)
+		{
+			const int fixedIndex = std::uniform_int_distribution<int>(0, rPage.fixedElements - 1)(generator);
+			const float top = (float)fixedIndex * SIMULATION_FIXED_ELEMENT_HEIGHT;
+			for (Rect& rRect : rects) // move into fixed element
+			{
+				rRect = Rect(top, rRect.left, top + std::min(rRect.Height(), SIMULATION_FIXED_ELEMENT_HEIGHT), rRect.right);
+			}
+			pNode->SetFixedId(fixedIdOffset + fixedIndex);
+		}
+		pNode->SetRects(rects);
+	};
+
+	// Links, some of them spanning two lines
+	const int linkIdOffset = ids["link"];
+	for (int i = 0; i < rPage.links; i++)
+	{
+		const int id = linkIdOffset + i;
+		pTab->AddDOMLink(browser, id);
+		if (auto spLink = pTab->GetDOMLink(id).lock())
+		{
+			std::vector<Rect> rects = { randomRect(50.f + chance(generator) * 250.f, 20.f) };
+			if (chance(generator) < 0.1f)
+			{
+				const Rect& rFirst = rects.front();
+				rects.push_back(Rect(rFirst.bottom, std::max(0.f, rFirst.left - 100.f), rFirst.bottom + 20.f, rFirst.left));
+			}
+			spLink->SetText("Link " + std::to_string(id));
+			spLink->SetUrl("sim://link/" + std::to_string(id));
+			nest(spLink.get(), rects);
+		}
+	}
+
+	// Text inputs
+	const int textInputIdOffset = ids["textInput"];
+	for (int i = 0; i < rPage.textInputs; i++)
+	{
+		const int id = textInputIdOffset + i;
+		pTab->AddDOMTextInput(browser, id);
+		if (auto spInput = pTab->GetDOMTextInput(id).lock())
+		{
+			spInput->SetPassword(chance(generator) < 0.1f);
+			nest(spInput.get(), { randomRect(300.f, 30.f) });
+		}
+	}
+
+	// Select fields
+	const int selectFieldIdOffset = ids["selectField"];
+	for (int i = 0; i < rPage.selectFields; i++)
+	{
+		const int id = selectFieldIdOffset + i;
+		pTab->AddDOMSelectField(browser, id);
+		if (auto spSelect = pTab->GetDOMSelectField(id).lock())
+		{
+			std::vector<std::string> options;
+			const int optionCount = 2 + (int)(chance(generator) * 20);
+			for (int j = 0; j < optionCount; j++) { options.push_back("Option " + std::to_string(j)); }
+			spSelect->SetOptions(options);
+			nest(spSelect.get(), { randomRect(200.f, 30.f) });
+		}
+	}
+
+	// Checkboxes
+	const int checkboxIdOffset = ids["checkbox"];
+	for (int i = 0; i < rPage.checkboxes; i++)
+	{
+		const int id = checkboxIdOffset + i;
+		pTab->AddDOMCheckbox(browser, id);
+		if (auto spCheckbox = pTab->GetDOMCheckbox(id).lock())
+		{
+			spCheckbox->SetCheckedState(chance(generator) < 0.5f);
+			nest(spCheckbox.get(), { randomRect(20.f, 20.f) });
+		}
+	}
+}
+
+void Simulation::Paint(TabCEFInterface* pTab, const Browser& rBrowser)
+{
+	auto spTexture = pTab->GetWebViewTexture().lock();
+	if (!spTexture) { return; }
+	int width = 0, height = 0;
+	pTab->GetWebRenderResolution(width, height);
+	const float scale = pTab->GetWebRenderScale(); // applied like device scale factor by CEF
+	width = (int)std::round(width * scale);
+	height = (int)std::round(height * scale);
+	if (width <= 0 || height <= 0) { return; }
+	const auto start = std::chrono::steady_clock::now();
+
+	// Stripes which move with scrolling, so every paint uploads changed content
+	_paintBuffer.resize((size_t)width * height * 4);
+	uint32_t* pPixels = reinterpret_cast<uint32_t*>(_paintBuffer.data());
+	for (int y = 0; y < height; y++)
+	{
+		const int stripe = (int)(rBrowser.scrollY + y / scale) / 32;
+		const uint32_t color = stripe % 2 == 0 ? 0xFFF0F0F0 : 0xFFD0D8E0; // BGRA in memory
+		std::fill(pPixels + (size_t)y * width, pPixels + (size_t)(y + 1) * width, color);
+	}
+	const auto upload = std::chrono::steady_clock::now();
+	spTexture->Fill(width, height, GL_BGRA, _paintBuffer.data());
+	const auto end = std::chrono::steady_clock::now();
+	pTab->ReportPaint(
+		width,
+		height,
+		std::chrono::duration<double, std::milli>(end - start).count(),
+		std::chrono::duration<double, std::milli>(end - upload).count());
+}
+
+void Simulation::SetScrolling(TabCEFInterface* pTab, Browser& rBrowser, double x, double y) const
+{
+	int renderWidth = 0, renderHeight = 0;
+	pTab->GetWebRenderResolution(renderWidth, renderHeight);
+	rBrowser.scrollX = std::max(0.0, std::min(x, rBrowser.pageWidth - renderWidth));
+	rBrowser.scrollY = std::max(0.0, std::min(y, rBrowser.pageHeight - renderHeight));
+	rBrowser.paintRemaining = 0;
+	pTab->SetScrollingOffset(rBrowser.scrollX, rBrowser.scrollY);
+}
+
+void Simulation::UpdateGaze(float tpf)
+{
+	if (!_gazeTrace.empty())
+	{
+		// Latest sample of trace, which is held when trace is over
+		while (_nextGazeSample + 1 < _gazeTrace.size() && _gazeTrace.at(_nextGazeSample + 1).time <= _time)
+		{
+			++_nextGazeSample;
+		}
+		_gazeX = _gazeTrace.at(_nextGazeSample).x;
+		_gazeY = _gazeTrace.at(_nextGazeSample).y;
+
+		// Fixation lasts while gaze stays close to its start
+		if (std::hypot(_gazeX - _gazeFixationX, _gazeY - _gazeFixationY) > SIMULATION_FIXATION_RADIUS)
+		{
+			_gazeFixationX = _gazeX;
+			_gazeFixationY = _gazeY;
+			_gazeFixationDuration = 0;
+		}
+		else
+		{
+			_gazeFixationDuration += tpf;
+		}
+	}
+	else
+	{
+		// Jump to next fixation at random position, seeded by index so positions do not depend on frame rate
+		const int index = _fixationDuration > 0 ? (int)(_time / _fixationDuration) : 0;
+		if (index != _fixationIndex)
+		{
+			_fixationIndex = index;
+			std::mt19937 generator(_gazeSeed + index);
+			std::uniform_real_distribution<float> position(0.05f, 0.95f);
+			_gazeX = position(generator);
+			_gazeY = position(generator);
+			_gazeFixationDuration = 0;
+		}
+		else
+		{
+			_gazeFixationDuration += tpf;
+		}
+	}
+}
@@ -0,0 +1,176 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Simulation of web pages and gaze to measure the browser without CEF. When
+// set, Mediator routes page loading and scrolling of Tabs to the simulation,
+// which feeds synthetic DOM nodes into the Tabs and paints their web views.
+// Gaze is replayed from a trace or generated as fixations. Master runs the
+// simulation in a hidden window with the latency trace enabled and writes a
+// summary of frame times per phase when the scenario is over.
+//
+// Scenario is a JSON file like:
+// {
+//   "duration": 60, // seconds
+//   "report": "report.json", // optional, defaults to log directory
+//   "pages": {
+//     "sim://links": { "title": "Links", "height": 40000, "seed": 1,
+//       "links": 5000, "textInputs": 50, "selectFields": 10,
+//       "overflowElements": 200, "checkboxes": 20, "fixedElements": 2,
+//       "loadDuration": 0.5, "paintRate": 30,
+//       "nodes": [ { "type": "link", "rects": [[top, left, bottom, right]], "url": "sim://other" } ] }
+//   },
+//   "gaze": { "trace": "gaze.csv" } or { "fixations": 0.4, "seed": 1 },
+//   "events": [
+//     { "time": 1, "load": "sim://links" },
+//     { "time": 5, "scroll": 2000 },
+//     { "time": 8, "pipeline": "zoom_click" },
+//     { "time": 9, "interaction": true } ]
+// }
+// Gaze traces are CSV with timestamp in milliseconds, x and y in pixels of the
+// window, as used by the filter replay. URLs not listed as page stay empty.
+
+#ifndef SIMULATION_H_
+#define SIMULATION_H_
+
+#include "src/Input/Input.h"
+#include "submodules/json/src/json.hpp"
+#include <string>
+#include <vector>
+#include <map>
+
+// Forward declaration
+class TabCEFInterface;
+
+class Simulation
+{
+public:
+
+	// Constructor, loads scenario. Scenario which cannot be loaded finishes immediately
+	Simulation(std::string scenarioFilepath);
+
+	// Called by Mediator instead of creating and controlling browsers
+	void RegisterTab(TabCEFInterface* pTab, std::string URL);
+	void UnregisterTab(TabCEFInterface* pTab);
+	void LoadURL(TabCEFInterface* pTab, std::string URL);
+	void ReloadTab(TabCEFInterface* pTab);
+	void SetActiveTab(TabCEFInterface* pTab);
+	void Scroll(TabCEFInterface* pTab, double deltaX, double deltaY); // deltas of mouse wheel
+	void ResetScrolling(TabCEFInterface* pTab);
+	void ScrollTo(TabCEFInterface* pTab, double x, double y);
+
+	// Update simulation, called once per frame by Master in place of message loop of CEF
+	void Update(float tpf);
+
+	// Override input of eye tracker with simulated gaze
+	void ApplyInput(Input& rInput, int windowWidth, int windowHeight) const;
+
+	// Whether scenario is over
+	bool IsFinished() const { return _time >= _duration; }
+
+	// Filepath of report with frame times
+	std::string GetReportFilepath() const { return _reportFilepath; }
+
+private:
+
+	// Synthetic page
+	struct Page
+	{
+		std::string title;
+		double width = 0; // zero for width of web view
+		double height = 0; // zero for height of web view
+		unsigned int seed = 0;
+		int links = 0;
+		int textInputs = 0;
+		int selectFields = 0;
+		int overflowElements = 0;
+		int checkboxes = 0;
+		int fixedElements = 0;
+		float loadDuration = 0.5f; // seconds until nodes are available
+		float paintRate = 30.f; // paints per second while displayed
+		nlohmann::json nodes; // explicitly given nodes, e.g. recorded from a real page
+	};
+
+	// Event of timeline
+	struct Event
+	{
+		enum class Type { LOAD, SCROLL, PIPELINE, INTERACTION };
+		float time = 0; // seconds
+		Type type = Type::LOAD;
+		std::string value;
+		double offset = 0;
+	};
+
+	// Sample of gaze
+	struct GazeSample
+	{
+		float time; // seconds
+		float x;
+		float y;
+	};
+
+	// State of simulated browser of a Tab
+	struct Browser
+	{
+		std::string URL;
+		std::string pendingURL; // load is started at next update, as callbacks of CEF arrive asynchronously
+		bool loading = false;
+		float loadRemaining = 0;
+		float paintRemaining = 0;
+		double pageWidth = 0;
+		double pageHeight = 0;
+		double scrollX = 0;
+		double scrollY = 0;
+	};
+
+	// Load scenario from file, returns whether successful
+	bool Load(std::string scenarioFilepath);
+
+	// Load gaze trace from CSV file, returns whether successful
+	bool LoadGazeTrace(std::string filepath);
+
+	// Start and finish loading of page in Tab
+	void StartLoading(TabCEFInterface* pTab, Browser& rBrowser);
+	void FinishLoading(TabCEFInterface* pTab, Browser& rBrowser);
+
+	// Feed nodes of page into Tab
+	void FeedNodes(TabCEFInterface* pTab, const Page& rPage, double pageWidth, double pageHeight) const;
+
+	// Paint web view of Tab
+	void Paint(TabCEFInterface* pTab, const Browser& rBrowser);
+
+	// Set scrolling of Tab, clamped to page
+	void SetScrolling(TabCEFInterface* pTab, Browser& rBrowser, double x, double y) const;
+
+	// Update simulated gaze
+	void UpdateGaze(float tpf);
+
+	// Scenario
+	float _duration = 0;
+	std::string _reportFilepath;
+	std::map<std::string, Page> _pages;
+	std::vector<Event> _events; // sorted by time
+	std::vector<GazeSample> _gazeTrace; // pixels, empty when fixations are generated
+	float _fixationDuration = 0.4f; // seconds of generated fixations
+	unsigned int _gazeSeed = 0;
+
+	// Progress
+	float _time = 0;
+	unsigned int _nextEvent = 0;
+	unsigned int _nextGazeSample = 0;
+	std::map<TabCEFInterface*, Browser> _browsers;
+	TabCEFInterface* _pActiveTab = nullptr;
+	std::vector<unsigned char> _paintBuffer;
+
+	// Gaze
+	float _gazeX = 0.5f;
+	float _gazeY = 0.5f;
+	bool _gazeRelative = true; // generated gaze is relative to window
+	float _gazeFixationX = 0; // start of fixation in trace
+	float _gazeFixationY = 0;
+	float _gazeFixationDuration = 0;
+	int _fixationIndex = -1; // index of generated fixation
+	bool _interaction = false; // instant interaction in current frame
+};
+
+#endif // SIMULATION_H_
@@ -0,0 +1,66 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "StartupPreload.h"
+#include "src/Global.h"
+#include "src/Utils/StartupProfiler.h"
+
+StartupPreload::StartupPreload(std::string userDirectory)
+{
+	// Bookmarks
+	_bookmarkManager = std::async(std::launch::async, [userDirectory]()
+	{
+		StartupStep step("Load bookmarks");
+		return std::unique_ptr<BookmarkManager>(new BookmarkManager(userDirectory));
+	});
+
+	// History
+	_historyManager = std::async(std::launch::async, [userDirectory]()
+	{
+		StartupStep step("Load history");
+		return std::unique_ptr<HistoryManager>(new HistoryManager(userDirectory));
+	});
+
+	// Favicons
+	_faviconCache = std::async(std::launch::async, [userDirectory]()
+	{
+		StartupStep step("Load favicon cache");
+		return std::unique_ptr<FaviconCache>(new FaviconCache(userDirectory));
+	});
+
+	// Settings, only parsed as applying them requires the GUI
+	_settingsDocument = std::async(std::launch::async, [userDirectory]()
+	{
+		StartupStep step("Parse settings");
+		std::unique_ptr<tinyxml2::XMLDocument> upDocument(new tinyxml2::XMLDocument());
+		upDocument->LoadFile((userDirectory + SETTINGS_FILE).c_str());
+		return upDocument;
+	});
+}
+
+StartupPreload::~StartupPreload()
+{
+	// Futures of std::async wait for their work at destruction
+}
+
+std::unique_ptr<BookmarkManager> StartupPreload::TakeBookmarkManager()
+{
+	return _bookmarkManager.get();
+}
+
+std::unique_ptr<HistoryManager> StartupPreload::TakeHistoryManager()
+{
+	return _historyManager.get();
+}
+
+std::unique_ptr<FaviconCache> StartupPreload::TakeFaviconCache()
+{
+	return _faviconCache.get();
+}
+
+std::unique_ptr<tinyxml2::XMLDocument> StartupPreload::TakeSettingsDocument()
+{
+	return _settingsDocument.get();
+}
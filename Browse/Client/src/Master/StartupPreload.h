@@ -0,0 +1,45 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Work of startup which neither depends on CEF nor on OpenGL. It is started
+// before CEF is initialized and runs on worker threads meanwhile. States take
+// the results at their construction, waiting only for work not done, yet.
+
+#ifndef STARTUPPRELOAD_H_
+#define STARTUPPRELOAD_H_
+
+#include "src/State/Web/Managers/BookmarkManager.h"
+#include "src/State/Web/Managers/HistoryManager.h"
+#include "src/State/Web/Managers/FaviconCache.h"
+#include "submodules/eyeGUI/externals/TinyXML2/tinyxml2.h"
+#include <future>
+#include <memory>
+#include <string>
+
+class StartupPreload
+{
+public:
+
+	// Constructor, starts work on worker threads
+	StartupPreload(std::string userDirectory);
+
+	// Destructor, waits for work which has not been taken
+	virtual ~StartupPreload();
+
+	// Take results. Each may be called only once, blocks until work is done
+	std::unique_ptr<BookmarkManager> TakeBookmarkManager();
+	std::unique_ptr<HistoryManager> TakeHistoryManager();
+	std::unique_ptr<FaviconCache> TakeFaviconCache();
+	std::unique_ptr<tinyxml2::XMLDocument> TakeSettingsDocument(); // check for error before usage
+
+private:
+
+	// Futures of work
+	std::future<std::unique_ptr<BookmarkManager> > _bookmarkManager;
+	std::future<std::unique_ptr<HistoryManager> > _historyManager;
+	std::future<std::unique_ptr<FaviconCache> > _faviconCache;
+	std::future<std::unique_ptr<tinyxml2::XMLDocument> > _settingsDocument;
+};
+
+#endif // STARTUPPRELOAD_H_
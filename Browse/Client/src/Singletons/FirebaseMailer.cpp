@@ -96,9 +96,7 @@ bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string pas
 	// If success, retrieve start index
 	if (success)
 	{
-		std::promise<int> promise; auto future = promise.get_future(); // future provides index
-		Transform(FirebaseIntegerKey::GENERAL_APPLICATION_START_COUNT, 1, &promise); // adds one to the count
-		int index = future.get() - 1;
+		int index = Transform(FirebaseIntegerKey::GENERAL_APPLICATION_START_COUNT, 1) - 1; // adds one to the count
 		nlohmann::json record = {
 			{ "date", GetDate() }, // add date
 			{ "timestamp", GetTimestamp() }, // add timestamp
@@ -109,7 +107,7 @@ bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string pas
 	}
 
 	// Fullfill the promise
-	pPromise->set_value(_pIdToken->Get());
+	if (pPromise != nullptr) { pPromise->set_value(_pIdToken->Get()); }
 
 	// Return the success
 	return success;
@@ -117,6 +115,12 @@ bool FirebaseMailer::FirebaseInterface::Login(std::string email, std::string pas
 
 template<typename T>
 void FirebaseMailer::FirebaseInterface::Put(T key, typename FirebaseValue<T>::type value, std::string subpath)
+{
+	PutSerialized(key, json(value).dump(), subpath);
+}
+
+template<typename T>
+void FirebaseMailer::FirebaseInterface::PutSerialized(T key, const std::string& rValue, std::string subpath)
 {
 	// Only continue if logged in
 	bool success = false;
@@ -149,11 +153,8 @@ void FirebaseMailer::FirebaseInterface::Put(T key, typename FirebaseValue<T>::ty
 			curl_easy_setopt(curl, CURLOPT_HEADERDATA, &answerHeaderBuffer); // set buffer for answer header
 			curl_easy_setopt(curl, CURLOPT_WRITEDATA, &answerBodyBuffer); // set buffer for answer body
 
-			// Post field
-			const std::string postField = json(value).dump();
-
 			// Fill request
-			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, postField.c_str()); // value to put
+			curl_easy_setopt(curl, CURLOPT_POSTFIELDS, rValue.c_str()); // value to put
 			curl_easy_setopt(curl, CURLOPT_URL, requestURL.c_str()); // set address of request
 
 			 // Perform the request
@@ -220,18 +221,20 @@ void FirebaseMailer::FirebaseInterface::Get(T key, std::promise<typename Firebas
 	}
 }
 
-void FirebaseMailer::FirebaseInterface::Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise)
+int FirebaseMailer::FirebaseInterface::Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise)
 {
 	// Just add the delta to the existing value
 	auto result = Apply(key, [delta](int DBvalue) { return DBvalue + delta; });
 	if (pPromise != nullptr) { pPromise->set_value(result); }
+	return result;
 }
 
-void FirebaseMailer::FirebaseInterface::Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise)
+int FirebaseMailer::FirebaseInterface::Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise)
 {
 	// Use maximum of database value and this
 	auto result = Apply(key, [value](int DBvalue) { return glm::max(DBvalue, value); });
 	if (pPromise != nullptr) { pPromise->set_value(result); }
+	return result;
 }
 
 bool FirebaseMailer::FirebaseInterface::Login()
@@ -691,15 +694,23 @@ FirebaseMailer::FirebaseMailer()
 			}
 		}
 
-		// Collect last commands before shutdown
-		std::unique_lock<std::mutex> lock(*pMutex);
-		localCommandQueue = std::move(*pCommandQueue); // move content of command queue to local one
-		pCommandQueue->clear(); // clear original queue
-
-		// Work on these last commands
-		for (const auto& rCommand : localCommandQueue)
+		// Work on last commands before shutdown. Continuations may push back further commands,
+		// so lock must not be held while working on them and queue is drained until it stays empty
+		while (true)
 		{
-			(*rCommand.get())(interface);
+			{
+				std::lock_guard<std::mutex> lock(*pMutex);
+				localCommandQueue = std::move(*pCommandQueue); // move content of command queue to local one
+				pCommandQueue->clear(); // clear original queue
+			}
+			if (localCommandQueue.empty())
+			{
+				break;
+			}
+			for (const auto& rCommand : localCommandQueue)
+			{
+				(*rCommand.get())(interface);
+			}
 		}
 	}));
 }
@@ -731,6 +742,36 @@ bool FirebaseMailer::PushBack_Maximum(FirebaseIntegerKey key, int value, std::pr
 	})));
 }
 
+bool FirebaseMailer::PushBack_Login(std::string email, std::string password, std::function<void(bool)> continuation)
+{
+	// Add command to queue, continuation is executed right after login
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		bool success = rInterface.Login(email, password);
+		continuation(success);
+	})));
+}
+
+bool FirebaseMailer::PushBack_Transform(FirebaseIntegerKey key, int delta, std::function<void(int)> continuation)
+{
+	// Add command to queue, continuation is executed right after transformation
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		int value = rInterface.Transform(key, delta);
+		continuation(value);
+	})));
+}
+
+bool FirebaseMailer::PushBack_Maximum(FirebaseIntegerKey key, int value, std::function<void(int)> continuation)
+{
+	// Add command to queue, continuation is executed right after maximum is determined
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		int result = rInterface.Maximum(key, value);
+		continuation(result);
+	})));
+}
+
 bool FirebaseMailer::PushBack_Put(FirebaseIntegerKey key, int value, std::string subpath)
 {
 	// Add command to queue, take parameters as copy
@@ -758,6 +799,17 @@ bool FirebaseMailer::PushBack_Put(FirebaseJSONKey key, json value, std::string s
 	})));
 }
 
+bool FirebaseMailer::PushBack_PutSerialized(FirebaseJSONKey key, std::function<void(std::ostream&)> serializer, std::string subpath)
+{
+	// Add command to queue, serialization happens when command is executed
+	return PushBackCommand(std::shared_ptr<Command>(new Command([=](FirebaseInterface& rInterface)
+	{
+		std::ostringstream stream;
+		serializer(stream);
+		rInterface.PutSerialized(key, stream.str(), subpath);
+	})));
+}
+
 bool FirebaseMailer::PushBack_Get(FirebaseIntegerKey key, std::promise<int>* pPromise)
 {
 	// Add command to queue, take parameters as copy
@@ -789,9 +841,19 @@ bool FirebaseMailer::PushBackCommand(std::shared_ptr<Command> spCommand)
 {
 	if (setup::FIREBASE_MAILING && !_paused) // only push back the command if logging activated and not paused
 	{
-		std::lock_guard<std::mutex> lock(_commandMutex);
-		_commandQueue.push_back(spCommand); // push back command to queue
-		_conditionVariable.notify_all(); // notify thread about new data
+		const auto start = std::chrono::steady_clock::now();
+		{
+			std::lock_guard<std::mutex> lock(_commandMutex);
+			_commandQueue.push_back(spCommand); // push back command to queue
+			_conditionVariable.notify_all(); // notify thread about new data
+		}
+
+		// Measure how long caller has been stalled
+		const long long stall = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+		_stallMicroseconds += stall;
+		long long maxStall = _maxStallMicroseconds.load();
+		while (stall > maxStall && !_maxStallMicroseconds.compare_exchange_weak(maxStall, stall)) {}
+		_pushedBackCount++;
 		return true;
 	}
 	else
@@ -809,4 +871,13 @@ std::string FirebaseMailer::GetIdToken() const
 int FirebaseMailer::GetStartIndex() const
 {
 	return _startIndex;
+}
+
+void FirebaseMailer::LogStallStatistics() const
+{
+	if (_pushedBackCount > 0)
+	{
+		LogInfo("FirebaseMailer: Callers were stalled ", _stallMicroseconds.load() / 1000.0, "ms in total (max. ", _maxStallMicroseconds.load() / 1000.0,
+			"ms) by pushing back ", _pushedBackCount.load(), " commands.");
+	}
 }
\ No newline at end of file
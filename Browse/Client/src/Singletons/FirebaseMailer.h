@@ -4,7 +4,9 @@
 //============================================================================
 // Singleton which receives and sends data to Firebase. The mailer manages
 // the command queue and the interface the connection to the Firebase.
-// Mailer access is threadsafe.
+// Mailer access is threadsafe. Commands which depend on the result of another
+// one are pushed back by a continuation, which is executed on the thread of
+// the mailer, so no caller has to wait for Firebase.
 
 #ifndef FIREBASEMAILER_H_
 #define FIREBASEMAILER_H_
@@ -17,6 +19,9 @@
 #include <mutex>
 #include <condition_variable>
 #include <future>
+#include <functional>
+#include <atomic>
+#include <ostream>
 
 // Available database keys
 enum class FirebaseIntegerKey	{ 
@@ -296,6 +301,7 @@ public:
 		_shouldStop = true;
 		_conditionVariable.notify_all();
 		_upThread->join();
+		LogStallStatistics();
 	} // tell thread to stop
 
 	// Continue mailer
@@ -311,10 +317,16 @@ public:
 	bool PushBack_Put		(FirebaseIntegerKey key, int value, std::string subpath = "");
 	bool PushBack_Put		(FirebaseStringKey key, std::string value, std::string subpath = "");
 	bool PushBack_Put		(FirebaseJSONKey key, nlohmann::json value, std::string subpath = "");
+	bool PushBack_PutSerialized(FirebaseJSONKey key, std::function<void(std::ostream&)> serializer, std::string subpath = ""); // serializer writes JSON on thread of mailer, so large values are not converted by caller
 	bool PushBack_Get		(FirebaseIntegerKey key, std::promise<int>* pPromise);
 	bool PushBack_Get		(FirebaseStringKey key, std::promise<std::string>* pPromise);
 	bool PushBack_Get		(FirebaseJSONKey key, std::promise<nlohmann::json>* pPromise);
 
+	// Commands with continuation, which is executed on thread of mailer with result of command. Continuation may push back further commands
+	bool PushBack_Login		(std::string email, std::string password, std::function<void(bool)> continuation); // continuation receives whether login was successful
+	bool PushBack_Transform	(FirebaseIntegerKey key, int delta, std::function<void(int)> continuation); // continuation receives future database value
+	bool PushBack_Maximum	(FirebaseIntegerKey key, int value, std::function<void(int)> continuation); // continuation receives future database value
+
 	// Get id token (is empty before login or at failure)
 	std::string GetIdToken() const;
 
@@ -335,21 +347,25 @@ private:
 		FirebaseInterface(IdToken* pIdToken, std::atomic<int>* pStartIndex) : _pIdToken(pIdToken), _pStartIndex(pStartIndex) {}
 
 		// Log in. Return whether successful
-		bool Login(std::string email, std::string password, std::promise<std::string>* pPromise);
+		bool Login(std::string email, std::string password, std::promise<std::string>* pPromise = nullptr); // if nullptr, no future is set
 
 		// Simple put functionality. Replaces existing value if available, no ETag used
 		template<typename T>
 		void Put(T key, typename FirebaseValue<T>::type value, std::string subpath = ""); // delegates private put
 
+		// Put value which is already serialized as JSON. Replaces existing value if available, no ETag used
+		template<typename T>
+		void PutSerialized(T key, const std::string& rValue, std::string subpath = "");
+
 		// Get
 		template<typename T>
 		void Get(T key, std::promise<typename FirebaseValue<T>::type>* pPromise); // delegates private get
 
-		// Transform value
-		void Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
+		// Transform value. Returns final value in database
+		int Transform(FirebaseIntegerKey key, int delta, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
 
-		// Save maximum in database, either my value or the one in the database
-		void Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
+		// Save maximum in database, either my value or the one in the database. Returns final value in database
+		int Maximum(FirebaseIntegerKey key, int value, std::promise<int>* pPromise = nullptr); // if nullptr, no future is set
 
 	private:
 
@@ -398,6 +414,9 @@ private:
 	// Method that actually pushes back command (considers whether paused etc.)
 	bool PushBackCommand(std::shared_ptr<Command> spCommand);
 
+	// Log how long callers have been stalled by pushing back commands
+	void LogStallStatistics() const;
+
 	// Private copy / assignment constructors
 	FirebaseMailer(); // threadsafe as only called by Instance()
 	FirebaseMailer(const FirebaseMailer&) {}
@@ -409,6 +428,11 @@ private:
 	// Start index of application run
 	std::atomic<int> _startIndex = -1;
 
+	// Time callers spent in pushing back commands, e.g., waiting for the lock of the queue
+	std::atomic<long long> _stallMicroseconds { 0 };
+	std::atomic<long long> _maxStallMicroseconds { 0 };
+	std::atomic<int> _pushedBackCount { 0 };
+
 	// #### THREAD-RELATED MEMBERS ####
 
 	// Id token may be readable from outside, but only set within FirebaseInterface thread
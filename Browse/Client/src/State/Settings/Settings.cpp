@@ -5,6 +5,7 @@
 
 #include "Settings.h"
 #include "src/Master/Master.h"
+#include "src/Master/StartupPreload.h"
 #include "src/Global.h"
 #include "src/Utils/Logger.h"
 #include "submodules/eyeGUI/externals/TinyXML2/tinyxml2.h"
@@ -12,14 +13,14 @@
 // Include singleton for mailing to JavaScript
 #include "src/Singletons/JSMailer.h"
 
-Settings::Settings(Master* pMaster) : State(pMaster)
+Settings::Settings(Master* pMaster, StartupPreload& rPreload) : State(pMaster)
 {
 	// Initialize members
 	_fullpathSettings = pMaster->GetUserDirectory() + SETTINGS_FILE;
 
-	// Load settings and apply them
+	// Load settings, parsed while CEF was initialized, and apply them
 	bool saveSettings = false;
-	if (!LoadSettings())
+	if (!LoadSettings(*rPreload.TakeSettingsDocument().get()))
 	{
 		LogInfo("Settings: No settings file found or parsing error");
 		saveSettings = true;
@@ -194,18 +195,14 @@ void Settings::ApplySettings(bool save)
 	}
 }
 
-// Load settings from hard disk. Returns whether successful
-bool Settings::LoadSettings()
+// Load settings from parsed file. Returns whether successful
+bool Settings::LoadSettings(tinyxml2::XMLDocument& rDocument)
 {
-	// Open document
-	tinyxml2::XMLDocument doc;
-	tinyxml2::XMLError result = doc.LoadFile(_fullpathSettings.c_str());
-
-	// Check result of opening 
-	if (result != tinyxml2::XMLError::XML_SUCCESS) { return false; }
+	// Check result of opening
+	if (rDocument.Error()) { return false; }
 
 	// Fetch root
-	tinyxml2::XMLNode* pRoot = doc.FirstChild();
+	tinyxml2::XMLNode* pRoot = rDocument.FirstChild();
 	if (pRoot == NULL) { return false; }
 
 	// Fetch global
@@ -10,12 +10,16 @@
 #include "src/State/State.h"
 #include "plugins/Eyetracker/Interface/EyetrackerGeometry.h"
 
+// Forward declaration
+class StartupPreload;
+namespace tinyxml2 { class XMLDocument; }
+
 class Settings : public State
 {
 public:
 
-    // Constructor
-    Settings(Master* pMaster);
+    // Constructor, takes parsed settings file from preload
+    Settings(Master* pMaster, StartupPreload& rPreload);
 
     // Destructor
     virtual ~Settings();
@@ -62,8 +66,8 @@ private:
 	// Save settings to hard disk. Returns whether successful
 	bool SaveSettings() const;
 
-	// Load settings from hard disk. Returns whether successful
-	bool LoadSettings();
+	// Load settings from parsed file. Returns whether successful
+	bool LoadSettings(tinyxml2::XMLDocument& rDocument);
 
     // Give listener full access
     friend class SettingsButtonListener;
@@ -0,0 +1,184 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "FaviconCache.h"
+#include "src/Global.h"
+#include "src/Setup.h"
+#include "src/Utils/Logger.h"
+#include <fstream>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+
+namespace
+{
+	// Header of cache file
+	const char CACHE_MAGIC[4] = { 'G', 'T', 'W', 'F' };
+	const uint32_t CACHE_VERSION = 1;
+
+	// Limit of favicon edge, protects against corrupted files
+	const int CACHE_MAX_EDGE = 1024;
+
+	// Seconds since epoch
+	int64_t Now()
+	{
+		return std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	// Binary helpers
+	template<typename T>
+	void Write(std::ofstream& rStream, const T& rValue)
+	{
+		rStream.write(reinterpret_cast<const char*>(&rValue), sizeof(T));
+	}
+
+	template<typename T>
+	bool Read(std::ifstream& rStream, T& rValue)
+	{
+		rStream.read(reinterpret_cast<char*>(&rValue), sizeof(T));
+		return (bool)rStream;
+	}
+}
+
+FaviconCache::FaviconCache(std::string userDirectory)
+{
+	// Fill members
+	_fullpathCache = userDirectory + FAVICON_CACHE_FILE;
+
+	// Load existing cache
+	if (!LoadCache()) { LogInfo("FaviconCache: No cache file found or parsing error"); }
+}
+
+FaviconCache::~FaviconCache()
+{
+	// Save cache if something has been stored
+	if (_changed && !SaveCache()) { LogError("FaviconCache: Failed to save cache"); }
+}
+
+bool FaviconCache::Lookup(std::string domain, Favicon& rFavicon)
+{
+	auto iter = _domains.find(domain);
+	if (iter == _domains.end()) { return false; }
+
+	// Move entry to front, as it has been used most recently
+	_entries.splice(_entries.begin(), _entries, iter->second);
+
+	// Copy favicon and decide whether it is fresh enough
+	const Entry& rEntry = *iter->second;
+	rFavicon = rEntry.favicon;
+	rFavicon.fresh = (Now() - rEntry.storedTime) < setup::FAVICON_CACHE_MAX_AGE;
+	return true;
+}
+
+void FaviconCache::Store(std::string domain, int width, int height, const std::vector<unsigned char>& rData, glm::vec4 accentColor)
+{
+	// Only store consistent favicons
+	if (domain.empty() || width <= 0 || height <= 0 || rData.size() != (size_t)(width * height * 4)) { return; }
+
+	// Fill entry
+	Entry entry;
+	entry.domain = domain;
+	entry.storedTime = Now();
+	entry.favicon.width = width;
+	entry.favicon.height = height;
+	entry.favicon.data = rData;
+	entry.favicon.accentColor = accentColor;
+
+	// Insert it
+	Insert(std::move(entry));
+	_changed = true;
+}
+
+void FaviconCache::Insert(Entry entry)
+{
+	// Remove existing entry of domain
+	auto iter = _domains.find(entry.domain);
+	if (iter != _domains.end())
+	{
+		_size -= iter->second->favicon.data.size();
+		_entries.erase(iter->second);
+		_domains.erase(iter);
+	}
+
+	// Insert as most recently used
+	_size += entry.favicon.data.size();
+	_entries.push_front(std::move(entry));
+	_domains[_entries.front().domain] = _entries.begin();
+
+	// Evict least recently used entries until cache fits, but keep the one just inserted
+	while (_size > setup::FAVICON_CACHE_MAX_SIZE && _entries.size() > 1)
+	{
+		const Entry& rLast = _entries.back();
+		_size -= rLast.favicon.data.size();
+		_domains.erase(rLast.domain);
+		_entries.pop_back();
+	}
+}
+
+bool FaviconCache::SaveCache() const
+{
+	std::ofstream stream(_fullpathCache, std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!stream.is_open()) { return false; }
+
+	// Header
+	stream.write(CACHE_MAGIC, sizeof(CACHE_MAGIC));
+	Write(stream, CACHE_VERSION);
+	Write(stream, (uint32_t)_entries.size());
+
+	// Entries, most recently used first
+	for (const Entry& rEntry : _entries)
+	{
+		Write(stream, (uint32_t)rEntry.domain.size());
+		stream.write(rEntry.domain.data(), rEntry.domain.size());
+		Write(stream, rEntry.storedTime);
+		Write(stream, (int32_t)rEntry.favicon.width);
+		Write(stream, (int32_t)rEntry.favicon.height);
+		for (int i = 0; i < 4; i++) { Write(stream, rEntry.favicon.accentColor[i]); }
+		stream.write(reinterpret_cast<const char*>(rEntry.favicon.data.data()), rEntry.favicon.data.size());
+	}
+	return (bool)stream;
+}
+
+bool FaviconCache::LoadCache()
+{
+	std::ifstream stream(_fullpathCache, std::ios::in | std::ios::binary);
+	if (!stream.is_open()) { return false; }
+
+	// Header
+	char magic[4];
+	uint32_t version = 0;
+	uint32_t count = 0;
+	stream.read(magic, sizeof(magic));
+	if (!stream || !std::equal(magic, magic + 4, CACHE_MAGIC)) { return false; }
+	if (!Read(stream, version) || version != CACHE_VERSION) { return false; }
+	if (!Read(stream, count)) { return false; }
+
+	// Entries are stored most recently used first, so append them in order
+	for (uint32_t i = 0; i < count; i++)
+	{
+		Entry entry;
+		uint32_t domainLength = 0;
+		int32_t width = 0, height = 0;
+		if (!Read(stream, domainLength) || domainLength == 0 || domainLength > 1024) { return false; }
+		entry.domain.resize(domainLength);
+		stream.read(&entry.domain[0], domainLength);
+		if (!Read(stream, entry.storedTime) || !Read(stream, width) || !Read(stream, height)) { return false; }
+		if (width <= 0 || height <= 0 || width > CACHE_MAX_EDGE || height > CACHE_MAX_EDGE) { return false; }
+		for (int j = 0; j < 4; j++) { if (!Read(stream, entry.favicon.accentColor[j])) { return false; } }
+		entry.favicon.width = width;
+		entry.favicon.height = height;
+		entry.favicon.data.resize((size_t)(width * height * 4));
+		stream.read(reinterpret_cast<char*>(entry.favicon.data.data()), entry.favicon.data.size());
+		if (!stream) { return false; }
+
+		// Append, skip domains which appear twice
+		if (_domains.find(entry.domain) != _domains.end()) { continue; }
+		if (_size + entry.favicon.data.size() > setup::FAVICON_CACHE_MAX_SIZE) { _changed = true; break; } // limit may have been lowered
+		_size += entry.favicon.data.size();
+		_entries.push_back(std::move(entry));
+		_domains[_entries.back().domain] = std::prev(_entries.end());
+	}
+	return true;
+}
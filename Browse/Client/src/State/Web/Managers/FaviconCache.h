@@ -0,0 +1,80 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Cache of favicons per domain, which keeps decoded pixels and accent color.
+// Size of pixel data is bounded, least recently used favicons are evicted
+// first. Cache is loaded at construction and saved at destruction.
+
+#ifndef FAVICONCACHE_H_
+#define FAVICONCACHE_H_
+
+#include "src/Utils/glmWrapper.h"
+#include <string>
+#include <vector>
+#include <list>
+#include <map>
+#include <cstdint>
+
+class FaviconCache
+{
+public:
+
+	// Favicon as stored in cache
+	struct Favicon
+	{
+		int width = 0;
+		int height = 0;
+		std::vector<unsigned char> data; // RGBA
+		glm::vec4 accentColor;
+		bool fresh = false; // whether young enough to skip download
+	};
+
+	// Constructor
+	FaviconCache(std::string userDirectory);
+
+	// Destructor
+	virtual ~FaviconCache();
+
+	// Look up favicon of domain and mark it as recently used. Returns whether found
+	bool Lookup(std::string domain, Favicon& rFavicon);
+
+	// Store favicon of domain, replaces existing one
+	void Store(std::string domain, int width, int height, const std::vector<unsigned char>& rData, glm::vec4 accentColor);
+
+private:
+
+	// Entry of cache
+	struct Entry
+	{
+		std::string domain;
+		int64_t storedTime = 0; // seconds since epoch
+		Favicon favicon;
+	};
+
+	// Insert entry as most recently used and evict others if cache is too big
+	void Insert(Entry entry);
+
+	// Save cache to hard disk. Returns whether successful
+	bool SaveCache() const;
+
+	// Load cache from hard disk. Returns whether successful
+	bool LoadCache();
+
+	// Entries, most recently used first
+	std::list<Entry> _entries;
+
+	// Entries by domain
+	std::map<std::string, std::list<Entry>::iterator> _domains;
+
+	// Bytes of pixel data in cache
+	size_t _size = 0;
+
+	// Whether cache has changed since loading
+	bool _changed = false;
+
+	// Fullpath to cache file
+	std::string _fullpathCache;
+};
+
+#endif // FAVICONCACHE_H_
@@ -69,6 +69,7 @@ void Tab::EmulateMouseCursor(double x, double y, bool leftButtonPressed, bool is
 void Tab::EmulateMouseWheelScrolling(double deltaX, double deltaY)
 {
 	_pCefMediator->EmulateMouseWheelScrolling(this, deltaX, deltaY);
+	PredictScrolling(deltaX, deltaY);
 }
 
 void Tab::EmulateLeftMouseButtonDown(double x, double y, bool isWebViewPixelCoordinate, double xOffset, double yOffset)
@@ -175,6 +176,9 @@ std::weak_ptr<CustomTransformationInterface> Tab::GetCustomTransformationInterfa
 
 void Tab::NotifyTextInput(std::string tag, std::string id, int charCount, int charDistance, float x, float y, float duration)
 {
+	// Entered text would be lost by discarding
+	_textInputSinceLoad = true;
+
 	// Tell social record
 	if (_spSocialRecord != nullptr)
 	{
@@ -11,7 +11,9 @@
 #include "src/State/Web/Tab/Pipelines/JSDialogPipeline.h"
 #include "src/Singletons/LabStreamMailer.h"
 #include "src/CEF/Mediator.h"
+#include "src/Utils/Helper.h"
 #include <algorithm>
+#include <cmath>
 
 #define SendRenderMessage [this](CefRefPtr<CefProcessMessage> msg) { return _pCefMediator->SendProcessMessageToRenderer(msg, this); }
 
@@ -25,10 +27,28 @@ void Tab::GetWebRenderResolution(int& rWidth, int& rHeight) const
 	rHeight = webViewInGUI.height * setup::WEB_VIEW_RESOLUTION_SCALE;
 }
 
+void Tab::ReportPaint(int width, int height, double paintDuration, double uploadDuration)
+{
+	// Texture has requested scale when its size matches, paints in previous scale may still arrive
+	int renderWidth = 0, renderHeight = 0;
+	GetWebRenderResolution(renderWidth, renderHeight);
+	const float scale = GetWebRenderScale();
+	if (renderWidth > 0 && renderHeight > 0
+		&& std::abs(width - renderWidth * scale) <= 1.f
+		&& std::abs(height - renderHeight * scale) <= 1.f)
+	{
+		_upWebView->SetRenderScale(scale);
+	}
+
+	// Collect costs for control of scale
+	_renderScaleController.AddPaint(paintDuration, uploadDuration);
+}
+
 void Tab::SetURL(std::string URL)
 {
 	// Set URL
 	_url = URL;
+	_linkWarmer.NotifyNavigationURL(URL);
 
 	// Reset title
 	_title = "";
@@ -121,20 +141,48 @@ void Tab::ReceiveFaviconBytes(std::unique_ptr< std::vector<unsigned char> > upDa
         // Start color accent interpolation
         _colorInterpolation = 0;
 
+		// Remember favicon and accent of domain, so next visit does not have to wait for download
+		if (FaviconCache* pCache = _pWeb->GetFaviconCache())
+		{
+			pCache->Store(_faviconDomain, width, height, *upData, _targetColorAccent);
+		}
 	}
     // else: do nothing
 }
 
-void Tab::ResetFaviconBytes()
+void Tab::ResetFaviconBytes(std::string URL)
 {
 	LogInfo("Tab: ResetFaviconBytes called!");
     _faviconLoaded = false;
 	_current_favicon_bytes = 0;
 	_loaded_favicon_urls.clear();
+	_faviconFromFreshCache = false;
+	_faviconDomain = (URL.compare(0, 4, "http") == 0) ? ShortenURL(URL) : ""; // local pages are not cached
+
+	// Apply favicon of domain from cache, before page has loaded
+	FaviconCache* pCache = _pWeb->GetFaviconCache();
+	FaviconCache::Favicon favicon;
+	if (pCache && !_faviconDomain.empty() && pCache->Lookup(_faviconDomain, favicon))
+	{
+		eyegui::fetchImage(_pPanelLayout, GetFaviconIdentifier(), favicon.width, favicon.height, eyegui::ColorFormat::RGBA, favicon.data.data(), true);
+		_faviconLoaded = true;
+		_targetColorAccent = favicon.accentColor;
+		_colorInterpolation = 0;
+
+		// Fresh favicon is final, otherwise any download replaces it and refreshes the cache
+		if (favicon.fresh)
+		{
+			_current_favicon_bytes = (int)favicon.data.size();
+			_faviconFromFreshCache = true;
+		}
+	}
 }
 
 bool Tab::IsFaviconAlreadyAvailable(std::string img_url)
 {
+	// No download necessary when cached favicon is recent
+	if (_faviconFromFreshCache) { return true; }
+
 	if (std::find(_loaded_favicon_urls.begin(), _loaded_favicon_urls.end(), img_url) == _loaded_favicon_urls.end())
 	{
 		_loaded_favicon_urls.push_back(img_url);
@@ -340,6 +388,7 @@ void Tab::SetScrollingOffset(double x, double y)
 {
 	_scrollingOffsetX = x;
 	_scrollingOffsetY = y;
+	_scrollPrediction.SetOffset(x, y);
 }
 
 void Tab::SetPageResolution(double width, double height)
@@ -402,9 +451,27 @@ void Tab::SetLoadingStatus(bool isLoading, bool isMainFrame)
 
 		// Abort any pipeline execution when loading of main frame starts
 		AbortAndClearPipelines();
+		_textInputSinceLoad = false;
+
+		// Measure navigation for warming of links
+		_linkWarmer.NotifyNavigationStart();
     }
     else
     {
+		_linkWarmer.NotifyNavigationEnd();
+
+		// Restored page is loaded, so continue where user left it
+		if (_restoring)
+		{
+			_restoring = false;
+			if (_restoreScrollingOffsetX != 0.0 || _restoreScrollingOffsetY != 0.0)
+			{
+				_pCefMediator->ScrollTo(this, _restoreScrollingOffsetX, _restoreScrollingOffsetY);
+			}
+			_restoreLatency = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _restoreStartTime).count();
+			LogInfo("Tab: Restored ", _url, " in ", _restoreLatency, "ms.");
+		}
+
         // Main frame is done with loading
         if (_faviconLoaded)
         {
@@ -10,7 +10,10 @@
 #include "src/Utils/Helper.h"
 #include "src/Utils/Logger.h"
 #include "src/State/Web/Tab/SocialRecord.h"
+#include "src/Utils/Texture.h"
 #include <algorithm>
+#include <sstream>
+#include <iomanip>
 
 Tab::Tab(
 	Master* pMaster,
@@ -120,6 +123,19 @@ Tab::~Tab()
 	// Store current social record if available
 	EndSocialRecord();
 
+	// Report coalescing of scrolling
+	uint64_t scrollEventCount = _pageScrollController.GetEmittedEventCount() + _overflowScrollEventCount;
+	uint64_t scrollUpdateCount = _pageScrollController.GetActiveUpdateCount() + _overflowScrollUpdateCount;
+	for (const auto& rIdControllerPair : _overflowScrollControllers)
+	{
+		scrollEventCount += rIdControllerPair.second.GetEmittedEventCount();
+		scrollUpdateCount += rIdControllerPair.second.GetActiveUpdateCount();
+	}
+	LogDebug("Tab: Coalesced ", scrollUpdateCount, " scrolling updates into ", scrollEventCount, " scroll events.");
+
+	// Report warming of links
+	if (setup::LINK_WARMING) { LogInfo("Tab: Link warming ", _linkWarmer.GetStatistics(), "."); }
+
 	// Delete DOM Nodes and triggers (right now only DOMTriggers) before removing layout
 	ClearDOMNodes();
 
@@ -139,6 +155,17 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 	// Store tpf
 	_lastTimePerFrame = tpf;
 
+	// Reconcile predicted scrolling with CEF
+	_scrollPrediction.Update(tpf);
+
+	// Adapt scale at which CEF paints the web view to costs of painting
+	if (setup::WEB_VIEW_ADAPTIVE_RENDER_SCALE && _renderScaleController.Update(tpf))
+	{
+		LogInfo("Tab: Render scale of web view is ", _renderScaleController.GetScale(), ", ", _renderScaleController.GetReason(), ".");
+		LogValue(LogChannel::WEB_VIEW_RENDER_SCALE, _renderScaleController.GetScale());
+		_pCefMediator->RescaleTab(this);
+	}
+
 	// Poll mediator to update DOM nodes (computed styles etc.)
 	if (setup::USE_DOM_NODE_POLLING)
 	{
@@ -418,8 +445,8 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 			// yOffset = (glm::max(0.f, yOffset - 0.05f) / 0.95f); // In the center of view no movement
 			yOffset = negative ? -yOffset : yOffset; // [-1..1]
 
-			// Update the auto scrolling value (TODO: not really frame rate independend)
-			_autoScrollingValue += tpf * (yOffset - _autoScrollingValue);
+			// Update the auto scrolling value, approaching offset with time constant of one second
+			_autoScrollingValue += (1.f - glm::exp(-tpf)) * (yOffset - _autoScrollingValue);
 		}
 		else if (_autoScrollingValue != 0)
 		{
@@ -436,41 +463,23 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 			}
 		}
 
-		// Use value of auto scrolling to scroll
-        if(_autoScrollingValue != 0.0f)
-        {
-            _pCefMediator->EmulateMouseWheelScrolling(this, 0.0, (double)(20.f * _autoScrollingValue));
-        }
-
-		// Autoscroll inside of DOMOverflowElement if gazed upon
-		for (auto& rIdOverflowPair : _OverflowElementMap)
+		// Use value of auto scrolling and scrolling sensors to scroll. Page is shifted every frame, CEF gets coalesced wheel events
+		_pageScrollController.SetVelocity(glm::dvec2(0.0, (double)(TAB_AUTO_SCROLLING_SPEED * _autoScrollingValue + _scrollingSensorVelocity)));
+		_scrollingSensorVelocity = 0.f;
+		const glm::dvec2 integratedScrolling = _pageScrollController.Integrate();
+		PredictScrolling(integratedScrolling.x, integratedScrolling.y);
+		glm::dvec2 wheelDelta;
+		if (_pageScrollController.Emit(wheelDelta))
 		{
-			auto& rspOverflowElement = rIdOverflowPair.second;
-			if (rspOverflowElement)
-			{
-				for (const auto& rRect : rspOverflowElement->GetRects())
-				{
-					int scrolledCEFPixelGazeX = spTabInput->CEFPixelGazeX;
-					int scrolledCEFPixelGazeY = spTabInput->CEFPixelGazeY;
-
-					// Add scrolling offset if element is not fixed
-					if (!(rspOverflowElement->IsFixed()))
-					{
-						scrolledCEFPixelGazeX += _scrollingOffsetX;
-						scrolledCEFPixelGazeY += _scrollingOffsetY;
-					}
-
-					// Check if current gaze is inside of overflow element, if so execute scrolling method in corresponding Javascript object
-					if (rRect.IsInside(scrolledCEFPixelGazeX, scrolledCEFPixelGazeY))
-					{
-						rspOverflowElement->Scroll(scrolledCEFPixelGazeX, scrolledCEFPixelGazeY);
-						//rspOverflowElement->Scroll(spTabInput->CEFPixelGazeX, spTabInput->CEFPixelGazeY);
-						break;
-					}
-				}
-			}
+			_pCefMediator->EmulateMouseWheelScrolling(this, wheelDelta.x, wheelDelta.y);
 		}
 
+		// Autoscroll inside of DOMOverflowElement if gazed upon
+		UpdateOverflowScrolling(*spTabInput);
+
+		// Warm up link under fixation. Not updated while pipelines run, so clicking reuses the warmed link
+		if (setup::LINK_WARMING) { UpdateLinkWarming(tpf, *spTabInput); }
+
 		// #######################
 		// ### UPDATE TRIGGERS ###
 		// #######################
@@ -549,13 +558,18 @@ void Tab::Update(float tpf, const std::shared_ptr<const Input> spInput)
 
 void Tab::Draw() const
 {
-	// Draw WebView
+	// Draw WebView, shifted by scrolling which has not been painted yet
+	const glm::dvec2 scrollingShift = setup::WEB_VIEW_ASYNC_SCROLLING
+		? _scrollPrediction.GetShift(setup::WEB_VIEW_MAX_SCROLLING_SHIFT)
+		: glm::dvec2(0, 0);
 	_upWebView->Draw(
 		_webViewParameters,
 		_pMaster->GetWindowWidth(),
 		_pMaster->GetWindowHeight(),
 		_scrollingOffsetX,
-		_scrollingOffsetY);
+		_scrollingOffsetY,
+		scrollingShift.x,
+		scrollingShift.y);
 
 	// Decide what to draw
 	if (_pipelineActive)
@@ -580,6 +594,9 @@ void Tab::Draw() const
 
 void Tab::Activate()
 {
+	// Rebuild browser when Tab has been discarded
+	Restore();
+
 	// Show layouts
 	eyegui::setVisibilityOfLayout(_pOverlayLayout, true, true, false);
 	eyegui::setVisibilityOfLayout(_pScrollingOverlayLayout, true, true, false);
@@ -620,12 +637,132 @@ void Tab::Deactivate()
 
 	// Remember being not active
 	_active = false;
+	_deactivationTime = std::chrono::steady_clock::now();
+}
+
+bool Tab::Discard()
+{
+	// Keep Tabs which are displayed or still loading
+	if (IsDiscarded() || _active || _iconState == IconState::LOADING) { return false; }
+
+	// Keep Tabs with videos, as playback state is not known, and Tabs with pipelines,
+	// which are only pushed back in background for JavaScript dialogs
+	if (!_VideoMap.empty() || !_pipelines.empty()) { return false; }
+
+	// Keep Tabs with text entered by user that is still in a text input
+	if (_textInputSinceLoad && std::any_of(_TextInputMap.begin(), _TextInputMap.end(),
+		[](const std::pair<const int, std::shared_ptr<DOMTextInput> >& rPair) { return !rPair.second->GetText().empty(); }))
+	{
+		return false;
+	}
+
+	// Take snapshot
+	std::unique_ptr<Snapshot> upSnapshot = std::unique_ptr<Snapshot>(new Snapshot);
+	upSnapshot->URL = _url;
+	upSnapshot->title = _title;
+	upSnapshot->scrollingOffsetX = _scrollingOffsetX;
+	upSnapshot->scrollingOffsetY = _scrollingOffsetY;
+
+	// Replace rendering in texture by thumbnail, which is displayed until restored page is painted
+	size_t textureBytes = 0;
+	if (auto spTexture = _upWebView->GetTexture().lock())
+	{
+		textureBytes = (size_t)spTexture->GetWidth() * spTexture->GetHeight() * 4;
+		const int resolutionX = _upWebView->GetResolutionX();
+		if (resolutionX > 0 && spTexture->GetPixelsFromMipMap(
+			WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL,
+			upSnapshot->thumbnailWidth,
+			upSnapshot->thumbnailHeight,
+			upSnapshot->thumbnail))
+		{
+			spTexture->Fill(upSnapshot->thumbnailWidth, upSnapshot->thumbnailHeight, GL_RGBA, upSnapshot->thumbnail.data());
+			_upWebView->SetRenderScale((float)upSnapshot->thumbnailWidth / (float)resolutionX);
+			textureBytes -= upSnapshot->thumbnail.size();
+		}
+	}
+
+	// Estimate memory of DOM nodes, which are removed with their triggers
+	const size_t nodeBytes =
+		_TextLinkMap.size() * sizeof(DOMLink)
+		+ _TextInputMap.size() * sizeof(DOMTextInput)
+		+ _SelectFieldMap.size() * sizeof(DOMSelectField)
+		+ _OverflowElementMap.size() * sizeof(DOMOverflowElement)
+		+ _VideoMap.size() * sizeof(DOMVideo)
+		+ _CheckboxMap.size() * sizeof(DOMCheckbox);
+
+	// Social record ends with the browsing session of the page
+	EndSocialRecord();
+	AbortAndClearPipelines();
+	ClearDOMNodes();
+
+	// Close browser and its render process
+	_pCefMediator->UnregisterTab(this);
+	_upSnapshot = std::move(upSnapshot);
+	_discardedBytes = textureBytes + nodeBytes;
+	_restoring = false;
+	LogInfo("Tab: Discarded ", _url, " after ", GetIdleDuration(), "s of idle, freed about ", _discardedBytes / 1024, "KB besides render process.");
+	return true;
+}
+
+float Tab::GetIdleDuration() const
+{
+	if (_active) { return 0.f; }
+	return std::chrono::duration<float>(std::chrono::steady_clock::now() - _deactivationTime).count();
+}
+
+bool Tab::GetSnapshotThumbnail(int& rWidth, int& rHeight, std::vector<unsigned char>& rData) const
+{
+	if (!IsDiscarded() || _upSnapshot->thumbnail.empty()) { return false; }
+	rWidth = _upSnapshot->thumbnailWidth;
+	rHeight = _upSnapshot->thumbnailHeight;
+	rData = _upSnapshot->thumbnail;
+	return true;
+}
+
+std::string Tab::GetDiscardInfo() const
+{
+	std::ostringstream info;
+	info << std::fixed << std::setprecision(1);
+	if (IsDiscarded())
+	{
+		info << "discarded, " << (_discardedBytes / (1024.0 * 1024.0)) << "MB freed";
+	}
+	else if (_restoreLatency >= 0)
+	{
+		info << "restored in " << std::setprecision(0) << _restoreLatency << "ms";
+	}
+	return info.str();
+}
+
+void Tab::Restore(std::string URL)
+{
+	if (!IsDiscarded()) { return; }
+
+	// Scrolling is only restored for page of snapshot
+	const bool snapshotURL = URL.empty() || URL == _upSnapshot->URL;
+	_restoreScrollingOffsetX = snapshotURL ? _upSnapshot->scrollingOffsetX : 0.0;
+	_restoreScrollingOffsetY = snapshotURL ? _upSnapshot->scrollingOffsetY : 0.0;
+	_title = _upSnapshot->title; // until restored page tells its title
+	_restoreStartTime = std::chrono::steady_clock::now();
+	_restoring = true;
+
+	// Create new browser. Its history is lost, only the page itself is restored
+	LogInfo("Tab: Restoring ", snapshotURL ? _upSnapshot->URL : URL, ".");
+	_pCefMediator->RegisterTab(this, snapshotURL ? _upSnapshot->URL : URL);
+	_upSnapshot.reset();
 }
 
 void Tab::OpenURL(std::string URL)
 {
-	// Tell CEF to load a new URL (sets later URL and title here)
-	_pCefMediator->LoadURLInTab(this, URL);
+	// Tell CEF to load a new URL (sets later URL and title here). Discarded Tab gets browser with that URL
+	if (IsDiscarded())
+	{
+		Restore(URL);
+	}
+	else
+	{
+		_pCefMediator->LoadURLInTab(this, URL);
+	}
 
 	// Abort any pipeline execution
 	AbortAndClearPipelines();
@@ -637,6 +774,7 @@ void Tab::OpenURL(std::string URL)
 	_scrollingOffsetX = 0.0;
 	_scrollingOffsetY = 0.0;
 	_prevScrolling = 0.0;
+	_scrollPrediction.Reset();
 }
 
 void Tab::AbortAndClearPipelines()
@@ -940,15 +1078,8 @@ void Tab::EndSocialRecord()
 		// Tell record to end
 		_spSocialRecord->End();
 
-		// Delegate persisting into thread
-		auto spSocialRecord = _spSocialRecord;
-		_pMaster->PushBackAsyncJob(
-			[spSocialRecord]() // provide copy of shared pointer
-		{
-			// Store in database
-			spSocialRecord->Persist();
-			return true; // give the future some value
-		});
+		// Store in database, which does not wait for Firebase
+		_spSocialRecord->Persist();
 
 		// Make member pointer to record null
 		_spSocialRecord = nullptr;
@@ -1083,6 +1214,126 @@ std::string Tab::GetFaviconIdentifier() const
 	return "tab_info_" + std::to_string(_pWeb->GetIdOfTab(this));
 }
 
+void Tab::PredictScrolling(double deltaX, double deltaY)
+{
+	// Predicted offset is limited by page size when known
+	_scrollPrediction.AddWheelDelta(
+		deltaX,
+		deltaY,
+		_pageWidth > 0 ? glm::max(0.0, _pageWidth - _upWebView->GetResolutionX()) : -1.0,
+		_pageHeight > 0 ? glm::max(0.0, _pageHeight - _upWebView->GetResolutionY()) : -1.0);
+}
+
+void Tab::UpdateLinkWarming(float tpf, const TabInput& rTabInput)
+{
+	// Find link under fixation, searching is skipped while there is no fixation worth warming
+	const bool gazeUponPage = rTabInput.insideWebView && !rTabInput.gazeUponGUI;
+	std::string linkURL;
+	std::string linkText;
+	if (gazeUponPage && rTabInput.fixationDuration >= setup::LINK_PRECONNECT_FIXATION_DURATION)
+	{
+		float distance = 0.f;
+		glm::vec2 pagePixelCoordinate = glm::vec2(
+			rTabInput.CEFPixelGazeX + _scrollingOffsetX,
+			rTabInput.CEFPixelGazeY + _scrollingOffsetY);
+		auto spLink = std::dynamic_pointer_cast<const DOMLink>(GetNearestLink(pagePixelCoordinate, distance).lock());
+		if (spLink && distance >= 0 && distance < setup::LINK_CORRECTION_MAX_PIXEL_DISTANCE)
+		{
+			linkURL = spLink->GetUrl();
+			linkText = spLink->GetText();
+		}
+	}
+
+	// Execute decision of warmer
+	std::string URL;
+	switch (_linkWarmer.Update(tpf, gazeUponPage, linkURL, linkText, rTabInput.fixationDuration, URL))
+	{
+	case LinkWarmer::Command::PRECONNECT:
+		_pCefMediator->PreconnectLink(this, URL);
+		break;
+	case LinkWarmer::Command::PREFETCH:
+		_pCefMediator->PrefetchLink(this, URL);
+		break;
+	case LinkWarmer::Command::CANCEL:
+		_pCefMediator->CancelLinkWarming(this);
+		break;
+	case LinkWarmer::Command::NONE:
+		break;
+	}
+}
+
+void Tab::UpdateOverflowScrolling(const TabInput& rTabInput)
+{
+	for (auto& rIdOverflowPair : _OverflowElementMap)
+	{
+		auto& rspOverflowElement = rIdOverflowPair.second;
+		if (!rspOverflowElement) { continue; }
+
+		// Determine scrolling velocity, which is highest when gazing at border of element
+		glm::dvec2 velocity(0, 0);
+		for (const auto& rRect : rspOverflowElement->GetRects())
+		{
+			float scrolledCEFPixelGazeX = rTabInput.CEFPixelGazeX;
+			float scrolledCEFPixelGazeY = rTabInput.CEFPixelGazeY;
+
+			// Add scrolling offset if element is not fixed
+			if (!(rspOverflowElement->IsFixed()))
+			{
+				scrolledCEFPixelGazeX += _scrollingOffsetX;
+				scrolledCEFPixelGazeY += _scrollingOffsetY;
+			}
+
+			// Check if current gaze is inside of overflow element
+			if (rRect.IsInside(scrolledCEFPixelGazeX, scrolledCEFPixelGazeY))
+			{
+				const float borderX = TAB_OVERFLOW_SCROLLING_BORDER * rRect.Width();
+				const float borderY = TAB_OVERFLOW_SCROLLING_BORDER * rRect.Height();
+				const float distLeft = scrolledCEFPixelGazeX - rRect.left;
+				const float distRight = rRect.right - scrolledCEFPixelGazeX;
+				const float distTop = scrolledCEFPixelGazeY - rRect.top;
+				const float distBottom = rRect.bottom - scrolledCEFPixelGazeY;
+				if (distLeft < borderX) { velocity.x -= TAB_OVERFLOW_SCROLLING_SPEED * (1.f - (distLeft / borderX)); }
+				if (distRight < borderX) { velocity.x += TAB_OVERFLOW_SCROLLING_SPEED * (1.f - (distRight / borderX)); }
+				if (distTop < borderY) { velocity.y -= TAB_OVERFLOW_SCROLLING_SPEED * (1.f - (distTop / borderY)); }
+				if (distBottom < borderY) { velocity.y += TAB_OVERFLOW_SCROLLING_SPEED * (1.f - (distBottom / borderY)); }
+				break;
+			}
+		}
+
+		// Controller only exists while element is scrolled
+		auto iter = _overflowScrollControllers.find(rIdOverflowPair.first);
+		if (iter == _overflowScrollControllers.end())
+		{
+			if (velocity == glm::dvec2(0, 0)) { continue; }
+			iter = _overflowScrollControllers.emplace(rIdOverflowPair.first, ScrollController(TAB_SCROLLING_EVENT_RATE)).first;
+		}
+
+		// Execute scrolling in corresponding Javascript object
+		iter->second.SetVelocity(velocity);
+		iter->second.Integrate();
+		glm::dvec2 delta;
+		if (iter->second.Emit(delta))
+		{
+			rspOverflowElement->ScrollBy((int)delta.x, (int)delta.y);
+		}
+	}
+
+	// Remove controllers of elements which are no longer scrolled or gone
+	for (auto iter = _overflowScrollControllers.begin(); iter != _overflowScrollControllers.end();)
+	{
+		if (!iter->second.IsActive() || _OverflowElementMap.find(iter->first) == _OverflowElementMap.end())
+		{
+			_overflowScrollEventCount += iter->second.GetEmittedEventCount();
+			_overflowScrollUpdateCount += iter->second.GetActiveUpdateCount();
+			iter = _overflowScrollControllers.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
 // increase the volumn of the video
 void Tab::IncreaseVideoVolume(int videoModeId) {
 	auto iter = _VideoMap.find(videoModeId);
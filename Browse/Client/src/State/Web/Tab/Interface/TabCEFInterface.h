@@ -32,6 +32,14 @@ public:
     // Tell CEF callback which resolution web view texture should have
     virtual void GetWebRenderResolution(int& rWidth, int& rHeight) const = 0;
 
+	// Tell CEF callback at which scale web view texture should be painted. Resolution
+	// above is kept, so scale only changes pixel count of texture and not the layout
+	virtual float GetWebRenderScale() const = 0;
+
+	// Receive paint of web view with its size in pixels and costs in milliseconds. Paint
+	// duration covers copy and upload of the painted pixels on main thread
+	virtual void ReportPaint(int width, int height, double paintDuration, double uploadDuration) = 0;
+
     // Getter and setter for favicon URL
     virtual std::string GetFavIconURL() const = 0;
     virtual void SetFavIconURL(std::string url) = 0;
@@ -45,7 +53,7 @@ public:
 
     // Receive favicon bytes as char vector ordered in RGBA
     virtual void ReceiveFaviconBytes(std::unique_ptr< std::vector<unsigned char> > upData, int width, int height) = 0;
-    virtual void ResetFaviconBytes() = 0;
+    virtual void ResetFaviconBytes(std::string URL) = 0; // URL of page which starts loading
 
     // Get weak pointer to texture of web view
     virtual std::weak_ptr<Texture> GetWebViewTexture() = 0;
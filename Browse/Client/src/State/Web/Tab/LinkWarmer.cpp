@@ -0,0 +1,233 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "LinkWarmer.h"
+#include "src/Setup.h"
+#include "src/Global.h"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <cctype>
+
+// Words in links that may change state on server with a GET request, compared without case and punctuation
+static const char* const UNSAFE_LINK_WORDS[] = {
+	"logout", "logoff", "signout", "signoff", "delete", "remove", "unsubscribe", "cancel",
+	"destroy", "revoke", "disconnect", "confirm", "approve", "reject", "action", "vote", "abmelden", "loeschen" };
+
+LinkWarmer::LinkWarmer(bool prefetch) : _prefetch(prefetch)
+{
+	// Nothing to do
+}
+
+LinkWarmer::Command LinkWarmer::Update(float tpf, bool gazeUponPage, const std::string& rLinkURL, const std::string& rLinkText, float fixationDuration, std::string& rURL)
+{
+	// Refill rate limit
+	if (!_tokensInitialized)
+	{
+		_tokens = setup::LINK_WARMING_BURST;
+		_tokensInitialized = true;
+	}
+	_tokens = std::min(setup::LINK_WARMING_BURST, _tokens + tpf * (setup::LINK_WARMING_MAX_RATE / 60.f));
+
+	// Forget warmings which cannot be hit anymore
+	const auto now = std::chrono::steady_clock::now();
+	while (!_warmings.empty()
+		&& (_warmings.size() > LINK_WARMING_MAX_COUNT
+			|| std::chrono::duration<float>(now - _warmings.front().time).count() > setup::LINK_PREFETCH_LIFETIME))
+	{
+		_warmings.pop_front();
+	}
+
+	// Keep everything while gaze is elsewhere, user might be on the way to trigger a click
+	if (!gazeUponPage) { return Command::NONE; }
+
+	// Cancel warming when gaze has left the link
+	const std::string URL = StripFragment(rLinkURL);
+	if (URL != _linkURL)
+	{
+		const bool warmed = _stage == Stage::PRECONNECTED || _stage == Stage::PREFETCHED;
+		_linkURL = URL;
+		_linkText = rLinkText;
+		_linkOrigin = GetOrigin(URL);
+		_stage = Stage::NONE;
+		if (warmed)
+		{
+			_cancelCount++;
+			return Command::CANCEL;
+		}
+	}
+	if (_linkOrigin.empty()) { return Command::NONE; } // no link or not fetchable
+
+	// Open connection after short fixation and prefetch after longer one, when link is considered safe
+	if (_stage == Stage::NONE && fixationDuration >= setup::LINK_PRECONNECT_FIXATION_DURATION)
+	{
+		if (Warm(Stage::PRECONNECTED))
+		{
+			rURL = _linkOrigin;
+			return Command::PRECONNECT;
+		}
+	}
+	else if (_stage == Stage::PRECONNECTED
+		&& fixationDuration >= setup::LINK_PREFETCH_FIXATION_DURATION
+		&& _prefetch
+		&& IsPrefetchable(_linkURL, _linkText, _pageOrigin))
+	{
+		if (Warm(Stage::PREFETCHED))
+		{
+			rURL = _linkURL;
+			return Command::PREFETCH;
+		}
+	}
+	return Command::NONE;
+}
+
+void LinkWarmer::NotifyNavigationStart()
+{
+	_navigating = true; // URL may be told before or after start
+	_navigationStart = std::chrono::steady_clock::now();
+}
+
+void LinkWarmer::NotifyNavigationURL(const std::string& rURL)
+{
+	_navigationURL = StripFragment(rURL);
+	_pageOrigin = GetOrigin(rURL);
+}
+
+void LinkWarmer::NotifyNavigationEnd()
+{
+	if (!_navigating) { return; }
+	_navigating = false;
+	const auto now = std::chrono::steady_clock::now();
+	const double duration = std::chrono::duration<double, std::milli>(now - _navigationStart).count();
+	const std::string origin = GetOrigin(_navigationURL);
+	if (origin.empty()) { return; } // internal pages are no navigations of interest
+
+	// Prefetch of exactly that URL is preferred over connection to its origin
+	auto prefetch = std::find_if(_warmings.begin(), _warmings.end(), [&](const Warming& rWarming)
+	{
+		return rWarming.stage == Stage::PREFETCHED && rWarming.URL == _navigationURL;
+	});
+	if (prefetch != _warmings.end())
+	{
+		_prefetchHitCount++;
+		_prefetchHitDuration += duration;
+		_warmings.erase(prefetch);
+		return;
+	}
+	auto preconnect = std::find_if(_warmings.begin(), _warmings.end(), [&](const Warming& rWarming)
+	{
+		return rWarming.origin == origin
+			&& std::chrono::duration<float>(now - rWarming.time).count() <= setup::LINK_PRECONNECT_LIFETIME;
+	});
+	if (preconnect != _warmings.end())
+	{
+		_preconnectHitCount++;
+		_preconnectHitDuration += duration;
+		_warmings.erase(preconnect);
+		return;
+	}
+	_missCount++;
+	_missDuration += duration;
+}
+
+std::string LinkWarmer::GetStatistics() const
+{
+	const unsigned int warmedCount = _preconnectCount;
+	const unsigned int hitCount = _preconnectHitCount + _prefetchHitCount;
+	auto mean = [](double sum, unsigned int count) { return count > 0 ? sum / count : 0.0; };
+
+	std::ostringstream stream;
+	stream << std::fixed << std::setprecision(0)
+		<< "warmed " << warmedCount << " links (" << _prefetchCount << " prefetched, "
+		<< _cancelCount << " cancelled, " << _rateLimitedCount << " rate limited), "
+		<< hitCount << " navigations hit, "
+		<< "hit rate " << (warmedCount > 0 ? 100.0 * hitCount / warmedCount : 0.0) << "%, "
+		<< "navigation took " << mean(_prefetchHitDuration, _prefetchHitCount) << "ms after prefetch ("
+		<< _prefetchHitCount << "), " << mean(_preconnectHitDuration, _preconnectHitCount) << "ms after preconnect ("
+		<< _preconnectHitCount << ") and " << mean(_missDuration, _missCount) << "ms otherwise (" << _missCount << ")";
+	return stream.str();
+}
+
+std::string LinkWarmer::GetOrigin(const std::string& rURL)
+{
+	// Scheme
+	const size_t schemeEnd = rURL.find("://");
+	if (schemeEnd == std::string::npos) { return ""; }
+	std::string scheme = rURL.substr(0, schemeEnd);
+	std::transform(scheme.begin(), scheme.end(), scheme.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+	if (scheme != "http" && scheme != "https") { return ""; }
+
+	// Host and port, without user info
+	const size_t authorityStart = schemeEnd + 3;
+	const size_t authorityEnd = rURL.find_first_of("/?#", authorityStart);
+	std::string authority = rURL.substr(authorityStart, authorityEnd == std::string::npos ? std::string::npos : authorityEnd - authorityStart);
+	const size_t userInfoEnd = authority.rfind('@');
+	if (userInfoEnd != std::string::npos) { authority = authority.substr(userInfoEnd + 1); }
+	if (authority.empty()) { return ""; }
+	std::transform(authority.begin(), authority.end(), authority.begin(), [](unsigned char c) { return (char)std::tolower(c); });
+	return scheme + "://" + authority;
+}
+
+bool LinkWarmer::IsPrefetchable(const std::string& rURL, const std::string& rText, const std::string& rPageOrigin)
+{
+	// Cookies of other sites are not sent along
+	const std::string origin = GetOrigin(rURL);
+	if (origin.empty() || origin != rPageOrigin) { return false; }
+
+	// Reduce path, query and text to lower case letters and digits, so "Log out" and "log_out" match
+	std::string words;
+	auto append = [&](const std::string& rPart)
+	{
+		for (unsigned char c : rPart)
+		{
+			if (std::isalnum(c)) { words += (char)std::tolower(c); }
+		}
+	};
+	append(rURL.substr(origin.length()));
+	append(rText);
+	for (const char* pWord : UNSAFE_LINK_WORDS)
+	{
+		if (words.find(pWord) != std::string::npos) { return false; }
+	}
+	return true;
+}
+
+bool LinkWarmer::Warm(Stage stage)
+{
+	if (_tokens < 1.f)
+	{
+		_rateLimitedCount++;
+		_stage = Stage::RATE_LIMITED; // not tried again until gaze moves to other link
+		return false;
+	}
+	_tokens -= 1.f;
+	_stage = stage;
+
+	// Count each link once as warmed, prefetch upgrades its preconnect
+	if (stage == Stage::PRECONNECTED)
+	{
+		_preconnectCount++;
+		_warmings.push_back({ _linkURL, _linkOrigin, stage, std::chrono::steady_clock::now() });
+	}
+	else
+	{
+		_prefetchCount++;
+		if (!_warmings.empty() && _warmings.back().URL == _linkURL)
+		{
+			_warmings.back().stage = stage;
+			_warmings.back().time = std::chrono::steady_clock::now();
+		}
+		else
+		{
+			_warmings.push_back({ _linkURL, _linkOrigin, stage, std::chrono::steady_clock::now() });
+		}
+	}
+	return true;
+}
+
+std::string LinkWarmer::StripFragment(const std::string& rURL)
+{
+	return rURL.substr(0, rURL.find('#'));
+}
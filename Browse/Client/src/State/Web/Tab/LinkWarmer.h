@@ -0,0 +1,108 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Decides which link under a stable fixation is warmed up before it is
+// clicked. After a short fixation the connection to the origin of the link
+// is opened. When enabled, the target is prefetched with low priority after
+// a longer one. Prefetch sends cookies, so it is restricted to links of the
+// origin of the page which do not look like they have side effects, e.g.
+// logout or delete. Warming is rate-limited and cancelled when gaze leaves
+// the link. Tab executes the returned commands in the browser and reports
+// navigations, so hit rate and navigation time with and without warming are
+// measured.
+
+#ifndef LINKWARMER_H_
+#define LINKWARMER_H_
+
+#include "src/Setup.h"
+#include <string>
+#include <deque>
+#include <chrono>
+
+class LinkWarmer
+{
+public:
+
+	// Command which has to be executed in browser
+	enum class Command { NONE, PRECONNECT, PREFETCH, CANCEL };
+
+	// Constructor, takes whether links may be prefetched
+	LinkWarmer(bool prefetch = setup::LINK_PREFETCH);
+
+	// Update with URL and text of link under fixation, empty if none, and duration of fixation in seconds.
+	// Gaze which is not upon page, e.g. upon the button to start clicking, keeps warming as it is.
+	// Returns command for browser. URL of command is written to rURL, which is the origin for preconnect
+	Command Update(float tpf, bool gazeUponPage, const std::string& rLinkURL, const std::string& rLinkText, float fixationDuration, std::string& rURL);
+
+	// Notify about navigation of main frame
+	void NotifyNavigationStart();
+	void NotifyNavigationURL(const std::string& rURL);
+	void NotifyNavigationEnd();
+
+	// Get summary of warming for log
+	std::string GetStatistics() const;
+
+	// Get origin of URL, i.e. scheme, host and port. Empty if URL is not HTTP(S)
+	static std::string GetOrigin(const std::string& rURL);
+
+	// Whether link may be prefetched from page of given origin. Requires same origin and
+	// neither path, query nor text of link may contain words of actions like logout or delete
+	static bool IsPrefetchable(const std::string& rURL, const std::string& rText, const std::string& rPageOrigin);
+
+private:
+
+	// Stage of warming of current link
+	enum class Stage { NONE, PRECONNECTED, PREFETCHED, RATE_LIMITED };
+
+	// Warmed link, kept until its connection is not expected to be reused anymore
+	struct Warming
+	{
+		std::string URL;
+		std::string origin;
+		Stage stage;
+		std::chrono::steady_clock::time_point time;
+	};
+
+	// Register warming of current link, returns false when rate limit is exceeded
+	bool Warm(Stage stage);
+
+	// URL without fragment, as fragment does not change the request
+	static std::string StripFragment(const std::string& rURL);
+
+	// Whether links may be prefetched
+	bool _prefetch;
+
+	// Current link
+	std::string _linkURL;
+	std::string _linkText;
+	std::string _linkOrigin;
+	Stage _stage = Stage::NONE;
+
+	// Rate limit as token bucket
+	float _tokens = 0.f;
+	bool _tokensInitialized = false;
+
+	// Recent warmings
+	std::deque<Warming> _warmings;
+
+	// Current navigation
+	bool _navigating = false;
+	std::string _navigationURL;
+	std::string _pageOrigin; // origin of page displayed or being loaded
+	std::chrono::steady_clock::time_point _navigationStart;
+
+	// Statistics, durations in milliseconds
+	unsigned int _preconnectCount = 0;
+	unsigned int _prefetchCount = 0;
+	unsigned int _cancelCount = 0;
+	unsigned int _rateLimitedCount = 0;
+	unsigned int _preconnectHitCount = 0;
+	unsigned int _prefetchHitCount = 0;
+	unsigned int _missCount = 0;
+	double _preconnectHitDuration = 0;
+	double _prefetchHitDuration = 0;
+	double _missDuration = 0;
+};
+
+#endif // LINKWARMER_H_
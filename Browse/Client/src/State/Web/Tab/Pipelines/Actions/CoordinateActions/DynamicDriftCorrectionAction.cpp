@@ -188,7 +188,7 @@ bool DynamicDriftCorrectionAction::Update(float tpf, const std::shared_ptr<const
 
 				// Angle between zoomCoordinateDeltaVector and gazeDeltaVector
 				float deltaAngle = glm::degrees(glm::angle(glm::normalize(gazeDeltaVector), glm::normalize(zoomCoordinateDeltaVector)));
-				LogInfo("DriftAngle: ", deltaAngle); // TODO: which value interval is the angle in?
+				LogValue(LogChannel::DRIFT_ANGLE, deltaAngle); // TODO: which value interval is the angle in?
 
 				// Decide to go directly for zoom coordinate (good calibration) or drift corrected coordinate (poor calibration) or continue zooming
 				if (zoomCoordinateDelta < 1.f) // zoom coordinate has not changed in pixels on page
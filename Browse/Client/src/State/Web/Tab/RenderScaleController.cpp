@@ -0,0 +1,98 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "RenderScaleController.h"
+#include "src/Setup.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <iomanip>
+
+RenderScaleController::RenderScaleController(float minScale, float maxScale) : _minScale(minScale), _maxScale(maxScale), _scale(maxScale)
+{
+	// Nothing to do
+}
+
+void RenderScaleController::AddPaint(double paintDuration, double uploadDuration)
+{
+	_paintDuration += paintDuration;
+	_uploadDuration += uploadDuration;
+	_paintCount++;
+}
+
+bool RenderScaleController::Update(float tpf)
+{
+	// Costs right after change of scale are not representative
+	if (_holdTime > 0)
+	{
+		_holdTime -= tpf;
+		_windowTime = 0;
+		_frameCount = 0;
+		_paintDuration = 0;
+		_uploadDuration = 0;
+		_paintCount = 0;
+		return false;
+	}
+
+	// Accumulate until window is full
+	_windowTime += tpf;
+	_frameCount++;
+	if (_windowTime < setup::WEB_VIEW_RENDER_SCALE_WINDOW) { return false; }
+
+	// Average costs per frame in milliseconds
+	const double frameDuration = 1000.0 * _windowTime / _frameCount;
+	const double paintCost = _paintDuration / _frameCount;
+	const double uploadCost = _uploadDuration / _frameCount;
+	const double budget = setup::WEB_VIEW_FRAME_BUDGET;
+	const unsigned int paintCount = _paintCount;
+	_windowTime = 0;
+	_frameCount = 0;
+	_paintDuration = 0;
+	_uploadDuration = 0;
+	_paintCount = 0;
+
+	// Describe costs for reason
+	std::ostringstream costs;
+	costs << std::fixed << std::setprecision(1)
+		<< "frame " << frameDuration << "ms of " << budget << "ms budget, "
+		<< paintCount << " paints cost " << paintCost << "ms per frame with "
+		<< uploadCost << "ms upload";
+
+	// Lower scale when frames are missed and painting has a relevant share of it
+	const bool overBudget = frameDuration > budget * (1.0 + setup::WEB_VIEW_FRAME_BUDGET_TOLERANCE);
+	if (overBudget && paintCost > budget * setup::WEB_VIEW_PAINT_SHARE_MIN)
+	{
+		// Cost is proportional to pixel count, so scale with root of targeted reduction
+		const double targetCost = std::max(paintCost - (frameDuration - budget), 0.25 * paintCost);
+		return SetScale(_scale * (float)std::sqrt(targetCost / paintCost), "lowered, " + costs.str());
+	}
+
+	// Raise scale when painting at next step is predicted to fit into budget
+	if (!overBudget && _scale < _maxScale)
+	{
+		const float nextScale = _scale + setup::WEB_VIEW_RENDER_SCALE_STEP;
+		const double predictedCost = paintCost * (nextScale * nextScale) / (_scale * _scale);
+		if (predictedCost < budget * setup::WEB_VIEW_PAINT_SHARE_MAX)
+		{
+			return SetScale(nextScale, "raised, " + costs.str());
+		}
+	}
+
+	return false;
+}
+
+bool RenderScaleController::SetScale(float scale, std::string reason)
+{
+	// Snap down to step, epsilon protects exact multiples from rounding errors
+	const float step = setup::WEB_VIEW_RENDER_SCALE_STEP;
+	scale = std::floor(scale / step + 0.001f) * step;
+	scale = std::max(_minScale, std::min(_maxScale, scale));
+	if (std::abs(scale - _scale) < 0.5f * step) { return false; }
+
+	_scale = scale;
+	_reason = reason;
+	_holdTime = setup::WEB_VIEW_RENDER_SCALE_HOLD;
+	return true;
+}
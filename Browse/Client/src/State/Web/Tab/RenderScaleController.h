@@ -0,0 +1,62 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Controller of the scale at which CEF paints the web view of a Tab. Layout
+// of the page stays in CEFPixel coordinates, only the device scale factor and
+// therefore the resolution of the painted texture changes. Costs of painting
+// and upload are averaged over a window and compared against the frame
+// budget. Scale is lowered when frames are missed because of painting and
+// raised again when the predicted cost fits into the budget. Scales are
+// multiples of a step, so small fluctuations do not cause resizes of CEF.
+
+#ifndef RENDERSCALECONTROLLER_H_
+#define RENDERSCALECONTROLLER_H_
+
+#include <string>
+
+class RenderScaleController
+{
+public:
+
+	// Constructor, takes bounds of scale. Starts at maximum
+	RenderScaleController(float minScale, float maxScale);
+
+	// Add cost of a paint in milliseconds. Paint cost covers the work in the
+	// paint callback on main thread and includes the upload to the texture
+	void AddPaint(double paintDuration, double uploadDuration);
+
+	// Update with time per frame in seconds. Returns whether scale has changed
+	bool Update(float tpf);
+
+	// Getter for current scale
+	float GetScale() const { return _scale; }
+
+	// Getter for human readable reason of current scale
+	std::string GetReason() const { return _reason; }
+
+private:
+
+	// Set scale, which is snapped to step and clamped. Returns whether changed
+	bool SetScale(float scale, std::string reason);
+
+	// Bounds
+	float _minScale;
+	float _maxScale;
+
+	// Current scale and why it has been chosen
+	float _scale;
+	std::string _reason = "initial";
+
+	// Accumulation over current window
+	float _windowTime = 0; // seconds
+	unsigned int _frameCount = 0;
+	double _paintDuration = 0; // milliseconds
+	double _uploadDuration = 0; // milliseconds
+	unsigned int _paintCount = 0;
+
+	// Remaining time until costs are measured after change of scale, as CEF repaints everything
+	float _holdTime = 0;
+};
+
+#endif // RENDERSCALECONTROLLER_H_
@@ -0,0 +1,84 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "ScrollController.h"
+#include "src/Global.h"
+#include <cmath>
+#include <algorithm>
+
+ScrollController::ScrollController(float maxEventRate)
+{
+	_minEventInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / (double)maxEventRate));
+}
+
+void ScrollController::SetVelocity(glm::dvec2 velocity)
+{
+	_velocity = velocity;
+}
+
+glm::dvec2 ScrollController::Integrate()
+{
+	const auto now = std::chrono::steady_clock::now();
+	glm::dvec2 delta(0, 0);
+
+	// Integration starts with first call that has velocity, so idle time is not integrated
+	if (_velocity == glm::dvec2(0, 0))
+	{
+		_integrating = false;
+		return delta;
+	}
+	if (_integrating)
+	{
+		// Long gaps, e.g. while tab was not updated, are not caught up
+		const double seconds = std::min(std::chrono::duration<double>(now - _lastIntegration).count(), SCROLL_CONTROLLER_MAX_INTEGRATION_STEP);
+		delta = _velocity * seconds;
+		_accumulated += delta;
+	}
+	else
+	{
+		_lastEmission = now; // first event is emitted after one interval, so it is coalesced, too
+	}
+	_lastIntegration = now;
+	_integrating = true;
+	_activeUpdateCount++;
+	return delta;
+}
+
+bool ScrollController::Emit(glm::dvec2& rDelta)
+{
+	// Whole pixels to emit, rounded towards zero
+	const glm::dvec2 whole(std::trunc(_accumulated.x), std::trunc(_accumulated.y));
+	if (whole == glm::dvec2(0, 0))
+	{
+		// Drop remainder that will never become a pixel
+		if (_velocity == glm::dvec2(0, 0)) { _accumulated = glm::dvec2(0, 0); }
+		return false;
+	}
+
+	// Bound rate while scrolling, flush directly after it stopped
+	const auto now = std::chrono::steady_clock::now();
+	if (_velocity != glm::dvec2(0, 0) && now - _lastEmission < _minEventInterval)
+	{
+		return false;
+	}
+
+	rDelta = whole;
+	_accumulated -= whole;
+	_lastEmission = now;
+	_emittedEventCount++;
+	return true;
+}
+
+void ScrollController::Reset()
+{
+	_velocity = glm::dvec2(0, 0);
+	_accumulated = glm::dvec2(0, 0);
+	_integrating = false;
+}
+
+bool ScrollController::IsActive() const
+{
+	return _velocity != glm::dvec2(0, 0) || std::abs(_accumulated.x) >= 1.0 || std::abs(_accumulated.y) >= 1.0;
+}
@@ -0,0 +1,56 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Integrates scrolling velocity over real time and coalesces the resulting
+// delta into scroll events of bounded rate, so neither speed nor count of
+// events sent to CEF depends on the frame rate. Only whole pixels are emitted,
+// remainder is kept for the next event.
+
+#ifndef SCROLLCONTROLLER_H_
+#define SCROLLCONTROLLER_H_
+
+#include "src/Utils/glmWrapper.h"
+#include <chrono>
+#include <cstdint>
+
+class ScrollController
+{
+public:
+
+	// Constructor, takes maximum count of emitted events per second
+	ScrollController(float maxEventRate);
+
+	// Set velocity in pixels per second, kept until changed
+	void SetVelocity(glm::dvec2 velocity);
+
+	// Integrate velocity since last call. Returns delta integrated by this call, e.g. for prediction
+	glm::dvec2 Integrate();
+
+	// Whether accumulated delta should be emitted now. Delta is filled and removed from accumulation then
+	bool Emit(glm::dvec2& rDelta);
+
+	// Drop accumulated delta and velocity
+	void Reset();
+
+	// Whether there is velocity or delta left to emit
+	bool IsActive() const;
+
+	// Counters
+	uint64_t GetEmittedEventCount() const { return _emittedEventCount; }
+	uint64_t GetActiveUpdateCount() const { return _activeUpdateCount; } // integrations with velocity, i.e. events without coalescing
+
+private:
+
+	// Members
+	std::chrono::steady_clock::duration _minEventInterval;
+	std::chrono::steady_clock::time_point _lastIntegration;
+	std::chrono::steady_clock::time_point _lastEmission;
+	glm::dvec2 _velocity = glm::dvec2(0, 0);
+	glm::dvec2 _accumulated = glm::dvec2(0, 0);
+	bool _integrating = false; // whether last integration time is valid
+	uint64_t _emittedEventCount = 0;
+	uint64_t _activeUpdateCount = 0;
+};
+
+#endif // SCROLLCONTROLLER_H_
@@ -0,0 +1,67 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "ScrollPrediction.h"
+#include "src/Global.h"
+
+void ScrollPrediction::AddWheelDelta(double deltaX, double deltaY, double maxOffsetX, double maxOffsetY)
+{
+	// Wheel moves content opposite to offset
+	_target -= glm::dvec2(deltaX, deltaY);
+
+	// Page cannot be scrolled beyond its borders
+	_target = glm::max(_target, glm::dvec2(0, 0));
+	if (maxOffsetX >= 0) { _target.x = glm::min(_target.x, maxOffsetX); }
+	if (maxOffsetY >= 0) { _target.y = glm::min(_target.y, maxOffsetY); }
+
+	_timeSinceDelta = 0;
+	_pending = true;
+}
+
+void ScrollPrediction::SetOffset(double x, double y)
+{
+	_offset = glm::dvec2(x, y);
+
+	// Scrolling not caused by wheel, e.g. by JavaScript or anchors
+	if (!_pending)
+	{
+		_target = _offset;
+	}
+}
+
+void ScrollPrediction::Update(float tpf)
+{
+	if (!_pending)
+	{
+		return;
+	}
+	_timeSinceDelta += tpf;
+
+	// CEF did not follow prediction completely, e.g. because wheel scrolled an element instead of page
+	if (_timeSinceDelta > SCROLL_PREDICTION_RECONCILIATION_DELAY)
+	{
+		_target += (_offset - _target) * (double)glm::min(1.f, tpf * SCROLL_PREDICTION_RECONCILIATION_SPEED);
+	}
+
+	// Prediction fulfilled
+	if (glm::distance(_target, _offset) < 0.5)
+	{
+		_target = _offset;
+		_pending = false;
+	}
+}
+
+void ScrollPrediction::Reset()
+{
+	_offset = glm::dvec2(0, 0);
+	_target = glm::dvec2(0, 0);
+	_timeSinceDelta = 0;
+	_pending = false;
+}
+
+glm::dvec2 ScrollPrediction::GetShift(double maximum) const
+{
+	return glm::clamp(_target - _offset, glm::dvec2(-maximum, -maximum), glm::dvec2(maximum, maximum));
+}
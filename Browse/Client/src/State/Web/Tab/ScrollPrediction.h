@@ -0,0 +1,47 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Predicts scrolling offset of a web page from the wheel deltas sent to CEF,
+// so the page texture can be shifted before CEF has repainted. Prediction is
+// reconciled with the offset reported by CEF, which is taken as is once no
+// deltas have been sent for a while. Offsets are in CEF pixels.
+
+#ifndef SCROLLPREDICTION_H_
+#define SCROLLPREDICTION_H_
+
+#include "src/Utils/glmWrapper.h"
+
+class ScrollPrediction
+{
+public:
+
+	// Add wheel delta sent to CEF, positive delta scrolls towards the top of page. Maximum offsets
+	// are used for clamping unless negative, which indicates unknown page size
+	void AddWheelDelta(double deltaX, double deltaY, double maxOffsetX, double maxOffsetY);
+
+	// Set offset reported by CEF
+	void SetOffset(double x, double y);
+
+	// Update reconciliation
+	void Update(float tpf);
+
+	// Reset to offset of zero, e.g. when page changes
+	void Reset();
+
+	// Shift of page relative to offset painted by CEF, bounded by given maximum
+	glm::dvec2 GetShift(double maximum) const;
+
+	// Offset expected after CEF has processed all deltas
+	glm::dvec2 GetPredictedOffset() const { return _target; }
+
+private:
+
+	// Members
+	glm::dvec2 _offset = glm::dvec2(0, 0); // reported by CEF
+	glm::dvec2 _target = glm::dvec2(0, 0); // predicted
+	float _timeSinceDelta = 0; // seconds
+	bool _pending = false; // whether prediction differs from reported offset
+};
+
+#endif // SCROLLPREDICTION_H_
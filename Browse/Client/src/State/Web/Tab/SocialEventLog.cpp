@@ -0,0 +1,51 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "SocialEventLog.h"
+
+SocialEventLog::SocialEventLog(unsigned int capacity) : _capacity(capacity) {}
+
+bool SocialEventLog::AddClick(unsigned int page, const std::string& rTag, const std::string& rId, float x, float y, double time)
+{
+	return Add(Type::CLICK, page, rTag, rId, x, y, time, 0, 0, 0.f);
+}
+
+bool SocialEventLog::AddTextInput(unsigned int page, const std::string& rTag, const std::string& rId, int charCount, int charDistance, float x, float y, double time, float duration)
+{
+	return Add(Type::TEXT_INPUT, page, rTag, rId, x, y, time, charCount, charDistance, duration);
+}
+
+bool SocialEventLog::Add(Type type, unsigned int page, const std::string& rTag, const std::string& rId, float x, float y, double time, int charCount, int charDistance, float duration)
+{
+	if (_types.size() >= _capacity)
+	{
+		++_droppedCount;
+		return false;
+	}
+	_types.push_back(type);
+	_pages.push_back(page);
+	_tags.push_back(Intern(rTag));
+	_ids.push_back(Intern(rId));
+	_xs.push_back(x);
+	_ys.push_back(y);
+	_times.push_back(time);
+	_charCounts.push_back(charCount);
+	_charDistances.push_back(charDistance);
+	_durations.push_back(duration);
+	return true;
+}
+
+uint32_t SocialEventLog::Intern(const std::string& rString)
+{
+	auto iter = _stringIndices.find(rString);
+	if (iter != _stringIndices.end())
+	{
+		return iter->second;
+	}
+	const uint32_t index = (uint32_t)_strings.size();
+	_strings.push_back(rString);
+	_stringIndices.emplace(rString, index);
+	return index;
+}
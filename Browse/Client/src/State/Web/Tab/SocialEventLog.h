@@ -0,0 +1,80 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Log of clicks and text inputs of a social record. Events are stored column
+// by column and tags and ids are interned, as they repeat a lot on the same
+// platform. Log has a capacity, further events are only counted as dropped.
+
+#ifndef SOCIALEVENTLOG_H_
+#define SOCIALEVENTLOG_H_
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+class SocialEventLog
+{
+public:
+
+	// Type of event
+	enum class Type : uint8_t { CLICK, TEXT_INPUT };
+
+	// Constructor, takes maximum count of events
+	SocialEventLog(unsigned int capacity);
+
+	// Add click. Returns whether added or dropped because log is full
+	bool AddClick(unsigned int page, const std::string& rTag, const std::string& rId, float x, float y, double time);
+
+	// Add text input. Returns whether added or dropped because log is full
+	bool AddTextInput(unsigned int page, const std::string& rTag, const std::string& rId, int charCount, int charDistance, float x, float y, double time, float duration);
+
+	// Count of events in log
+	unsigned int GetCount() const { return (unsigned int)_types.size(); }
+
+	// Count of events which have been dropped
+	unsigned int GetDroppedCount() const { return _droppedCount; }
+
+	// Getter for event at index
+	Type GetType(unsigned int index) const { return _types[index]; }
+	unsigned int GetPage(unsigned int index) const { return _pages[index]; }
+	const std::string& GetTag(unsigned int index) const { return _strings[_tags[index]]; }
+	const std::string& GetId(unsigned int index) const { return _strings[_ids[index]]; }
+	float GetX(unsigned int index) const { return _xs[index]; }
+	float GetY(unsigned int index) const { return _ys[index]; }
+	double GetTime(unsigned int index) const { return _times[index]; }
+	int GetCharCount(unsigned int index) const { return _charCounts[index]; } // zero for clicks
+	int GetCharDistance(unsigned int index) const { return _charDistances[index]; } // zero for clicks
+	float GetDuration(unsigned int index) const { return _durations[index]; } // zero for clicks
+
+private:
+
+	// Add event with all columns, returns whether added
+	bool Add(Type type, unsigned int page, const std::string& rTag, const std::string& rId, float x, float y, double time, int charCount, int charDistance, float duration);
+
+	// Get index of string in table, adds it if not yet available
+	uint32_t Intern(const std::string& rString);
+
+	// Capacity
+	const unsigned int _capacity;
+	unsigned int _droppedCount = 0;
+
+	// Interned strings
+	std::vector<std::string> _strings;
+	std::unordered_map<std::string, uint32_t> _stringIndices;
+
+	// Columns
+	std::vector<Type> _types;
+	std::vector<uint32_t> _pages;
+	std::vector<uint32_t> _tags;
+	std::vector<uint32_t> _ids;
+	std::vector<float> _xs;
+	std::vector<float> _ys;
+	std::vector<double> _times;
+	std::vector<int32_t> _charCounts;
+	std::vector<int32_t> _charDistances;
+	std::vector<float> _durations;
+};
+
+#endif // SOCIALEVENTLOG_H_
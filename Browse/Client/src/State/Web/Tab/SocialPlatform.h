@@ -0,0 +1,61 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Social platforms and their classification by domain. Kept apart from the
+// social record, which depends on the Firebase mailer.
+
+#ifndef SOCIALPLATFORM_H_
+#define SOCIALPLATFORM_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+// List of social platforms (mind the order)
+enum class SocialPlatform
+{
+	Unknown, News, Shopping, Email, Wikipedia, Facebook, Linkedin, YouTube, Instagram, Twitter, Google, Yahoo, Ok, Vk, Whatsapp // Email does not include GMail!
+};
+
+// List of identifying domain parts for social platforms (mind the order)
+static const std::map < SocialPlatform, std::vector<std::string> > SocialIdentifiers =
+{
+	{ SocialPlatform::News,		{ "reddit.com", "msn.com", "protothema.gr", "sport24.gr", "gazzetta.gr", "newsit.gr", "iefimerida.gr", "news247.gr",
+								  "newsbomb.gr", "ynet.co.il", "walla.co.il", "mako.co.il", "sport5.co.il", "haaretz.co.il", "globes.co.il", "one.co.il",
+								  "calcalist.co.il", "tapuz.co.il"}},
+	{ SocialPlatform::Shopping,	{ "ebay.com", "amazon.com", "amazon.de", "skroutz.gr", "car.gr", "xe.gr", "mawdoo3.com", "aliexpress.com", "yad2.co.il",
+								  "zap.co.il", "next.co.il", "ksp.co.il"} },
+	{ SocialPlatform::Email,	{ "mail.ru", "live.com", "mail.google.com", "mail.yahoo.com" } },
+	{ SocialPlatform::Wikipedia,{ "wikipedia.org" } },
+	{ SocialPlatform::Facebook,	{ "facebook.com" } },
+	{ SocialPlatform::Linkedin,	{ "linkedin.com" } },
+	{ SocialPlatform::YouTube,	{ "youtube.com", "youtu.be" } },
+	{ SocialPlatform::Instagram,{ "instagram.com" } },
+	{ SocialPlatform::Twitter,	{ "twitter.com" } },
+	{ SocialPlatform::Google,	{ "google.com", "goog.le", "google.de", "google.gr", "google.co.il", "google.ps", "google.ru" } },
+	{ SocialPlatform::Yahoo,	{ "yahoo.com" } },
+	{ SocialPlatform::Ok,		{ "ok.ru" } },
+	{ SocialPlatform::Vk,		{ "vk.com" } },
+	{ SocialPlatform::Whatsapp, { "whatsapp.com" } }
+	
+};
+
+// Classify domain. Does return unknown when social platform cannot be determined
+inline SocialPlatform ClassifySocialPlatform(const std::string& rDomain)
+{
+	// Go over social identifiers and search for them in the domain
+	for (const auto& rPlatform : SocialIdentifiers) // go over platforms
+	{
+		for (const auto& rIdentifier : rPlatform.second) // go over identifiers
+		{
+			if (rDomain.find(rIdentifier) != std::string::npos) // search for identifier
+			{
+				return rPlatform.first; // found the platform
+			}
+		}
+	}
+	return SocialPlatform::Unknown;
+}
+
+#endif // SOCIALPLATFORM_H_
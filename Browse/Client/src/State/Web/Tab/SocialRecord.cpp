@@ -6,10 +6,12 @@
 #include "SocialRecord.h"
 #include "src/Utils/Helper.h"
 #include <sstream>
+#include <iomanip>
+#include <limits>
 
 using json = nlohmann::json;
 
-SocialRecord::SocialRecord(std::string domain, SocialPlatform platform, int startIndex) : _domain(domain), _platform(platform), _startIndex(startIndex) {}
+SocialRecord::SocialRecord(std::string domain, SocialPlatform platform, int startIndex) : _domain(domain), _platform(platform), _events(setup::SOCIAL_RECORD_MAX_EVENTS), _startIndex(startIndex) {}
 
 SocialRecord::~SocialRecord() {}
 
@@ -66,18 +68,19 @@ void SocialRecord::Persist()
 		return;
 	}
 
-	// Convert record to JSON
-	auto record = ToJSON(); 
+	// Keep record alive until mailer has serialized it
+	std::shared_ptr<const SocialRecord> spRecord = shared_from_this();
 
 	// Get keys of Firebase
 	FirebaseIntegerKey countKey;
 	FirebaseJSONKey recordKey;
 	std::tie(countKey, recordKey) = SocialFirebaseKeys.at(_platform);
 
-	// Persist
-	std::promise<int> sessionPromise; auto sessionFuture = sessionPromise.get_future(); // prepare to get value
-	bool pushedBack = FirebaseMailer::Instance().PushBack_Transform(countKey, 1, &sessionPromise); // adds one to the count
-	if (pushedBack) { FirebaseMailer::Instance().PushBack_Put(recordKey, record, "sessions/" + std::to_string(sessionFuture.get() - 1)); } // send JSON to database
+	// Persist, record is put after count has been increased by the mailer
+	FirebaseMailer::Instance().PushBack_Transform(countKey, 1, [recordKey, spRecord](int sessionCount) // adds one to the count
+	{
+		FirebaseMailer::Instance().PushBack_PutSerialized(recordKey, [spRecord](std::ostream& rStream) { spRecord->Serialize(rStream); }, "sessions/" + std::to_string(sessionCount - 1)); // send JSON to database
+	});
 }
 
 void SocialRecord::AddTimeInForeground(float time)
@@ -107,12 +110,20 @@ void SocialRecord::AddAutomaticScrollingDelta(float delta)
 
 void SocialRecord::AddClick(std::string tag, std::string id, float x, float y)
 {
-	if (_writeable) { _pages.back().clicks.push_back(Click(tag, id, x, y, std::chrono::duration<double>(std::chrono::system_clock::now() - _startTime).count())); }
+	if (_writeable)
+	{
+		_pages.back().clickCount++;
+		_events.AddClick((unsigned int)_pages.size() - 1, tag, id, x, y, std::chrono::duration<double>(std::chrono::system_clock::now() - _startTime).count());
+	}
 }
 
 void SocialRecord::AddTextInput(std::string tag, std::string id, int charCount, int charDistance, float x, float y, float duration)
 {
-	if (_writeable) { _pages.back().textInputs.push_back(TextInput(tag, id, charCount, charDistance, x, y, std::chrono::duration<double>(std::chrono::system_clock::now() - _startTime).count(), duration)); }
+	if (_writeable)
+	{
+		_pages.back().textInputCount++;
+		_events.AddTextInput((unsigned int)_pages.size() - 1, tag, id, charCount, charDistance, x, y, std::chrono::duration<double>(std::chrono::system_clock::now() - _startTime).count(), duration);
+	}
 }
 
 void SocialRecord::AddPage(std::string URL, std::string keywords)
@@ -131,73 +142,89 @@ void SocialRecord::AddPage(std::string URL, std::string keywords)
 	}
 }
 
-nlohmann::json SocialRecord::ToJSON() const
+void SocialRecord::Serialize(std::ostream& rStream) const
 {
-	// Domain JSON structure
-	json JSON = {
-		{ "domain", GetDomain() },
-		{ "startDate", _startDate },
-		{ "endDate", _endDate },
-		{ "startTimestamp", _startTimestamp },
-		{ "endTimestamp", _endTimestamp },
-		{ "duration", std::chrono::duration<float>(_endTime-_startTime).count() },
-		{ "durationInForeground", _totalDurationInForeground },
-		{ "durationUserActive", _totalDurationUserActive },
-		{ "durationEmulatedInput", _totalDurationEmulatedInput },
-		{ "pageCount", _pages.size() },
-		{ "startIndex" , _startIndex}
-	};
-
-	// Add pages to JSON structure
-	std::vector<json> pagesJSON;
-	for (const auto& rPage : _pages)
+	// Strings are escaped by JSON library, everything else is written directly
+	auto string = [](const std::string& rValue) { return json(rValue).dump(); };
+	auto coord = [&](float x, float y) { return string(std::to_string(x) + ", " + std::to_string(y)); };
+	rStream << std::setprecision(std::numeric_limits<double>::max_digits10);
+
+	// Domain
+	rStream << "{"
+		<< "\"domain\":" << string(GetDomain())
+		<< ",\"startDate\":" << string(_startDate)
+		<< ",\"endDate\":" << string(_endDate)
+		<< ",\"startTimestamp\":" << string(_startTimestamp)
+		<< ",\"endTimestamp\":" << string(_endTimestamp)
+		<< ",\"duration\":" << std::chrono::duration<float>(_endTime - _startTime).count()
+		<< ",\"durationInForeground\":" << _totalDurationInForeground
+		<< ",\"durationUserActive\":" << _totalDurationUserActive
+		<< ",\"durationEmulatedInput\":" << _totalDurationEmulatedInput
+		<< ",\"pageCount\":" << _pages.size()
+		<< ",\"startIndex\":" << _startIndex
+		<< ",\"droppedEventCount\":" << _events.GetDroppedCount();
+
+	// Pages, events of each page follow each other in log
+	if (!_pages.empty())
 	{
-		JSON["pages"].push_back(
-		{
-			{ "url",  rPage.URL },
-			{ "keywords",  rPage.keywords },
-			{ "duration", rPage.duration },
-			{ "durationInForeground",  rPage.durationInForeground },
-			{ "durationUserActive",  rPage.durationUserActive },
-			{ "durationEmulatedInput", rPage.durationEmulatedInput },
-			{ "manualScrollAmount",  rPage.manualScrollAmount },
-			{ "automaticScrollAmount",  rPage.automaticScrollAmount },
-			{ "clickCount",  rPage.clicks.size() },
-			{ "textInputCount",  rPage.textInputs.size() }
-		});
-
-		// Add clicks to JSON structure of page
-		for (const auto& rClick : rPage.clicks)
+		rStream << ",\"pages\":[";
+		unsigned int eventIndex = 0;
+		for (unsigned int i = 0; i < (unsigned int)_pages.size(); i++)
 		{
-			JSON["pages"].back()["clicks"].push_back(
+			const Page& rPage = _pages[i];
+			rStream << (i > 0 ? "," : "") << "{"
+				<< "\"url\":" << string(rPage.URL)
+				<< ",\"keywords\":" << string(rPage.keywords)
+				<< ",\"duration\":" << rPage.duration
+				<< ",\"durationInForeground\":" << rPage.durationInForeground
+				<< ",\"durationUserActive\":" << rPage.durationUserActive
+				<< ",\"durationEmulatedInput\":" << rPage.durationEmulatedInput
+				<< ",\"manualScrollAmount\":" << rPage.manualScrollAmount
+				<< ",\"automaticScrollAmount\":" << rPage.automaticScrollAmount
+				<< ",\"clickCount\":" << rPage.clickCount
+				<< ",\"textInputCount\":" << rPage.textInputCount;
+
+			// Range of events of page
+			const unsigned int begin = eventIndex;
+			while (eventIndex < _events.GetCount() && _events.GetPage(eventIndex) == i) { eventIndex++; }
+
+			// Clicks
+			bool first = true;
+			for (unsigned int j = begin; j < eventIndex; j++)
 			{
-				{ "tag", rClick.tag },
-				{ "id", rClick.id },
-				{ "coord", std::to_string(rClick.x) + ", " + std::to_string(rClick.y) },
-				{ "time", rClick.time }
+				if (_events.GetType(j) != SocialEventLog::Type::CLICK) { continue; }
+				rStream << (first ? ",\"clicks\":[" : ",") << "{"
+					<< "\"tag\":" << string(_events.GetTag(j))
+					<< ",\"id\":" << string(_events.GetId(j))
+					<< ",\"coord\":" << coord(_events.GetX(j), _events.GetY(j))
+					<< ",\"time\":" << _events.GetTime(j)
+					<< "}";
+				first = false;
 			}
-			);
-		}
+			if (!first) { rStream << "]"; }
 
-		// Add text inputs to JSON structure of page
-		for (const auto& rTextInput : rPage.textInputs)
-		{
-			JSON["pages"].back()["textInputs"].push_back(
+			// Text inputs
+			first = true;
+			for (unsigned int j = begin; j < eventIndex; j++)
 			{
-				{ "tag", rTextInput.tag },
-				{ "id", rTextInput.id },
-				{ "charCount", rTextInput.charCount },
-				{ "charDistance", rTextInput.charDistance },
-				{ "coord", std::to_string(rTextInput.x) + ", " + std::to_string(rTextInput.y) },
-				{ "time", rTextInput.time },
-				{ "duration", rTextInput.duration }
+				if (_events.GetType(j) != SocialEventLog::Type::TEXT_INPUT) { continue; }
+				rStream << (first ? ",\"textInputs\":[" : ",") << "{"
+					<< "\"tag\":" << string(_events.GetTag(j))
+					<< ",\"id\":" << string(_events.GetId(j))
+					<< ",\"charCount\":" << _events.GetCharCount(j)
+					<< ",\"charDistance\":" << _events.GetCharDistance(j)
+					<< ",\"coord\":" << coord(_events.GetX(j), _events.GetY(j))
+					<< ",\"time\":" << _events.GetTime(j)
+					<< ",\"duration\":" << _events.GetDuration(j)
+					<< "}";
+				first = false;
 			}
-			);
+			if (!first) { rStream << "]"; }
+			rStream << "}";
 		}
+		rStream << "]";
 	}
-
-	// Return result
-	return JSON;
+	rStream << "}";
 }
 
 std::string SocialRecord::PrecedeZeros(const std::string& rInput, const int digitCount) const
@@ -2,45 +2,21 @@
 // Distributed under the Apache License, Version 2.0.
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
-// Structure to hold a social record, for example a Facebook visit.
+// Structure to hold a social record, for example a Facebook visit. Clicks and
+// text inputs are kept in a compact event log. Once ended, record is only read
+// and serialized to JSON on the thread of the mailer when persisted.
 
 #ifndef SOCIALRECORD_H_
 #define SOCIALRECORD_H_
 
 #include "src/Utils/Helper.h"
+#include "src/State/Web/Tab/SocialPlatform.h"
+#include "src/State/Web/Tab/SocialEventLog.h"
 #include "src/Singletons/FirebaseMailer.h"
-#include "submodules/json/src/json.hpp"
 #include <string>
 #include <chrono>
-
-// List of social platforms (mind the order)
-enum class SocialPlatform
-{
-	Unknown, News, Shopping, Email, Wikipedia, Facebook, Linkedin, YouTube, Instagram, Twitter, Google, Yahoo, Ok, Vk, Whatsapp // Email does not include GMail!
-};
-
-// List of identifying domain parts for social platforms (mind the order)
-static const std::map < SocialPlatform, std::vector<std::string> > SocialIdentifiers =
-{
-	{ SocialPlatform::News,		{ "reddit.com", "msn.com", "protothema.gr", "sport24.gr", "gazzetta.gr", "newsit.gr", "iefimerida.gr", "news247.gr",
-								  "newsbomb.gr", "ynet.co.il", "walla.co.il", "mako.co.il", "sport5.co.il", "haaretz.co.il", "globes.co.il", "one.co.il",
-								  "calcalist.co.il", "tapuz.co.il"}},
-	{ SocialPlatform::Shopping,	{ "ebay.com", "amazon.com", "amazon.de", "skroutz.gr", "car.gr", "xe.gr", "mawdoo3.com", "aliexpress.com", "yad2.co.il",
-								  "zap.co.il", "next.co.il", "ksp.co.il"} },
-	{ SocialPlatform::Email,	{ "mail.ru", "live.com", "mail.google.com", "mail.yahoo.com" } },
-	{ SocialPlatform::Wikipedia,{ "wikipedia.org" } },
-	{ SocialPlatform::Facebook,	{ "facebook.com" } },
-	{ SocialPlatform::Linkedin,	{ "linkedin.com" } },
-	{ SocialPlatform::YouTube,	{ "youtube.com", "youtu.be" } },
-	{ SocialPlatform::Instagram,{ "instagram.com" } },
-	{ SocialPlatform::Twitter,	{ "twitter.com" } },
-	{ SocialPlatform::Google,	{ "google.com", "goog.le", "google.de", "google.gr", "google.co.il", "google.ps", "google.ru" } },
-	{ SocialPlatform::Yahoo,	{ "yahoo.com" } },
-	{ SocialPlatform::Ok,		{ "ok.ru" } },
-	{ SocialPlatform::Vk,		{ "vk.com" } },
-	{ SocialPlatform::Whatsapp, { "whatsapp.com" } }
-	
-};
+#include <memory>
+#include <ostream>
 
 // Mapping from platform to database keys (pair of count and record key)
 static const std::map <SocialPlatform, std::pair<FirebaseIntegerKey, FirebaseJSONKey> > SocialFirebaseKeys =
@@ -62,8 +38,8 @@ static const std::map <SocialPlatform, std::pair<FirebaseIntegerKey, FirebaseJSO
 	{ SocialPlatform::Whatsapp,	std::make_pair(FirebaseIntegerKey::PAGE_ACTIVITY_WHATSAPP_COUNT,	FirebaseJSONKey::PAGE_ACTIVITY_WHATSAPP) },
 };
 
-// Class of social record
-class SocialRecord
+// Class of social record, must be owned by shared pointer to be persisted
+class SocialRecord : public std::enable_shared_from_this<SocialRecord>
 {
 public:
 
@@ -76,25 +52,7 @@ public:
 	// Static function to classify current URL. Does return unknown when social platform cannot be determined
 	static SocialPlatform ClassifyURL(std::string URL)
 	{
-		// Extract domain
-		const std::string domain = ExtractDomain(URL);
-
-		// Go over social identifiers and search for them in the domain
-		SocialPlatform platform = SocialPlatform::Unknown;
-		for (const auto& rPlatform : SocialIdentifiers) // go over platforms
-		{
-			for (const auto& rIdentifier : rPlatform.second) // go over identifiers
-			{
-				if (domain.find(rIdentifier) != std::string::npos) // search for identifier
-				{
-					platform = rPlatform.first; // found the platform
-					return platform; // instead of break
-				}
-			}
-		}
-
-		// Return result
-		return platform;
+		return ClassifySocialPlatform(ExtractDomain(URL));
 	}
 
 	// Constructor
@@ -109,7 +67,7 @@ public:
 	// End record
 	void End();
 
-	// Persist record (sends it to Firebase)
+	// Persist record (sends it to Firebase). Record must not be changed afterwards
 	void Persist();
 
 	// Add time in foreground
@@ -134,8 +92,8 @@ public:
 	// Add page
 	void AddPage(std::string URL, std::string keywords);
 
-	// Convert to JSON for storing in database
-	nlohmann::json ToJSON() const;
+	// Write as JSON for storing in database, streamed without building a JSON structure
+	void Serialize(std::ostream& rStream) const;
 
 	// Get platform
 	SocialPlatform GetPlatform() const { return _platform; }
@@ -145,37 +103,6 @@ public:
 
 private:
 
-	// Struct for click record
-	struct Click
-	{
-		// Constructor
-		Click(std::string tag, std::string id, float x, float y, double time) : tag(tag), id(id), x(x), y(y), time(time) {}
-
-		// Fields
-		const std::string tag;
-		const std::string id;
-		const float x;
-		const float y;
-		const double time;
-	};
-
-	// Struct for text input record
-	struct TextInput
-	{
-		// Constructor
-		TextInput(std::string tag, std::string id, int charCount, int charDistance, float x, float y, double time, float duration) : tag(tag), id(id), charCount(charCount), charDistance(charDistance), x(x), y(y), time(time), duration(duration) {}
-
-		// Fields
-		const std::string tag;
-		const std::string id;
-		const int charCount = 0;
-		const int charDistance = 0;
-		const float x;
-		const float y;
-		const double time;
-		const float duration;
-	};
-
 	// Struct for page record
 	struct Page
 	{
@@ -191,8 +118,8 @@ private:
 		double durationEmulatedInput = 0.0; // duration of emulated input while in foreground
 		double manualScrollAmount = 0.0;
 		double automaticScrollAmount = 0.0;
-		std::vector<Click> clicks;
-		std::vector<TextInput> textInputs;
+		unsigned int clickCount = 0; // includes clicks dropped by event log
+		unsigned int textInputCount = 0; // includes text inputs dropped by event log
 	};
 
 	// Get numbering with preceding zeros
@@ -213,6 +140,7 @@ private:
 	double _totalDurationUserActive = 0.0; // and tab in foreground
 	double _totalDurationEmulatedInput = 0.0;
 	std::vector<Page> _pages; // should have at least one element and current one is at back
+	SocialEventLog _events; // clicks and text inputs of all pages, ordered by page
 	int _startIndex = -1;
 };
 
@@ -25,6 +25,10 @@
 #include "src/State/Web/WebTabInterface.h"
 #include "src/CEF/Data/DOMNode.h"
 #include "src/State/Web/Tab/WebView.h"
+#include "src/State/Web/Tab/ScrollPrediction.h"
+#include "src/State/Web/Tab/ScrollController.h"
+#include "src/State/Web/Tab/RenderScaleController.h"
+#include "src/State/Web/Tab/LinkWarmer.h"
 #include "src/State/Web/Tab/Pipelines/Pipeline.h"
 #include "src/State/Web/Tab/Triggers/TextInputTrigger.h"
 #include "src/State/Web/Tab/Triggers/SelectFieldTrigger.h"
@@ -32,6 +36,7 @@
 #include "src/Utils/glmWrapper.h"
 #include "src/Input/Input.h"
 #include "src/Global.h"
+#include "src/Setup.h"
 #include "src/State/Web/Tab/Pipelines/PointingEvaluationPipeline.h"
 #include "submodules/eyeGUI/include/eyeGUI.h"
 #include <vector>
@@ -41,6 +46,7 @@
 #include <map>
 #include <set>
 #include <future>
+#include <chrono>
 
 // Forward declaration
 class Master;
@@ -100,6 +106,26 @@ public:
 	// Get last time per frame
 	float GetLastTimePerFrame() const { return _lastTimePerFrame; }
 
+	// Get reason for current scale at which CEF paints web view
+	std::string GetWebRenderScaleReason() const { return _renderScaleController.GetReason(); }
+
+	// Discard browser, DOM nodes and triggers of inactive Tab and keep only a snapshot. Tab is
+	// restored from snapshot when activated or when URL is opened. Tabs whose state would be
+	// lost, like media, open dialogs or entered text, are kept. Returns whether discarded
+	bool Discard();
+
+	// Whether Tab is discarded
+	bool IsDiscarded() const { return _upSnapshot != nullptr; }
+
+	// Seconds since Tab has been deactivated, zero while active
+	float GetIdleDuration() const;
+
+	// Get thumbnail of discarded Tab in RGBA. Returns whether Tab is discarded
+	bool GetSnapshotThumbnail(int& rWidth, int& rHeight, std::vector<unsigned char>& rData) const;
+
+	// Get short info about memory freed by discarding or latency of last restore, may be empty
+	std::string GetDiscardInfo() const;
+
 	// Pause data transfer
 	void SetDataTransfer(bool active);
 
@@ -367,6 +393,12 @@ public:
     // Tell CEF callback which resolution web view texture should have
     virtual void GetWebRenderResolution(int& rWidth, int& rHeight) const;
 
+	// Tell CEF callback at which scale web view texture is painted
+	virtual float GetWebRenderScale() const { return _renderScaleController.GetScale(); }
+
+	// Receive paint of web view with its size and costs in milliseconds
+	virtual void ReportPaint(int width, int height, double paintDuration, double uploadDuration);
+
     // Getter and setter for favicon URL
     virtual std::string GetFavIconURL() const { return _favIconUrl; }
     virtual void SetFavIconURL(std::string url) { _favIconUrl = url; }
@@ -381,7 +413,7 @@ public:
 
     // Receive favicon bytes as char vector ordered in RGBA. Accepts also NULL for upData!
     virtual void ReceiveFaviconBytes(std::unique_ptr< std::vector<unsigned char> > upData, int width, int height);
-    virtual void ResetFaviconBytes(); // TODO
+    virtual void ResetFaviconBytes(std::string URL); // applies cached favicon of domain, if available
 
     // Get weak pointer to texture of web view
     virtual std::weak_ptr<Texture> GetWebViewTexture() { return _upWebView->GetTexture(); }
@@ -597,6 +629,9 @@ private:
 	// End social record and send to database
 	void EndSocialRecord();
 
+	// Rebuild browser of discarded Tab. Loads URL of snapshot when no other URL is given
+	void Restore(std::string URL = "");
+
     // Method to update and pipe accent color to eyeGUI
     void UpdateAccentColor(float tpf);
 
@@ -606,6 +641,15 @@ private:
 	// Unique name for favicon which is stored in eyeGUI
 	std::string GetFaviconIdentifier() const;
 
+	// Feed wheel delta into prediction of scrolling offset
+	void PredictScrolling(double deltaX, double deltaY);
+
+	// Scroll overflow elements gazed upon via their scroll controllers
+	void UpdateOverflowScrolling(const TabInput& rTabInput);
+
+	// Preconnect and prefetch link under fixation
+	void UpdateLinkWarming(float tpf, const TabInput& rTabInput);
+
 	
 	
 
@@ -732,6 +776,22 @@ private:
     double _scrollingOffsetX = 0;
     double _scrollingOffsetY = 0;
 
+	// Prediction of scroll offset from wheel deltas, used to shift page before CEF repaints it
+	ScrollPrediction _scrollPrediction;
+
+	// Scrolling of page and overflow elements, coalescing per frame updates into scroll events
+	ScrollController _pageScrollController = ScrollController(TAB_SCROLLING_EVENT_RATE);
+
+	// Scale at which CEF paints web view, adapted to costs of painting
+	RenderScaleController _renderScaleController = RenderScaleController(setup::WEB_VIEW_RENDER_SCALE_MIN, setup::WEB_VIEW_RENDER_SCALE_MAX);
+
+	// Warming of links under fixation
+	LinkWarmer _linkWarmer;
+	std::map<int, ScrollController> _overflowScrollControllers; // only for elements currently scrolled
+	float _scrollingSensorVelocity = 0.f; // pixels per second, set by sensors for one frame
+	uint64_t _overflowScrollEventCount = 0; // of removed controllers
+	uint64_t _overflowScrollUpdateCount = 0; // of removed controllers
+
     // Can go back / forward
     bool _canGoBack = false;
     bool _canGoForward = false;
@@ -748,6 +808,12 @@ private:
 	// Boolean which indicates whether (at least some) favicon is loaded to eyeGUI
 	bool _faviconLoaded = false;
 
+	// Domain of page the favicon belongs to, used as key in favicon cache
+	std::string _faviconDomain;
+
+	// Whether favicon has been taken from cache and is recent enough to skip download
+	bool _faviconFromFreshCache = false;
+
 	// Saves current state of icon
 	IconState _iconState;
 
@@ -781,6 +847,9 @@ private:
 	// Marker whether a keyboard is currently active
 	bool _keyboardActive = false;
 
+	// Marker whether user has entered text into page since main frame started loading
+	bool _textInputSinceLoad = false;
+
 
 	// Marker for next received click to be triggered by user (used for social records)
 	bool _userTriggeredClick = false;
@@ -791,6 +860,28 @@ private:
 	// Polling partition index
 	int _pollingPartitionIndex = 0;
 
+	// Snapshot of discarded Tab, which has no browser
+	struct Snapshot
+	{
+		std::string URL;
+		std::string title;
+		double scrollingOffsetX = 0;
+		double scrollingOffsetY = 0;
+		int thumbnailWidth = 0;
+		int thumbnailHeight = 0;
+		std::vector<unsigned char> thumbnail; // RGBA
+	};
+	std::unique_ptr<Snapshot> _upSnapshot = nullptr; // only set while discarded
+
+	// Discarding and restoring
+	std::chrono::steady_clock::time_point _deactivationTime = std::chrono::steady_clock::now();
+	std::chrono::steady_clock::time_point _restoreStartTime;
+	bool _restoring = false; // until main frame of restored page has loaded
+	double _restoreScrollingOffsetX = 0;
+	double _restoreScrollingOffsetY = 0;
+	size_t _discardedBytes = 0; // estimation of memory freed by last discard
+	double _restoreLatency = -1; // milliseconds of last restore, negative when not restored yet
+
 };
 
 #endif // TAB_H_
@@ -7,6 +7,7 @@
 #include "src/Utils/Texture.h"
 #include "src/Setup.h"
 #include "submodules/glm/glm/gtc/matrix_transform.hpp"
+#include <cmath>
 
 // Shaders
 const std::string vertexShaderSource =
@@ -150,7 +151,9 @@ void WebView::Draw(
 	int windowWidth,
 	int windowHeight,
 	double scrollingOffsetX,
-	double scrollingOffsetY) const
+	double scrollingOffsetY,
+	double scrollingShiftX,
+	double scrollingShiftY) const
 {
     // ### FILL FRAMEBUFFER ###
 
@@ -168,9 +171,11 @@ void WebView::Draw(
     // Bind texture with rendered web page
     _spTexture->Bind();
 
-    // Fill uniforms
+    // Fill uniforms. Shift in texture space reveals border color, which is drawn as white background
+	const float shiftU = (float)(scrollingShiftX / (double)GetResolutionX());
+	const float shiftV = (float)(scrollingShiftY / (double)GetResolutionY());
 	_upWebpageRenderItem->GetShader()->UpdateValue("position", glm::vec4(-1.f, -1.f, 1.f, 1.f)); // normalized device coordinates
-	_upWebpageRenderItem->GetShader()->UpdateValue("textureCoordinate", glm::vec4(0.f, 1.f, 1.f, 0.f)); // using texture coordinates to flip image in v direction
+	_upWebpageRenderItem->GetShader()->UpdateValue("textureCoordinate", glm::vec4(shiftU, 1.f + shiftV, 1.f + shiftU, shiftV)); // using texture coordinates to flip image in v direction
 	_upWebpageRenderItem->GetShader()->UpdateValue("dim", parameters.dim);
 
     // Draw webpage completely into framebuffer
@@ -192,11 +197,11 @@ void WebView::Draw(
         // Go over rects and render them
         for(Rect rect : _rects)
         {
-			// Move rect by scrolling
-			rect.left -= scrollingOffsetX;
-			rect.right -= scrollingOffsetX;
-			rect.bottom -= scrollingOffsetY;
-			rect.top -= scrollingOffsetY;
+			// Move rect by scrolling, including shift to stay on displayed page
+			rect.left -= scrollingOffsetX + scrollingShiftX;
+			rect.right -= scrollingOffsetX + scrollingShiftX;
+			rect.bottom -= scrollingOffsetY + scrollingShiftY;
+			rect.top -= scrollingOffsetY + scrollingShiftY;
 
 			// Scale from web view resolution to real one
 			rect.left = (rect.left / (float)GetResolutionX()) * (float)_width;
@@ -290,10 +295,10 @@ int WebView::GetHeight() const
 
 int WebView::GetResolutionX() const
 {
-	return _spTexture->GetWidth();
+	return (int)std::round(_spTexture->GetWidth() / _renderScale);
 }
 
 int WebView::GetResolutionY() const
 {
-	return _spTexture->GetHeight();
+	return (int)std::round(_spTexture->GetHeight() / _renderScale);
 }
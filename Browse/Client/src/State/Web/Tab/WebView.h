@@ -42,13 +42,15 @@ public:
         int width,
         int height);
 
-    // Draw
+    // Draw. Scrolling shift moves page texture for scrolling not yet painted by CEF
     void Draw(
 		const WebViewParameters& parameters,
 		int windowWidth,
 		int windowHeight,
 		double scrollingOffsetX,
-		double scrollingOffsetY) const;
+		double scrollingOffsetY,
+		double scrollingShiftX = 0.0,
+		double scrollingShiftY = 0.0) const;
 
     // Getter for weak pointer of texture
     std::weak_ptr<Texture> GetTexture();
@@ -66,6 +68,10 @@ public:
 	int GetResolutionX() const;
 	int GetResolutionY() const;
 
+	// Set scale at which CEF painted the texture. Resolution in CEFPixels is texture size divided by it
+	void SetRenderScale(float scale) { _renderScale = scale; }
+	float GetRenderScale() const { return _renderScale; }
+
 private:
 
     // Texture object which belongs here but filled by CEF and read maybe by other
@@ -85,6 +91,9 @@ private:
     // Vector with rects used for highlighting
     std::vector<Rect> _rects;
 
+	// Scale of painted texture relative to CEFPixels
+	float _renderScale = 1.f;
+
     // Framebuffer to render highlights etc on webpage and later zoom in
     std::unique_ptr<Framebuffer> _upFramebuffer;
 };
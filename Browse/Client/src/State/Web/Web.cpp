@@ -6,6 +6,7 @@
 #include "Web.h"
 #include "src/State/Web/Tab/Tab.h"
 #include "src/Master/Master.h"
+#include "src/Master/StartupPreload.h"
 #include "src/Global.h"
 #include "src/Utils/Helper.h"
 #include "src/Utils/Texture.h"
@@ -14,20 +15,24 @@
 #include "src/State/Web/Tab/Pipelines/Actions/Action.h"
 #include "src/State/Web/Tab/Pipelines/Actions/KeyboardAction.h"
 #include <algorithm>
+#include "src/Utils/PhraseMatcher.h"
 
 // Include singleton for mailing to JavaScript
 #include "src/Singletons/JSMailer.h"
 
-Web::Web(Master* pMaster, Mediator* pCefMediator, bool dataTransfer) : State(pMaster), _dataTransfer(dataTransfer)
+Web::Web(Master* pMaster, Mediator* pCefMediator, bool dataTransfer, StartupPreload& rPreload) : State(pMaster), _dataTransfer(dataTransfer)
 {
 	// Save member
 	_pCefMediator = pCefMediator;
 
-	// Create bookmark manager
-	_upBookmarkManager = std::unique_ptr<BookmarkManager>(new BookmarkManager(pMaster->GetUserDirectory()));
+	// Take bookmark manager, which has loaded bookmarks while CEF was initialized
+	_upBookmarkManager = rPreload.TakeBookmarkManager();
 
-	// Create hisotry manager
-	_upHistoryManager = std::unique_ptr<HistoryManager>(new HistoryManager(pMaster->GetUserDirectory()));
+	// Take history manager, same as bookmark manager
+	_upHistoryManager = rPreload.TakeHistoryManager();
+
+	// Take favicon cache, which has been read from disk meanwhile, too
+	_upFaviconCache = rPreload.TakeFaviconCache();
 
 	// Create History
 	_upHistory = std::unique_ptr<History>(new History(_pMaster, _upHistoryManager.get()));
@@ -481,6 +486,25 @@ StateType Web::Update(float tpf, const std::shared_ptr<const Input> spInput)
 		}
 	}
 
+	// Discard Tabs which have not been used for long
+	if (setup::TAB_DISCARDING)
+	{
+		_timeUntilDiscardCheck -= tpf;
+		if (_timeUntilDiscardCheck <= 0.f)
+		{
+			_timeUntilDiscardCheck = WEB_TAB_DISCARD_CHECK_INTERVAL;
+			for (const auto& rIdTabPair : _tabs)
+			{
+				if (rIdTabPair.first != _currentTabId
+					&& !rIdTabPair.second->IsDiscarded()
+					&& rIdTabPair.second->GetIdleDuration() > setup::TAB_DISCARD_IDLE_DURATION)
+				{
+					rIdTabPair.second->Discard();
+				}
+			}
+		}
+	}
+
 	// Only do it if there is some tab to update
 	if (_currentTabId >= 0 && _tabs.find(_currentTabId) != _tabs.end())
 	{
@@ -654,36 +678,46 @@ void Web::UpdateTabOverview()
 		// Register listener
 		eyegui::registerButtonListener(_pTabOverviewLayout, buttonId, _spWebButtonListener);
 
-		// Tell textblock the URL (but shorter version)
+		// Tell textblock the URL (but shorter version) and whether tab is discarded or how fast it was restored
 		std::string shortURL = ShortenURL(_tabs.at(tabId)->GetURL());
+		std::string discardInfo = _tabs.at(tabId)->GetDiscardInfo();
+		if (!discardInfo.empty()) { shortURL += " (" + discardInfo + ")"; }
 		eyegui::setContentOfTextBlock(_pTabOverviewLayout, textblockId, shortURL);
 
-		// Set webpage rendering as icon of button
+		// Resize tab if window was resized while it was in background
+		_pCefMediator->RefreshTab(_tabs.at(tabId).get());
+
+		// Set webpage rendering as icon of button, discarded tab provides thumbnail of snapshot
 		auto wpTexture = _tabs.at(tabId)->GetWebViewTexture();
-		if (auto spTexture = wpTexture.lock())
+		std::vector<unsigned char> tabPreviewData;
+		int tabPreviewWidth;
+		int tabPreviewHeight;
+		bool tabPreview = _tabs.at(tabId)->GetSnapshotThumbnail(tabPreviewWidth, tabPreviewHeight, tabPreviewData);
+		if (!tabPreview)
 		{
-			// Fetch pixel data of tab in higher mip map level
-			std::vector<unsigned char> tabPreviewData;
-			int tabPreviewWidth;
-			int tabPreviewHeight;
-			if (spTexture->GetPixelsFromMipMap(
-				WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL,
-				tabPreviewWidth,
-				tabPreviewHeight,
-				tabPreviewData))
+			if (auto spTexture = wpTexture.lock())
 			{
-				// Pipe it to eyeGUI
-				eyegui::setIconOfIconElement(
-					_pTabOverviewLayout,
-					buttonId,
-					buttonId + "_preview",
+				// Fetch pixel data of tab in higher mip map level
+				tabPreview = spTexture->GetPixelsFromMipMap(
+					WEB_TAB_OVERVIEW_MINI_PREVIEW_MIP_MAP_LEVEL,
 					tabPreviewWidth,
 					tabPreviewHeight,
-					eyegui::ColorFormat::RGBA,
-					tabPreviewData.data(),
-					true);
+					tabPreviewData);
 			}
 		}
+		if (tabPreview)
+		{
+			// Pipe it to eyeGUI
+			eyegui::setIconOfIconElement(
+				_pTabOverviewLayout,
+				buttonId,
+				buttonId + "_preview",
+				tabPreviewWidth,
+				tabPreviewHeight,
+				eyegui::ColorFormat::RGBA,
+				tabPreviewData.data(),
+				true);
+		}
 
 		// Styling
 		if (tabId == _currentTabId)
@@ -1108,49 +1142,6 @@ void Web::WebButtonListener::up(eyegui::Layout* pLayout, std::string id)
 }
 
 
-// levenshtein distance
-size_t Web::uiLevenshteinDistance(const std::string &s1, const std::string &s2)
-{
-	const size_t m(s1.size());
-	const size_t n(s2.size());
-
-	if (m == 0) return n;
-	if (n == 0) return m;
-
-	size_t *costs = new size_t[n + 1];
-
-	for (size_t k = 0; k <= n; k++) costs[k] = k;
-
-	size_t i = 0;
-	for (std::string::const_iterator it1 = s1.begin(); it1 != s1.end(); ++it1, ++i)
-	{
-		costs[0] = i + 1;
-		size_t corner = i;
-
-		size_t j = 0;
-		for (std::string::const_iterator it2 = s2.begin(); it2 != s2.end(); ++it2, ++j)
-		{
-			size_t upper = costs[j + 1];
-			if (*it1 == *it2)
-			{
-				costs[j + 1] = corner;
-			}
-			else
-			{
-				size_t t(upper < corner ? upper : corner);
-				costs[j + 1] = (costs[j] < t ? costs[j] : t) + 1;
-			}
-
-			corner = upper;
-		}
-	}
-
-	size_t result = costs[n];
-	delete[] costs;
-
-	return result;
-}
-
 void Web::actionsOfVoice(VoiceResult voiceResult, std::shared_ptr<Input> input) {
 	switch (voiceResult.action)
 	{
@@ -1352,42 +1343,49 @@ void Web::actionsOfVoice(VoiceResult voiceResult, std::shared_ptr<Input> input)
 			float gazeXOffset = input->gazeX - _tabs.at(tabId)->GetWebViewX();
 			LogInfo("gaze offset X:", gazeXOffset, " ,Y:", gazeYOffset);
 			std::vector<Tab::DOMLinkInfo> domLinkList = _tabs.at(tabId)->RetrieveDOMLinkInfos();
+			std::transform(voiceResult.keyworkds.begin(), voiceResult.keyworkds.end(), voiceResult.keyworkds.begin(), ::tolower);
+
+			// Text of link around gaze (gaze must be within threshold + the area of link) closest to the keywords has priority
+			// over nearest link. Links are queried once per command, so a linear scan is cheaper than precompiling a matcher.
+			// Bound of edit distance tightens with every better match
 			int levDisMax = 20;
+			bool textMatched = false;
+			float textLinkX = 0.f;
+			float textLinkY = 0.f;
 			float shortestDis = 50.f;
-			for (Tab::DOMLinkInfo link : domLinkList) {
-				std::vector<Rect> rectList = link.rects;
-				for (Rect rect : rectList) {
-					//get the lev distance between text of link and transcription
-					if (!voiceResult.keyworkds.empty()) {
-						std::transform(voiceResult.keyworkds.begin(), voiceResult.keyworkds.end(), voiceResult.keyworkds.begin(), ::tolower);
-						// gaze must be within (threshold  + the area of link )
-						if ((glm::abs(rect.top - gazeYOffset) < thresholdY || glm::abs(rect.bottom - gazeYOffset) < thresholdY) &&
-							(glm::abs(rect.right - gazeXOffset) < thresholdX || glm::abs(rect.left - gazeXOffset) < thresholdX)) {
-							std::string linktext = link.text;
-							std::transform(linktext.begin(), linktext.end(), linktext.begin(), ::tolower);
-							int levDis = uiLevenshteinDistance(voiceResult.keyworkds, linktext);
-							if (levDis < levDisMax && levDis != linktext.size()) {
-								LogInfo("shorter dis:", linktext, " . dis:", levDis, ", gazeoffset Y:", rect.Center().y, ", gazeoffset X:", rect.Center().x);
-								finalLinkY = rect.Center().y;
-								finalLinkX = rect.Center().x;
-								levDisMax = levDis;
-							}
+			for (const Tab::DOMLinkInfo& rLink : domLinkList) {
+				for (const Rect& rect : rLink.rects) {
+					if (!voiceResult.keyworkds.empty()
+						&& (glm::abs(rect.top - gazeYOffset) < thresholdY || glm::abs(rect.bottom - gazeYOffset) < thresholdY)
+						&& (glm::abs(rect.right - gazeXOffset) < thresholdX || glm::abs(rect.left - gazeXOffset) < thresholdX)) {
+						std::string linktext = rLink.text;
+						std::transform(linktext.begin(), linktext.end(), linktext.begin(), ::tolower);
+						int levDis = PhraseMatcher::BoundedDistance(voiceResult.keyworkds, linktext, levDisMax - 1);
+						if (levDis < levDisMax && levDis != (int)linktext.size()) {
+							LogInfo("shorter dis:", linktext, " . dis:", levDis, ", gazeoffset Y:", rect.Center().y, ", gazeoffset X:", rect.Center().x);
+							textLinkY = rect.Center().y;
+							textLinkX = rect.Center().x;
+							levDisMax = levDis;
+							textMatched = true;
 						}
 					}
+
 					//get the distance of link and gaze
-					if (levDisMax == 20) {
-						float dx = glm::max(glm::abs(gazeXOffset - rect.Center().x) - (rect.Width() / 2.f), 0.f);
-						float dy = glm::max(glm::abs(gazeYOffset - rect.Center().y) - (rect.Height() / 2.f), 0.f);
-						float distance = glm::sqrt((dx * dx) + (dy * dy));
-						if (shortestDis > distance) {
-							LogInfo("shorter dis:", distance,", gazeoffset Y:", rect.Center().y, ", gazeoffset X:", rect.Center().x);
-							finalLinkY = rect.Center().y;
-							finalLinkX = rect.Center().x;
-							shortestDis = distance;
-						}
+					float dx = glm::max(glm::abs(gazeXOffset - rect.Center().x) - (rect.Width() / 2.f), 0.f);
+					float dy = glm::max(glm::abs(gazeYOffset - rect.Center().y) - (rect.Height() / 2.f), 0.f);
+					float distance = glm::sqrt((dx * dx) + (dy * dy));
+					if (shortestDis > distance) {
+						finalLinkY = rect.Center().y;
+						finalLinkX = rect.Center().x;
+						shortestDis = distance;
 					}
 				}
 			}
+
+			if (textMatched) {
+				finalLinkY = textLinkY;
+				finalLinkX = textLinkX;
+			}
 			_tabs.at(tabId)->EmulateLeftMouseButtonClick(finalLinkX, finalLinkY - _tabs.at(tabId)->getScrollingOffsetY());
 		}
 	}break;
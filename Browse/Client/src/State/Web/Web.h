@@ -11,6 +11,7 @@
 #include "src/State/Web/Tab/Tab.h"
 #include "src/State/Web/Managers/BookmarkManager.h"
 #include "src/State/Web/Managers/HistoryManager.h"
+#include "src/State/Web/Managers/FaviconCache.h"
 #include "src/State/Web/Screens/URLInput.h"
 #include "src/State/Web/Screens/History.h"
 #include "src/Input/VoiceInput.h"
@@ -23,6 +24,7 @@
 
 // Forward declaration
 class Mediator;
+class StartupPreload;
 
 enum class WebPanelMode
 {
@@ -33,8 +35,8 @@ class Web : public State, public WebTabInterface
 {
 public:
 
-    // Constructor
-    Web(Master* pMaster, Mediator* pCefMediator, bool dataTransfer);
+    // Constructor, takes bookmarks and history from preload
+    Web(Master* pMaster, Mediator* pCefMediator, bool dataTransfer, StartupPreload& rPreload);
 
     // Destructor
     virtual ~Web();
@@ -105,8 +107,6 @@ public:
     // Get own id in web. Returns -1 if not found
     virtual int GetIdOfTab(Tab const * pCaller) const;
 
-	size_t uiLevenshteinDistance(const std::string & s1, const std::string & s2);
-
 	virtual void actionsOfVoice(VoiceResult voiceResult, std::shared_ptr<Input> input);
 
 	virtual void dictationOfVoice(std::string transcript);
@@ -116,6 +116,9 @@ public:
 	// Add history entry
 	virtual std::shared_ptr<HistoryManager::Page> AddPageToHistory(std::string URL, std::string title);
 
+	// Get cache of favicons
+	virtual FaviconCache* GetFaviconCache() { return _upFaviconCache.get(); }
+
 
 private:
 
@@ -213,6 +216,9 @@ private:
     // Tab overview page [0..PageCount-1]
     int _tabOverviewPage = 0;
 
+	// Time until Tabs are checked for discarding
+	float _timeUntilDiscardCheck = WEB_TAB_DISCARD_CHECK_INTERVAL;
+
     // Pointer to mediator
     Mediator* _pCefMediator;
 
@@ -228,6 +234,9 @@ private:
 	// History manager
 	std::unique_ptr<HistoryManager> _upHistoryManager;
 
+	// Favicon cache
+	std::unique_ptr<FaviconCache> _upFaviconCache;
+
 	// History object
 	std::unique_ptr<History> _upHistory;
 
@@ -11,6 +11,7 @@
 #define WEBTABINTERFACE_H_
 
 #include "src/State/Web/Managers/HistoryManager.h"
+#include "src/State/Web/Managers/FaviconCache.h"
 #include <string>
 
 class Tab;
@@ -27,6 +28,9 @@ public:
 
 	// Add history entry
 	virtual std::shared_ptr<HistoryManager::Page> AddPageToHistory(std::string URL, std::string title) = 0;
+
+	// Get cache of favicons. Only to be used from main thread
+	virtual FaviconCache* GetFaviconCache() = 0;
 };
 
 #endif // WEBTABINTERFACE_H_
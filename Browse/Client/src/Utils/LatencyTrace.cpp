@@ -0,0 +1,203 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "LatencyTrace.h"
+#include <fstream>
+#include <algorithm>
+
+LatencyTrace::LatencyTrace(unsigned int frameCount) :
+	_origin(std::chrono::steady_clock::now()),
+	_frames(std::max(frameCount, 1u))
+{
+	// Nothing to do
+}
+
+void LatencyTrace::BeginFrame()
+{
+	_current = FrameRecord();
+	_current.index = _frameCount;
+	std::fill(_current.phaseStart, _current.phaseStart + (int)Phase::COUNT, (int64_t)-1);
+	std::fill(_current.phaseDuration, _current.phaseDuration + (int)Phase::COUNT, (int64_t)0);
+	_currentPhase = -1;
+	BeginPhase(Phase::JOBS);
+}
+
+void LatencyTrace::BeginPhase(Phase phase)
+{
+	const int64_t now = Now();
+	if (_currentPhase >= 0)
+	{
+		_current.phaseDuration[_currentPhase] += now - _currentPhaseStart;
+	}
+	_currentPhase = (int)phase;
+	_currentPhaseStart = now;
+	if (_current.phaseStart[_currentPhase] < 0) // phase entered multiple times keeps first start and sums durations
+	{
+		_current.phaseStart[_currentPhase] = now;
+	}
+}
+
+void LatencyTrace::SetSample(std::chrono::milliseconds sampleTimestamp, std::chrono::milliseconds filterTimestamp)
+{
+	_current.hasSample = true;
+	_current.sampleTimestamp = sampleTimestamp;
+	_current.sampleAgeAtFilter = (float)(filterTimestamp - sampleTimestamp).count();
+}
+
+void LatencyTrace::MarkGUIUpdate()
+{
+	_current.sampleAgeAtGUIUpdate = SampleAge();
+}
+
+void LatencyTrace::EndFrame()
+{
+	// Close last phase
+	if (_currentPhase >= 0)
+	{
+		_current.phaseDuration[_currentPhase] += Now() - _currentPhaseStart;
+		_currentPhase = -1;
+	}
+	_current.sampleAgeAtSwap = SampleAge();
+
+	// Store in ring buffer, overwriting oldest record
+	_frames[_frameCount % _frames.size()] = _current;
+	++_frameCount;
+}
+
+bool LatencyTrace::Dump(std::string filepath) const
+{
+	std::ofstream file(filepath);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Go over records from oldest to newest
+	file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	const uint64_t recordCount = std::min(_frameCount, (uint64_t)_frames.size());
+	for (uint64_t i = _frameCount - recordCount; i < _frameCount; i++)
+	{
+		const FrameRecord& rFrame = _frames[i % _frames.size()];
+
+		// Frame spanning all its phases
+		int64_t frameStart = -1;
+		int64_t frameEnd = -1;
+		for (int j = 0; j < (int)Phase::COUNT; j++)
+		{
+			if (rFrame.phaseStart[j] < 0) { continue; }
+			frameStart = frameStart < 0 ? rFrame.phaseStart[j] : std::min(frameStart, rFrame.phaseStart[j]);
+			frameEnd = std::max(frameEnd, rFrame.phaseStart[j] + rFrame.phaseDuration[j]);
+		}
+		if (frameStart < 0) { continue; }
+		file << (first ? "" : ",") << "\n{\"name\":\"Frame\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << frameStart
+			<< ",\"dur\":" << (frameEnd - frameStart) << ",\"args\":{\"index\":" << rFrame.index << "}}";
+		first = false;
+
+		// Phases
+		for (int j = 0; j < (int)Phase::COUNT; j++)
+		{
+			if (rFrame.phaseStart[j] < 0) { continue; }
+			file << ",\n{\"name\":\"" << PhaseName((Phase)j) << "\",\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << rFrame.phaseStart[j]
+				<< ",\"dur\":" << rFrame.phaseDuration[j] << "}";
+		}
+
+		// Age of sample as counter, so it is plotted over time
+		if (rFrame.hasSample)
+		{
+			file << ",\n{\"name\":\"Sample age (ms)\",\"ph\":\"C\",\"pid\":1,\"ts\":" << frameStart
+				<< ",\"args\":{\"filter\":" << rFrame.sampleAgeAtFilter
+				<< ",\"gui update\":" << rFrame.sampleAgeAtGUIUpdate
+				<< ",\"swap\":" << rFrame.sampleAgeAtSwap << "}}";
+		}
+	}
+	file << "\n]}\n";
+	return file.good();
+}
+
+bool LatencyTrace::DumpSummary(std::string filepath) const
+{
+	std::ofstream file(filepath);
+	if (!file.is_open())
+	{
+		return false;
+	}
+
+	// Collect durations of frames and phases from records
+	const uint64_t recordCount = std::min(_frameCount, (uint64_t)_frames.size());
+	std::vector<std::vector<int64_t> > durations((int)Phase::COUNT + 1); // last is whole frame
+	for (auto& rDurations : durations) { rDurations.reserve((size_t)recordCount); }
+	for (uint64_t i = _frameCount - recordCount; i < _frameCount; i++)
+	{
+		const FrameRecord& rFrame = _frames[i % _frames.size()];
+		int64_t frameDuration = 0;
+		for (int j = 0; j < (int)Phase::COUNT; j++)
+		{
+			durations[j].push_back(rFrame.phaseDuration[j]);
+			frameDuration += rFrame.phaseDuration[j];
+		}
+		durations[(int)Phase::COUNT].push_back(frameDuration);
+	}
+
+	// Write statistics per phase
+	file << "{\n\"frames\": " << recordCount << ",\n\"phases\": {";
+	for (int j = 0; j <= (int)Phase::COUNT; j++)
+	{
+		std::vector<int64_t>& rDurations = durations[j];
+		std::sort(rDurations.begin(), rDurations.end());
+		double mean = 0, median = 0, p95 = 0, max = 0;
+		if (!rDurations.empty())
+		{
+			int64_t sum = 0;
+			for (int64_t duration : rDurations) { sum += duration; }
+			mean = (double)sum / rDurations.size() / 1000.0;
+			median = rDurations[rDurations.size() / 2] / 1000.0;
+			p95 = rDurations[std::min(rDurations.size() - 1, (size_t)(rDurations.size() * 0.95))] / 1000.0;
+			max = rDurations.back() / 1000.0;
+		}
+		file << (j == 0 ? "" : ",") << "\n\"" << (j == (int)Phase::COUNT ? "Frame" : PhaseName((Phase)j))
+			<< "\": {\"mean\": " << mean << ", \"median\": " << median << ", \"p95\": " << p95 << ", \"max\": " << max << "}";
+	}
+	file << "\n}\n}\n";
+	return file.good();
+}
+
+int64_t LatencyTrace::Now() const
+{
+	return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _origin).count();
+}
+
+float LatencyTrace::SampleAge() const
+{
+	if (!_current.hasSample)
+	{
+		return 0;
+	}
+	using namespace std::chrono;
+	return (float)(duration_cast<milliseconds>(system_clock::now().time_since_epoch()) - _current.sampleTimestamp).count();
+}
+
+const char* LatencyTrace::PhaseName(Phase phase)
+{
+	switch (phase)
+	{
+	case Phase::JOBS:
+		return "Jobs";
+	case Phase::EYE_INPUT:
+		return "Eye input";
+	case Phase::GUI_UPDATE:
+		return "GUI update";
+	case Phase::CEF_MESSAGE_LOOP:
+		return "CEF message loop";
+	case Phase::STATE_UPDATE:
+		return "State update";
+	case Phase::DRAW:
+		return "Draw";
+	case Phase::SWAP:
+		return "Swap";
+	default:
+		return "Unknown";
+	}
+}
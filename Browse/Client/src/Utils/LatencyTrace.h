@@ -0,0 +1,87 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Records per frame how long the phases of the main loop take and how old
+// the gaze sample used by the frame is at filtering, at GUI update and after
+// swapping buffers. Records are kept in a ring buffer and can be dumped in the
+// trace event format of Chrome (open with chrome://tracing). Only created when
+// tracing is requested, so main loop just checks for a null pointer otherwise.
+// A summary with statistics per phase is written for simulated scenarios.
+
+#ifndef LATENCYTRACE_H_
+#define LATENCYTRACE_H_
+
+#include <chrono>
+#include <vector>
+#include <string>
+#include <cstdint>
+
+class LatencyTrace
+{
+public:
+
+	// Phases of a frame, in order of execution. Each phase lasts until next one begins
+	enum class Phase
+	{
+		JOBS, EYE_INPUT, GUI_UPDATE, CEF_MESSAGE_LOOP, STATE_UPDATE, DRAW, SWAP, COUNT
+	};
+
+	// Constructor, takes count of frames kept in memory
+	LatencyTrace(unsigned int frameCount);
+
+	// Start new frame, which begins with first phase
+	void BeginFrame();
+
+	// Begin phase, ends the current one
+	void BeginPhase(Phase phase);
+
+	// Set timestamp of sample used in this frame and time of its filtering. Both since epoch of system clock
+	void SetSample(std::chrono::milliseconds sampleTimestamp, std::chrono::milliseconds filterTimestamp);
+
+	// Called after GUI has been updated with gaze
+	void MarkGUIUpdate();
+
+	// End frame, to be called after swapping buffers
+	void EndFrame();
+
+	// Write recorded frames as Chrome trace event file, returns whether successful
+	bool Dump(std::string filepath) const;
+
+	// Write statistics of recorded frames and their phases in milliseconds as JSON, returns whether successful
+	bool DumpSummary(std::string filepath) const;
+
+private:
+
+	// Record of one frame
+	struct FrameRecord
+	{
+		uint64_t index = 0;
+		int64_t phaseStart[(int)Phase::COUNT]; // microseconds since construction
+		int64_t phaseDuration[(int)Phase::COUNT]; // microseconds
+		std::chrono::milliseconds sampleTimestamp;
+		bool hasSample = false;
+		float sampleAgeAtFilter = 0; // milliseconds
+		float sampleAgeAtGUIUpdate = 0; // milliseconds
+		float sampleAgeAtSwap = 0; // milliseconds
+	};
+
+	// Microseconds since construction
+	int64_t Now() const;
+
+	// Age of sample of current frame in milliseconds
+	float SampleAge() const;
+
+	// Name of phase as shown in trace
+	static const char* PhaseName(Phase phase);
+
+	// Members
+	std::chrono::steady_clock::time_point _origin;
+	std::vector<FrameRecord> _frames; // ring buffer
+	uint64_t _frameCount = 0; // count of ended frames
+	FrameRecord _current;
+	int _currentPhase = -1;
+	int64_t _currentPhaseStart = 0;
+};
+
+#endif // LATENCYTRACE_H_
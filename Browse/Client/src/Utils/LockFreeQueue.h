@@ -0,0 +1,109 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Bounded queue for multiple writers and readers without locking. Each cell
+// carries a sequence number, which tells whether it may be written or read
+// for the current position, similar to the sample ring of the tracker host.
+// Capacity is rounded up to a power of two.
+
+#ifndef LOCKFREEQUEUE_H_
+#define LOCKFREEQUEUE_H_
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+
+template<typename T>
+class LockFreeQueue
+{
+public:
+
+	// Constructor
+	LockFreeQueue(size_t capacity)
+	{
+		size_t powerOfTwo = 2;
+		while (powerOfTwo < capacity) { powerOfTwo *= 2; }
+		_mask = powerOfTwo - 1;
+		_upCells = std::unique_ptr<Cell[]>(new Cell[powerOfTwo]);
+		for (size_t i = 0; i < powerOfTwo; i++)
+		{
+			_upCells[i].sequence.store(i, std::memory_order_relaxed);
+		}
+	}
+
+	// Push value. Returns false when queue is full, value is untouched then
+	bool TryPush(T& rValue)
+	{
+		size_t position = _pushPosition.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		while (true)
+		{
+			pCell = &_upCells[position & _mask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)position;
+			if (difference == 0) // cell is free for this position
+			{
+				if (_pushPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+			}
+			else if (difference < 0) // cell still holds value of previous round
+			{
+				return false;
+			}
+			else // other writer has been faster
+			{
+				position = _pushPosition.load(std::memory_order_relaxed);
+			}
+		}
+		pCell->value = std::move(rValue);
+		pCell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+	// Pop value. Returns false when queue is empty
+	bool TryPop(T& rValue)
+	{
+		size_t position = _popPosition.load(std::memory_order_relaxed);
+		Cell* pCell = nullptr;
+		while (true)
+		{
+			pCell = &_upCells[position & _mask];
+			const size_t sequence = pCell->sequence.load(std::memory_order_acquire);
+			const std::ptrdiff_t difference = (std::ptrdiff_t)sequence - (std::ptrdiff_t)(position + 1);
+			if (difference == 0) // cell has been written for this position
+			{
+				if (_popPosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) { break; }
+			}
+			else if (difference < 0) // nothing written, yet
+			{
+				return false;
+			}
+			else // other reader has been faster
+			{
+				position = _popPosition.load(std::memory_order_relaxed);
+			}
+		}
+		rValue = std::move(pCell->value);
+		pCell->sequence.store(position + _mask + 1, std::memory_order_release);
+		return true;
+	}
+
+private:
+
+	// Cell of queue
+	struct Cell
+	{
+		std::atomic<size_t> sequence;
+		T value;
+	};
+
+	// Cells
+	std::unique_ptr<Cell[]> _upCells;
+	size_t _mask = 0;
+
+	// Positions, on separate cache lines as written by different threads
+	alignas(64) std::atomic<size_t> _pushPosition { 0 };
+	alignas(64) std::atomic<size_t> _popPosition { 0 };
+};
+
+#endif // LOCKFREEQUEUE_H_
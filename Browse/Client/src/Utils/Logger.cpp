@@ -6,56 +6,207 @@
 #include "Logger.h"
 #include "src/Global.h"
 #include "src/Setup.h"
+#include "src/Utils/LockFreeQueue.h"
 #include "submodules/spdlog/include/spdlog/spdlog.h"
 #include <memory>
-
-// Shared pointer of global logger
-std::shared_ptr<spdlog::logger> GlobalLog;
+#include <thread>
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+#include <fstream>
 
 // Definition of logger path variable
 std::string LogPath;
 
-std::shared_ptr<spdlog::logger> Log()
+// Definition of threshold, debug records are only logged in debug mode
+std::atomic<int> LogThreshold((int)(setup::DEBUG_MODE ? LogLevel::DEBUG_LEVEL : LogLevel::INFO_LEVEL));
+
+namespace
 {
-    if (!GlobalLog) // check for null
-    {
-        // Create logger since there is no, yet
-        std::vector<spdlog::sink_ptr> sinks;
-        sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>());
-        sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(LogPath + LOG_FILE_NAME + ".txt", LOG_FILE_MAX_SIZE, LOG_FILE_COUNT));
-        GlobalLog = std::make_shared<spdlog::logger>("global_log", begin(sinks), end(sinks));
-        GlobalLog->set_pattern("[%D-%T.%e] %l: %v");
-
-		// Set logging level
-		if (setup::DEBUG_MODE)
+	// Record of text log
+	struct Record
+	{
+		LogLevel level = LogLevel::INFO_LEVEL;
+		std::chrono::system_clock::time_point time;
+		std::string content;
+	};
+
+	// Record of binary log
+	struct ValueRecord
+	{
+		int64_t timestamp; // microseconds since epoch
+		uint32_t channel;
+		float value;
+	};
+
+	// Writer of records on background thread. Created at first usage, so log path must be set before
+	class Writer
+	{
+	public:
+
+		// Constructor
+		Writer() : _records(LOG_QUEUE_CAPACITY), _values(LOG_QUEUE_CAPACITY)
+		{
+			// Create logger. Time and level are prepended by writer, as records are written delayed
+			std::vector<spdlog::sink_ptr> sinks;
+			sinks.push_back(std::make_shared<spdlog::sinks::stdout_sink_mt>());
+			sinks.push_back(std::make_shared<spdlog::sinks::rotating_file_sink_mt>(LogPath + LOG_FILE_NAME + ".txt", LOG_FILE_MAX_SIZE, LOG_FILE_COUNT));
+			_spLog = std::make_shared<spdlog::logger>("global_log", begin(sinks), end(sinks));
+			_spLog->set_pattern("%v");
+
+			// Open binary file for values
+			if (setup::LOG_DIAGNOSTICS)
+			{
+				_diagnostics.open(LogPath + DIAGNOSTICS_FILE_NAME + ".bin", std::ios::out | std::ios::binary | std::ios::trunc);
+				const char magic[4] = { 'G', 'T', 'W', 'D' };
+				const uint32_t version = 1;
+				_diagnostics.write(magic, sizeof(magic));
+				_diagnostics.write(reinterpret_cast<const char*>(&version), sizeof(version));
+			}
+
+			// Start thread
+			_thread = std::thread([this]()
+			{
+				while (!_stop.load())
+				{
+					Write();
+					std::this_thread::sleep_for(std::chrono::milliseconds(LOG_WRITER_INTERVAL));
+				}
+				Write(); // write what has been pushed until stop
+			});
+		}
+
+		// Destructor, writes remaining records
+		~Writer()
 		{
-			GlobalLog->set_level(spdlog::level::debug);
+			_stop = true;
+			_thread.join();
+			Closed = true;
 		}
-		else
+
+		// Push text record. Waits for writer when queue is full, so no record is lost
+		void Push(LogLevel level, const std::string& rContent)
+		{
+			Record record;
+			record.level = level;
+			record.time = std::chrono::system_clock::now();
+			record.content = rContent;
+			while (!_records.TryPush(record)) { std::this_thread::yield(); }
+		}
+
+		// Push value record. Dropped when queue is full, as values are of high rate
+		void Push(LogChannel channel, float value)
 		{
-			GlobalLog->set_level(spdlog::level::info);
+			ValueRecord record;
+			record.timestamp = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+			record.channel = (uint32_t)channel;
+			record.value = value;
+			_values.TryPush(record);
 		}
-    }
-    return GlobalLog;
+
+		// Whether writer has been destroyed at exit of program
+		static std::atomic<bool> Closed;
+
+	private:
+
+		// Write all records in queues
+		void Write()
+		{
+			// Text records
+			Record record;
+			bool written = false;
+			while (_records.TryPop(record))
+			{
+				// Prefix with local time and level
+				const std::time_t time = std::chrono::system_clock::to_time_t(record.time);
+				const int milliseconds = (int)(std::chrono::duration_cast<std::chrono::milliseconds>(record.time.time_since_epoch()).count() % 1000);
+				std::ostringstream stream;
+				stream << "[" << std::put_time(std::localtime(&time), "%m/%d/%y-%H:%M:%S") << "." << std::setfill('0') << std::setw(3) << milliseconds << "] ";
+				switch (record.level)
+				{
+				case LogLevel::DEBUG_LEVEL:
+					stream << "debug: ";
+					break;
+				case LogLevel::INFO_LEVEL:
+					stream << "info: ";
+					break;
+				case LogLevel::ERROR_LEVEL:
+					stream << "error: ";
+					break;
+				}
+				stream << record.content;
+				_spLog->info(stream.str());
+				written = true;
+			}
+			if (written) { _spLog->flush(); }
+
+			// Value records
+			ValueRecord value;
+			written = false;
+			while (_values.TryPop(value))
+			{
+				if (_diagnostics.is_open())
+				{
+					_diagnostics.write(reinterpret_cast<const char*>(&value.timestamp), sizeof(value.timestamp));
+					_diagnostics.write(reinterpret_cast<const char*>(&value.channel), sizeof(value.channel));
+					_diagnostics.write(reinterpret_cast<const char*>(&value.value), sizeof(value.value));
+					written = true;
+				}
+			}
+			if (written) { _diagnostics.flush(); }
+		}
+
+		// Queues
+		LockFreeQueue<Record> _records;
+		LockFreeQueue<ValueRecord> _values;
+
+		// Outputs, only used by thread
+		std::shared_ptr<spdlog::logger> _spLog;
+		std::ofstream _diagnostics;
+
+		// Thread
+		std::thread _thread;
+		std::atomic<bool> _stop { false };
+	};
+
+	std::atomic<bool> Writer::Closed { false };
+
+	// Get writer, created at first call
+	Writer* GetWriter()
+	{
+		static Writer writer;
+		return Writer::Closed.load() ? nullptr : &writer; // records at static destruction are dropped
+	}
 }
 
 void LogInfo(const std::string& content)
 {
-	Log()->info(content);
+	if (!IsLogged(LogLevel::INFO_LEVEL)) { return; }
+	if (Writer* pWriter = GetWriter()) { pWriter->Push(LogLevel::INFO_LEVEL, content); }
 }
 
 void LogError(const std::string& content)
 {
-	Log()->error(content);
+	if (!IsLogged(LogLevel::ERROR_LEVEL)) { return; }
+	if (Writer* pWriter = GetWriter()) { pWriter->Push(LogLevel::ERROR_LEVEL, content); }
 }
 
+#ifdef CLIENT_DEBUG
 void LogDebug(const std::string& content)
 {
-	Log()->debug(content);
+	if (!IsLogged(LogLevel::DEBUG_LEVEL)) { return; }
+	if (Writer* pWriter = GetWriter()) { pWriter->Push(LogLevel::DEBUG_LEVEL, content); }
 }
+#endif // CLIENT_DEBUG
 
 void LogBug(const std::string& content)
 {
-	Log()->error(content);
+	if (!IsLogged(LogLevel::ERROR_LEVEL)) { return; }
+	if (Writer* pWriter = GetWriter()) { pWriter->Push(LogLevel::ERROR_LEVEL, content); }
 }
 
+void LogValue(LogChannel channel, float value)
+{
+	if (!setup::LOG_DIAGNOSTICS) { return; }
+	if (Writer* pWriter = GetWriter()) { pWriter->Push(channel, value); }
+}
@@ -2,23 +2,43 @@
 // Distributed under the Apache License, Version 2.0.
 // Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
 //============================================================================
-// Abstraction of logger. Can be called from threads, too.
+// Abstraction of logger. Can be called from threads, too. Level is checked
+// before arguments are formatted and debug logging is compiled out unless
+// CLIENT_DEBUG is defined. Records are handed to a background writer through
+// a lock-free queue, which outputs them to console and rotating file. Values
+// of high rate, like per-frame diagnostics, go through a separate binary
+// channel into their own file.
 
 #ifndef LOGGER_H_
 #define LOGGER_H_
 
 #include <string>
 #include <sstream>
+#include <atomic>
+#include <cstdint>
 
 // Declaration of output path for log. Should be only set by main.cpp
 extern std::string LogPath;
 
+// Levels of records
+enum class LogLevel { DEBUG_LEVEL, INFO_LEVEL, ERROR_LEVEL }; // not named DEBUG or ERROR, which may be macros on some platforms
+
+// Minimum level of records which are logged
+extern std::atomic<int> LogThreshold;
+
+// Whether records of level are logged
+inline bool IsLogged(LogLevel level)
+{
+	return (int)level >= LogThreshold.load(std::memory_order_relaxed);
+}
+
 // LogInfo
 void LogInfo(const std::string& content);
 
 template<typename... Args>
 void LogInfo(Args const&... args)
 {
+	if (!IsLogged(LogLevel::INFO_LEVEL)) { return; }
     std::ostringstream stream;
     using List= int[];
     (void)List{0, ((void)(stream << args), 0) ... };
@@ -31,6 +51,7 @@ void LogError(const std::string& content);
 template<typename... Args>
 void LogError(Args const&... args)
 {
+	if (!IsLogged(LogLevel::ERROR_LEVEL)) { return; }
     std::ostringstream stream;
     using List= int[];
     (void)List{0, ((void)(stream << args), 0) ... };
@@ -38,16 +59,24 @@ void LogError(Args const&... args)
 }
 
 // LogDebug
+#ifdef CLIENT_DEBUG
 void LogDebug(const std::string& content);
 
 template<typename... Args>
 void LogDebug(Args const&... args)
 {
+	if (!IsLogged(LogLevel::DEBUG_LEVEL)) { return; }
     std::ostringstream stream;
     using List= int[];
     (void)List{0, ((void)(stream << args), 0) ... };
     LogDebug(stream.str());
 }
+#else
+inline void LogDebug(const std::string&) {}
+
+template<typename... Args>
+inline void LogDebug(Args const&...) {}
+#endif // CLIENT_DEBUG
 
 // LogBug
 void LogBug(const std::string& content);
@@ -55,10 +84,23 @@ void LogBug(const std::string& content);
 template<typename... Args>
 void LogBug(Args const&... args)
 {
+	if (!IsLogged(LogLevel::ERROR_LEVEL)) { return; }
     std::ostringstream stream;
     using List= int[];
     (void)List{0, ((void)(stream << args), 0) ... };
     LogBug(stream.str());
 }
 
+// Channels of binary log. Append only, values are stored in the file
+enum class LogChannel : uint32_t
+{
+	DRIFT_ANGLE = 0, // degrees between gaze and zoom coordinate movement
+	WEB_VIEW_RENDER_SCALE = 1 // scale at which CEF paints web view of active Tab
+};
+
+// Log value of channel into binary file, which starts with "GTWD" and version
+// followed by records of timestamp (int64, microseconds since epoch), channel
+// (uint32) and value (float). Only written when diagnostics are enabled in setup
+void LogValue(LogChannel channel, float value);
+
 #endif // LOGGER_H_
@@ -0,0 +1,149 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "PhraseMatcher.h"
+#include <algorithm>
+#include <cstdlib>
+
+PhraseMatcher::PhraseMatcher(const std::vector<std::string>& rPhrases)
+{
+	for (const auto& rPhrase : rPhrases)
+	{
+		Add(rPhrase);
+	}
+}
+
+int PhraseMatcher::Add(std::string phrase)
+{
+	// Reuse index of identical phrase
+	auto iter = _indices.find(phrase);
+	if (iter != _indices.end())
+	{
+		return iter->second;
+	}
+
+	// Store phrase
+	const int index = (int)_phrases.size();
+	_phrases.push_back(phrase);
+	_indices[phrase] = index;
+
+	// First phrase becomes root
+	if (_nodes.empty())
+	{
+		_nodes.push_back(Node(index));
+		return index;
+	}
+
+	// Walk down the tree until there is no child with same distance
+	int nodeIndex = 0;
+	while (true)
+	{
+		const std::string& rOther = _phrases.at(_nodes.at(nodeIndex).index);
+		const int distance = BoundedDistance(phrase, rOther, (int)std::max(phrase.size(), rOther.size())); // exact distance
+		auto child = _nodes.at(nodeIndex).children.find(distance);
+		if (child == _nodes.at(nodeIndex).children.end())
+		{
+			_nodes.at(nodeIndex).children[distance] = (int)_nodes.size();
+			_nodes.push_back(Node(index));
+			break;
+		}
+		nodeIndex = child->second;
+	}
+	return index;
+}
+
+std::vector<PhraseMatcher::Match> PhraseMatcher::Find(const std::string& rQuery, int maxDistance, int maxCount) const
+{
+	std::vector<Match> matches;
+	if (_nodes.empty() || maxDistance < 0) { return matches; }
+
+	// Band is wider than maximum distance, so pruning still works for nodes slightly out of range
+	const int bound = 2 * maxDistance + 1;
+
+	// Traverse BK-tree without recursion
+	std::vector<int> stack;
+	stack.push_back(0);
+	while (!stack.empty())
+	{
+		const Node& rNode = _nodes.at(stack.back());
+		stack.pop_back();
+
+		// Distance to phrase of node
+		const std::string& rPhrase = _phrases.at(rNode.index);
+		const int distance = BoundedDistance(rQuery, rPhrase, bound);
+		if (distance <= maxDistance)
+		{
+			matches.push_back(Match(rNode.index, distance, Score(distance, rQuery.size(), rPhrase.size())));
+		}
+
+		// Children may only contain matches if distance to them lies within range. If the distance exceeded the bound, only lower limit is known
+		const int lower = distance - maxDistance;
+		auto iter = rNode.children.lower_bound(lower);
+		for (; iter != rNode.children.end(); ++iter)
+		{
+			if (distance <= bound && iter->first > distance + maxDistance) { break; }
+			stack.push_back(iter->second);
+		}
+	}
+
+	// Rank by score, then by distance
+	std::sort(matches.begin(), matches.end(), [](const Match& rA, const Match& rB)
+	{
+		if (rA.score != rB.score) { return rA.score > rB.score; }
+		if (rA.distance != rB.distance) { return rA.distance < rB.distance; }
+		return rA.index < rB.index;
+	});
+	if (maxCount >= 0 && (int)matches.size() > maxCount)
+	{
+		matches.erase(matches.begin() + maxCount, matches.end());
+	}
+	return matches;
+}
+
+int PhraseMatcher::BoundedDistance(const std::string& rA, const std::string& rB, int bound)
+{
+	const int m = (int)rA.size();
+	const int n = (int)rB.size();
+
+	// Difference in length is lower limit of distance
+	if (std::abs(m - n) > bound) { return bound + 1; }
+	if (m == 0) { return n; }
+	if (n == 0) { return m; }
+
+	// Only cells within band around diagonal can have a value within bound
+	const int infinity = bound + 1;
+	std::vector<int> previous(n + 1, infinity);
+	std::vector<int> current(n + 1, infinity);
+	for (int j = 0; j <= std::min(n, bound); j++) { previous[j] = j; }
+
+	for (int i = 1; i <= m; i++)
+	{
+		const int from = std::max(1, i - bound);
+		const int to = std::min(n, i + bound);
+		current[from - 1] = (from == 1 && i <= bound) ? i : infinity;
+		int rowMinimum = current[from - 1];
+		for (int j = from; j <= to; j++)
+		{
+			const int substitution = previous[j - 1] + (rA[i - 1] == rB[j - 1] ? 0 : 1);
+			const int deletion = previous[j] + 1;
+			const int insertion = current[j - 1] + 1;
+			current[j] = std::min(infinity, std::min(substitution, std::min(deletion, insertion)));
+			rowMinimum = std::min(rowMinimum, current[j]);
+		}
+		if (to < n) { current[to + 1] = infinity; }
+
+		// Whole row exceeds bound, so does the result
+		if (rowMinimum > bound) { return infinity; }
+		std::swap(previous, current);
+	}
+	return std::min(previous[n], infinity);
+}
+
+float PhraseMatcher::Score(int distance, size_t lengthA, size_t lengthB)
+{
+	const size_t length = std::max(lengthA, lengthB);
+	if (length == 0) { return 1.f; }
+	return std::max(0.f, 1.f - ((float)distance / (float)length));
+}
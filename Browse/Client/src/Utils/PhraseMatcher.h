@@ -0,0 +1,68 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Approximate matching of phrases like voice commands or link texts. Phrases
+// are precompiled into a BK-tree, so a query only computes the edit distance
+// to a fraction of them. Edit distance is computed within a band around the
+// diagonal and stops as soon as the bound is exceeded.
+
+#ifndef PHRASEMATCHER_H_
+#define PHRASEMATCHER_H_
+
+#include <string>
+#include <vector>
+#include <map>
+
+class PhraseMatcher
+{
+public:
+
+	// Match of query with phrase
+	struct Match
+	{
+		Match(int index, int distance, float score) : index(index), distance(distance), score(score) {}
+		int index; // index of phrase as returned by Add
+		int distance; // edit distance between query and phrase
+		float score; // [0..1], one for identical phrases
+	};
+
+	// Constructors
+	PhraseMatcher() {}
+	PhraseMatcher(const std::vector<std::string>& rPhrases);
+
+	// Add phrase, returns its index
+	int Add(std::string phrase);
+
+	// Get phrase by index
+	const std::string& GetPhrase(int index) const { return _phrases.at(index); }
+
+	// Count of phrases
+	int GetCount() const { return (int)_phrases.size(); }
+
+	// Find phrases within given distance of query, ranked by score. Count of matches is limited by maxCount if not negative
+	std::vector<Match> Find(const std::string& rQuery, int maxDistance, int maxCount = -1) const;
+
+	// Edit distance between strings. Returns bound + 1 if distance is larger than bound
+	static int BoundedDistance(const std::string& rA, const std::string& rB, int bound);
+
+private:
+
+	// Node of BK-tree
+	struct Node
+	{
+		Node(int index) : index(index) {}
+		int index; // index of phrase
+		std::map<int, int> children; // distance to child mapped to node index
+	};
+
+	// Score of match, relative to longer of both strings
+	static float Score(int distance, size_t lengthA, size_t lengthB);
+
+	// Members
+	std::vector<std::string> _phrases;
+	std::vector<Node> _nodes;
+	std::map<std::string, int> _indices; // identical phrases share one node
+};
+
+#endif // PHRASEMATCHER_H_
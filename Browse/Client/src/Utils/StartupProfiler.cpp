@@ -0,0 +1,120 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+
+#include "StartupProfiler.h"
+#include "src/Utils/Logger.h"
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <vector>
+#include <algorithm>
+#include <iomanip>
+
+namespace
+{
+	// Static initialization happens on main thread, right before main is entered
+	const std::chrono::steady_clock::time_point processStart = std::chrono::steady_clock::now();
+	const std::thread::id mainThreadId = std::this_thread::get_id();
+
+	// Entry of timeline
+	struct Entry
+	{
+		std::string name;
+		bool mainThread;
+		double begin; // milliseconds since process start
+		double end; // negative while step is running
+	};
+
+	// Timeline, guarded by mutex
+	std::mutex mutex;
+	std::vector<Entry> timeline;
+	bool timelineLogged = false;
+
+	// Milliseconds since process start
+	double Now()
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - processStart).count();
+	}
+
+	// Format single entry of timeline
+	std::string Format(const Entry& rEntry)
+	{
+		std::ostringstream stream;
+		stream << std::fixed << std::setprecision(1);
+		stream << std::setw(8) << rEntry.begin << " ms ";
+		if (rEntry.end < 0.0)
+		{
+			stream << "   (running) ";
+		}
+		else if (rEntry.end > rEntry.begin)
+		{
+			stream << "+" << std::setw(8) << (rEntry.end - rEntry.begin) << " ms ";
+		}
+		else
+		{
+			stream << "             ";
+		}
+		stream << (rEntry.mainThread ? "[main]   " : "[worker] ") << rEntry.name;
+		return stream.str();
+	}
+}
+
+StartupStep::StartupStep(std::string name)
+{
+	const double begin = Now();
+	std::lock_guard<std::mutex> lock(mutex);
+	_index = (int)timeline.size();
+	timeline.push_back({ name, std::this_thread::get_id() == mainThreadId, begin, -1.0 });
+}
+
+StartupStep::~StartupStep()
+{
+	End();
+}
+
+void StartupStep::End()
+{
+	if (_index < 0) { return; }
+	const double end = Now();
+	std::lock_guard<std::mutex> lock(mutex);
+	Entry& rEntry = timeline.at(_index);
+	rEntry.end = end;
+	_index = -1;
+
+	// Steps which finish after the timeline has been logged are reported on their own
+	if (timelineLogged)
+	{
+		LogInfo("Startup: ", Format(rEntry));
+	}
+}
+
+void StartupMark(std::string name)
+{
+	const double time = Now();
+	std::lock_guard<std::mutex> lock(mutex);
+	timeline.push_back({ name, std::this_thread::get_id() == mainThreadId, time, time });
+	if (timelineLogged)
+	{
+		LogInfo("Startup: ", Format(timeline.back()));
+	}
+}
+
+void LogStartupTimeline()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	if (timelineLogged) { return; }
+	timelineLogged = true;
+
+	// Sort copy by begin, threads may have appended their steps slightly out of order
+	std::vector<Entry> sorted = timeline;
+	std::stable_sort(sorted.begin(), sorted.end(), [](const Entry& rA, const Entry& rB) { return rA.begin < rB.begin; });
+
+	// Log it
+	LogInfo("Startup timeline:");
+	for (const Entry& rEntry : sorted)
+	{
+		LogInfo("Startup: ", Format(rEntry));
+	}
+}
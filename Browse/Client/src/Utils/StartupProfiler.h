@@ -0,0 +1,41 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Profiler of application startup. Steps are measured from any thread, in
+// milliseconds since the process has been started, and logged as timeline
+// once the first frame has been displayed. Steps still running at that point
+// are logged as unfinished, later marks are logged one by one.
+
+#ifndef STARTUPPROFILER_H_
+#define STARTUPPROFILER_H_
+
+#include <string>
+
+// Step of startup, measured from construction until end or destruction
+class StartupStep
+{
+public:
+
+	// Constructor, begins the step
+	StartupStep(std::string name);
+
+	// Destructor, ends step if not done, yet
+	virtual ~StartupStep();
+
+	// End step before destruction
+	void End();
+
+private:
+
+	// Index of step in timeline
+	int _index = -1;
+};
+
+// Add mark without duration to timeline
+void StartupMark(std::string name);
+
+// Log timeline of all steps so far. Called once when startup is complete
+void LogStartupTimeline();
+
+#endif // STARTUPPROFILER_H_
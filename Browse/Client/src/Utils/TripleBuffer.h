@@ -0,0 +1,58 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+// Author: Raphael Menges (raphaelmenges@uni-koblenz.de)
+//============================================================================
+// Hands values from one writer thread to one reader thread without locking.
+// Writer fills back slot and publishes it by swapping it with the middle slot,
+// reader swaps middle slot with its front slot when something new has been
+// published. Reader always gets the most recently published value.
+
+#ifndef TRIPLEBUFFER_H_
+#define TRIPLEBUFFER_H_
+
+#include <atomic>
+
+template<typename T>
+class TripleBuffer
+{
+public:
+
+	// Constructor
+	TripleBuffer() : _middle(1) {}
+
+	// Slot to be filled by writer
+	T& GetBack()
+	{
+		return _slots[_back];
+	}
+
+	// Publish back slot. Called by writer
+	void Publish()
+	{
+		_back = _middle.exchange(_back | FRESH_BIT, std::memory_order_acq_rel) & INDEX_MASK;
+	}
+
+	// Most recently published value, default constructed when nothing published yet. Called by reader
+	const T& Read()
+	{
+		if (_middle.load(std::memory_order_acquire) & FRESH_BIT)
+		{
+			_front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX_MASK;
+		}
+		return _slots[_front];
+	}
+
+private:
+
+	// Middle index carries flag whether it has been published since last read
+	static const int FRESH_BIT = 4;
+	static const int INDEX_MASK = 3;
+
+	// Members
+	T _slots[3];
+	int _back = 0; // only touched by writer
+	std::atomic<int> _middle;
+	int _front = 2; // only touched by reader
+};
+
+#endif // TRIPLEBUFFER_H_
@@ -12,13 +12,16 @@
 #endif
 
 #include "src/Master/Master.h"
+#include "src/Master/StartupPreload.h"
 #include "src/Utils/Logger.h"
+#include "src/Utils/StartupProfiler.h"
+#include "src/Arguments.h"
 
 // Execute function to have Master object on stack which might be faster than on heap
-bool Execute(CefRefPtr<MainCefApp> app, std::string userDirectory) // returns whether system should shut down
+bool Execute(CefRefPtr<MainCefApp> app, std::string userDirectory, StartupPreload& rPreload) // returns whether system should shut down
 {
     // Initialize master
-    Master master(app.get(), userDirectory);
+    Master master(app.get(), userDirectory, rPreload);
 
 	// Give app poiner to master (only functions exposed through interface are accessible)
 	app->SetMaster(&master);
@@ -66,18 +69,36 @@ int CommonMain(const CefMainArgs& args, CefSettings settings, CefRefPtr<MainCefA
 	settings.windowless_rendering_enabled = true;
 	settings.remote_debugging_port = 8088;
 
+	// Start work independent of CEF, so it runs while CEF is initialized
+	StartupPreload preload(userDirectory);
+
+	// Simulation replaces CEF by synthetic pages
+	const bool simulate = !Argument::simulationScenario.empty();
+
     // Initialize CEF
-    LogInfo("Initializing CEF...");
-    CefInitialize(args, settings, app.get(), windows_sandbox_info);
-    LogInfo("..done.");
+	if (!simulate)
+	{
+		LogInfo("Initializing CEF...");
+		StartupStep initializeCEFStep("Initialize CEF");
+		CefInitialize(args, settings, app.get(), windows_sandbox_info);
+		initializeCEFStep.End();
+		LogInfo("..done.");
+	}
+	else
+	{
+		LogInfo("Simulating scenario ", Argument::simulationScenario, " without CEF.");
+	}
 
     // Execute our code
-    bool shutdownOnExit = Execute(app, userDirectory);
+    bool shutdownOnExit = Execute(app, userDirectory, preload);
 
     // Shutdown CEF
-    LogInfo("Shutdown CEF...");
-    CefShutdown();
-    LogInfo("..done.");
+	if (!simulate)
+	{
+		LogInfo("Shutdown CEF...");
+		CefShutdown();
+		LogInfo("..done.");
+	}
 
     // Return zero
     LogInfo("Successful termination of program.");
@@ -137,6 +137,12 @@ int APIENTRY wWinMain(
     // Append another slash for easier usage of that path.
 	userDirectory.append("\\");
 
+	// Simulation does not initialize CEF, which would parse the custom arguments
+	if (commandLine->HasSwitch("simulate"))
+	{
+		mainProcessApp->OnBeforeCommandLineProcessing(CefString(), commandLine);
+	}
+
 	// Use common main now.
 	return CommonMain(main_args, settings, mainProcessApp, sandbox_info, userDirectory);
 }
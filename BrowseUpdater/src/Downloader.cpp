@@ -0,0 +1,467 @@
+// Copyright 2017 Raphael Menges
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Downloader.h"
+#include "externals/curl/include/curl/curl.h"
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+
+// Number of attempts per chunk before download fails
+const int chunkAttempts = 3;
+
+// Interval of progress reports and hashing of finished chunks
+const long long progressIntervalMS = 250;
+
+// Seek in files larger than 2GB
+static int Seek(FILE* pFile, long long offset)
+{
+#ifdef _WIN32
+	return _fseeki64(pFile, offset, SEEK_SET);
+#else
+	return fseeko(pFile, (off_t)offset, SEEK_SET);
+#endif
+}
+
+// Value of header line if it has given lower case name, otherwise empty
+static std::string HeaderValue(const std::string& rLine, const std::string& rName)
+{
+	if (rLine.size() <= rName.size()) { return ""; }
+	std::string name = rLine.substr(0, rName.size());
+	std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+	if (name != rName) { return ""; }
+	const size_t begin = rLine.find_first_not_of(" \t", rName.size());
+	const size_t end = rLine.find_last_not_of(" \t\r\n");
+	return (begin == std::string::npos || end < begin) ? "" : rLine.substr(begin, end - begin + 1);
+}
+
+// Properties collected from header
+struct HeaderInfo
+{
+	bool acceptsRanges = false;
+	std::string ETag;
+	std::string lastModified;
+};
+
+// Callback for CURL to collect range support and validators from header
+static size_t CURLHeaderInfo(char* buffer, size_t size, size_t nitems, void* userdata)
+{
+	HeaderInfo* pInfo = (HeaderInfo*)userdata;
+	const std::string line(buffer, size * nitems);
+	if (line.compare(0, 5, "HTTP/") == 0) { *pInfo = HeaderInfo(); } // header of response after redirection
+	std::string value = HeaderValue(line, "accept-ranges:");
+	std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+	if (value.find("bytes") != std::string::npos) { pInfo->acceptsRanges = true; }
+	value = HeaderValue(line, "etag:");
+	if (!value.empty()) { pInfo->ETag = value; }
+	value = HeaderValue(line, "last-modified:");
+	if (!value.empty()) { pInfo->lastModified = value; }
+	return size * nitems;
+}
+
+// Target of chunk transfer
+struct ChunkTarget
+{
+	FILE* pFile;
+	unsigned char* pData; // position of chunk in memory
+	long long remaining; // bytes expected, transfer is aborted when server sends more
+	std::atomic<long long>* pDownloaded;
+};
+
+// Callback for CURL to write chunk into file and memory
+static size_t CURLWriteChunk(void* ptr, size_t size, size_t nmemb, void* userdata)
+{
+	ChunkTarget* pTarget = (ChunkTarget*)userdata;
+	const long long count = (long long)(size * nmemb);
+	if (count > pTarget->remaining) { return 0; } // server ignored range, abort
+	size_t written = fwrite(ptr, 1, (size_t)count, pTarget->pFile);
+	std::copy((const unsigned char*)ptr, (const unsigned char*)ptr + written, pTarget->pData);
+	pTarget->pData += written;
+	pTarget->remaining -= (long long)written;
+	*(pTarget->pDownloaded) += (long long)written;
+	return written;
+}
+
+// Target of single transfer
+struct SingleTarget
+{
+	FILE* pFile;
+	std::vector<unsigned char>* pData;
+	Sha256* pHasher;
+	std::atomic<long long> downloaded;
+};
+
+// Callback for CURL to write single transfer into file and memory, hashing on the fly
+static size_t CURLWriteSingle(void* ptr, size_t size, size_t nmemb, void* userdata)
+{
+	SingleTarget* pTarget = (SingleTarget*)userdata;
+	size_t written = fwrite(ptr, size, nmemb, pTarget->pFile);
+	const unsigned char* pBytes = (const unsigned char*)ptr;
+	pTarget->pData->insert(pTarget->pData->end(), pBytes, pBytes + written * size);
+	pTarget->pHasher->Update(pBytes, written * size);
+	pTarget->downloaded += (long long)(written * size);
+	return written;
+}
+
+Downloader::Downloader(std::string URL, std::string path, int connectionCount, long long chunkSize) :
+	_URL(URL), _path(path), _statePath(path + ".state"), _connectionCount(std::max(1, connectionCount)), _chunkSize(std::max(1LL, chunkSize))
+{
+	// Nothing to do
+}
+
+bool Downloader::Run(std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError)
+{
+	rData.clear();
+	FileInfo info;
+	if (!QueryFile(info, rError))
+	{
+		return false;
+	}
+
+	// Chunks of unknown version of file could stem from different versions
+	if (info.acceptsRanges && info.size > 0 && !info.validator.empty())
+	{
+		return RunChunked(info, rData, rHasher, progressCallback, rError);
+	}
+	return RunSingle(rData, rHasher, progressCallback, rError);
+}
+
+void Downloader::Discard() const
+{
+	std::remove(_path.c_str());
+	std::remove(_statePath.c_str());
+}
+
+bool Downloader::QueryFile(FileInfo& rInfo, std::string& rError) const
+{
+	HeaderInfo header;
+	CURL* curl = curl_easy_init();
+	if (!curl)
+	{
+		rError = "CURL could not be instantiated.";
+		return false;
+	}
+	curl_easy_setopt(curl, CURLOPT_URL, _URL.c_str());
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_NOBODY, 1L); // HEAD request
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+	curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, CURLHeaderInfo);
+	curl_easy_setopt(curl, CURLOPT_HEADERDATA, &header);
+	CURLcode res = curl_easy_perform(curl);
+	double contentLength = -1.0;
+	if (res == CURLE_OK)
+	{
+		curl_easy_getinfo(curl, CURLINFO_CONTENT_LENGTH_DOWNLOAD, &contentLength);
+	}
+	curl_easy_cleanup(curl);
+	if (res != CURLE_OK)
+	{
+		rError = "curl_easy_perform() failed: " + std::string(curl_easy_strerror(res));
+		return false;
+	}
+	rInfo.size = (long long)contentLength;
+	rInfo.acceptsRanges = header.acceptsRanges;
+
+	// If-Range accepts only strong entity tags
+	if (!header.ETag.empty() && header.ETag.compare(0, 2, "W/") != 0) { rInfo.validator = header.ETag; }
+	else { rInfo.validator = header.lastModified; }
+	return true;
+}
+
+bool Downloader::RunChunked(const FileInfo& rInfo, std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError)
+{
+	const long long size = rInfo.size;
+	const int chunkCount = (int)((size + _chunkSize - 1) / _chunkSize);
+	rData.assign((size_t)size, 0);
+
+	// Resume or start over
+	std::vector<bool> chunksDone(chunkCount, false);
+	if (!LoadState(rInfo, chunksDone))
+	{
+		chunksDone.assign(chunkCount, false);
+
+		// Allocate file of full size, so chunks can be written at their offset
+		FILE* pFile = fopen(_path.c_str(), "wb");
+		if (pFile == NULL || Seek(pFile, size - 1) != 0 || fputc(0, pFile) == EOF)
+		{
+			if (pFile != NULL) { fclose(pFile); }
+			rError = "Target path for download could not be opened.";
+			return false;
+		}
+		fclose(pFile);
+
+		// Fresh state, identifying the download and the version of the file
+		std::ofstream state(_statePath, std::ios::trunc);
+		state << _URL << "\n" << rInfo.validator << "\n" << size << " " << _chunkSize << "\n";
+	}
+
+	// Collect missing chunks and read the resumed ones, which is the only time any part of the file is read
+	std::vector<int> missingChunks;
+	long long resumedBytes = 0;
+	const bool resuming = std::find(chunksDone.begin(), chunksDone.end(), true) != chunksDone.end();
+	FILE* pResumeFile = resuming ? fopen(_path.c_str(), "rb") : NULL;
+	for (int i = 0; i < chunkCount; i++)
+	{
+		const long long offset = (long long)i * _chunkSize;
+		const size_t length = (size_t)std::min(_chunkSize, size - offset);
+		if (chunksDone[i] && pResumeFile != NULL && Seek(pResumeFile, offset) == 0 && fread(rData.data() + offset, 1, length, pResumeFile) == length)
+		{
+			resumedBytes += (long long)length;
+		}
+		else
+		{
+			chunksDone[i] = false; // unreadable chunks are downloaded again
+			missingChunks.push_back(i);
+		}
+	}
+	if (pResumeFile != NULL) { fclose(pResumeFile); }
+	const std::string ifRange = "If-Range: " + rInfo.validator;
+
+	// Shared between workers
+	std::mutex stateMutex;
+	std::atomic<int> nextMissingChunk(0);
+	std::atomic<long long> downloaded(resumedBytes);
+	std::atomic<bool> failed(false);
+	std::atomic<bool> changed(false);
+	std::atomic<int> runningWorkers(0);
+	std::string workerError;
+
+	// Worker downloading missing chunks, each with a connection of its own
+	auto work = [&]()
+	{
+		CURL* curl = curl_easy_init();
+		FILE* pFile = fopen(_path.c_str(), "r+b");
+		struct curl_slist* pHeaders = curl_slist_append(NULL, ifRange.c_str()); // server sends complete file when it has changed
+		if (!curl || pFile == NULL)
+		{
+			std::lock_guard<std::mutex> lock(stateMutex);
+			workerError = "Could not prepare download.";
+			failed = true;
+		}
+
+		int missingIndex;
+		while (!failed && (missingIndex = nextMissingChunk++) < (int)missingChunks.size())
+		{
+			const int chunk = missingChunks.at(missingIndex);
+			const long long offset = (long long)chunk * _chunkSize;
+			const long long length = std::min(_chunkSize, size - offset);
+			const std::string range = std::to_string(offset) + "-" + std::to_string(offset + length - 1);
+
+			// Try chunk some times before giving up
+			bool success = false;
+			std::string error;
+			for (int attempt = 0; attempt < chunkAttempts && !success && !failed; attempt++)
+			{
+				ChunkTarget target = { pFile, rData.data() + offset, length, &downloaded };
+				Seek(pFile, offset);
+				curl_easy_setopt(curl, CURLOPT_URL, _URL.c_str());
+				curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+				curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+				curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+				curl_easy_setopt(curl, CURLOPT_RANGE, range.c_str());
+				curl_easy_setopt(curl, CURLOPT_HTTPHEADER, pHeaders);
+				curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLWriteChunk);
+				curl_easy_setopt(curl, CURLOPT_WRITEDATA, &target);
+				curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L); // abort stalled connections
+				curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 30L);
+				CURLcode res = curl_easy_perform(curl);
+				fflush(pFile);
+				long responseCode = 0;
+				curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &responseCode);
+				success = res == CURLE_OK && responseCode == 206 && target.remaining == 0;
+				if (!success)
+				{
+					downloaded -= length - target.remaining; // chunk is downloaded again
+					error = res != CURLE_OK ? std::string(curl_easy_strerror(res)) : "Server did not deliver range " + range + ".";
+				}
+				if (responseCode == 200) // If-Range did not match, retrying is pointless
+				{
+					changed = true;
+					break;
+				}
+			}
+
+			// Record chunk in state
+			std::lock_guard<std::mutex> lock(stateMutex);
+			if (success)
+			{
+				chunksDone[chunk] = true;
+				std::ofstream state(_statePath, std::ios::app);
+				state << chunk << "\n";
+			}
+			else
+			{
+				workerError = error;
+				failed = true;
+			}
+		}
+
+		if (pFile != NULL) { fclose(pFile); }
+		curl_slist_free_all(pHeaders);
+		if (curl) { curl_easy_cleanup(curl); }
+		--runningWorkers;
+	};
+
+	// Start workers
+	std::vector<std::thread> workers;
+	for (int i = 0; i < std::min(_connectionCount, (int)missingChunks.size()); i++)
+	{
+		++runningWorkers;
+		workers.push_back(std::thread(work));
+	}
+
+	// Hash chunks in order from memory while the workers proceed
+	int hashedChunks = 0;
+	auto hashFinishedChunks = [&]()
+	{
+		while (hashedChunks < chunkCount)
+		{
+			{
+				std::lock_guard<std::mutex> lock(stateMutex); // chunk in memory is complete once recorded
+				if (!chunksDone[hashedChunks]) { break; }
+			}
+			const long long offset = (long long)hashedChunks * _chunkSize;
+			const size_t length = (size_t)std::min(_chunkSize, size - offset);
+			rHasher.Update(rData.data() + offset, length);
+			++hashedChunks;
+		}
+	};
+
+	// Report progress until all workers are done
+	while (true)
+	{
+		const bool done = runningWorkers == 0;
+		if (done) { for (auto& rWorker : workers) { rWorker.join(); } }
+		hashFinishedChunks();
+		progressCallback(downloaded, size);
+		if (done) { break; }
+		std::this_thread::sleep_for(std::chrono::milliseconds(progressIntervalMS));
+	}
+
+	// Check for errors
+	if (changed)
+	{
+		Discard();
+		rData.clear();
+		rError = "File has changed on server during download, it starts over on next start.";
+		return false;
+	}
+	if (failed || hashedChunks != chunkCount)
+	{
+		rData.clear();
+		rError = "Download failed, it resumes on next start: " + workerError;
+		return false;
+	}
+
+	// Download is complete, state is no longer required
+	std::remove(_statePath.c_str());
+	return true;
+}
+
+bool Downloader::RunSingle(std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError)
+{
+	// Nothing to resume from
+	std::remove(_statePath.c_str());
+
+	CURL* curl = curl_easy_init();
+	if (!curl)
+	{
+		rError = "CURL could not be instantiated.";
+		return false;
+	}
+	FILE* pFile = fopen(_path.c_str(), "wb");
+	if (pFile == NULL)
+	{
+		curl_easy_cleanup(curl);
+		rError = "Target path for download could not be opened.";
+		return false;
+	}
+
+	// Transfer in a thread, so progress can be reported
+	SingleTarget target;
+	target.pFile = pFile;
+	target.pData = &rData;
+	target.pHasher = &rHasher;
+	target.downloaded = 0;
+	curl_easy_setopt(curl, CURLOPT_URL, _URL.c_str());
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLWriteSingle);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &target);
+	curl_easy_setopt(curl, CURLOPT_LOW_SPEED_LIMIT, 1L);
+	curl_easy_setopt(curl, CURLOPT_LOW_SPEED_TIME, 30L);
+	std::atomic<bool> done(false);
+	CURLcode res = CURLE_OK;
+	std::thread transfer([&]() { res = curl_easy_perform(curl); done = true; });
+	while (!done)
+	{
+		progressCallback(target.downloaded, -1); // value may lag behind, only for display
+		std::this_thread::sleep_for(std::chrono::milliseconds(progressIntervalMS));
+	}
+	transfer.join();
+	progressCallback(target.downloaded, target.downloaded);
+
+	// Cleanup CURL and close file
+	curl_easy_cleanup(curl);
+	fclose(pFile);
+
+	// Check for errors
+	if (res != CURLE_OK)
+	{
+		Discard();
+		rData.clear();
+		rError = "curl_easy_perform() failed: " + std::string(curl_easy_strerror(res));
+		return false;
+	}
+	return true;
+}
+
+bool Downloader::LoadState(const FileInfo& rInfo, std::vector<bool>& rChunksDone) const
+{
+	const long long size = rInfo.size;
+	std::ifstream state(_statePath);
+	if (!state.is_open()) { return false; }
+
+	// Check identity of download, release with same name and size may still differ
+	std::string URL, validator;
+	long long stateSize = 0, stateChunkSize = 0;
+	std::getline(state, URL);
+	std::getline(state, validator);
+	if (!(state >> stateSize >> stateChunkSize) || URL != _URL || validator != rInfo.validator || stateSize != size || stateChunkSize != _chunkSize)
+	{
+		return false;
+	}
+
+	// Check that file is still there with full size
+	std::ifstream file(_path, std::ios::binary | std::ios::ate);
+	if (!file.is_open() || (long long)file.tellg() != size)
+	{
+		return false;
+	}
+
+	// Read finished chunks
+	int chunk;
+	while (state >> chunk)
+	{
+		if (chunk >= 0 && chunk < (int)rChunksDone.size()) { rChunksDone[chunk] = true; }
+	}
+	return true;
+}
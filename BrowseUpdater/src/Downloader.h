@@ -0,0 +1,78 @@
+// Copyright 2017 Raphael Menges
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// Downloads a file in chunks of fixed size, using multiple connections that
+// request byte ranges. Finished chunks are recorded in a state file next to
+// the download, so an interrupted download resumes with the missing chunks.
+// The state names the version of the file by its ETag or Last-Modified date
+// and chunks are requested with If-Range, so a file changed on the server is
+// never stitched onto a stale partial one. Servers without range support or
+// validator get a single plain transfer instead. Downloaded data is kept in
+// memory as well, so it is hashed and extracted without reading the file.
+
+#ifndef DOWNLOADER_H_
+#define DOWNLOADER_H_
+
+#include "Sha256.h"
+#include <string>
+#include <vector>
+#include <functional>
+
+class Downloader
+{
+public:
+
+	// Callback with downloaded and total bytes. Total is negative if unknown
+	typedef std::function<void(long long, long long)> ProgressCallback;
+
+	// Constructor
+	Downloader(std::string URL, std::string path, int connectionCount = 4, long long chunkSize = 4 * 1024 * 1024);
+
+	// Download file into data. Complete file is fed in order into hasher, also when resumed. Returns whether successful
+	bool Run(std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError);
+
+	// Remove downloaded file and state, so next run starts from zero
+	void Discard() const;
+
+private:
+
+	// Properties of file on server
+	struct FileInfo
+	{
+		long long size = -1;
+		bool acceptsRanges = false;
+		std::string validator; // strong ETag or Last-Modified date, empty if server provides neither
+	};
+
+	// Request properties of file
+	bool QueryFile(FileInfo& rInfo, std::string& rError) const;
+
+	// Download chunks in parallel
+	bool RunChunked(const FileInfo& rInfo, std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError);
+
+	// Download in one transfer
+	bool RunSingle(std::vector<unsigned char>& rData, Sha256& rHasher, ProgressCallback progressCallback, std::string& rError);
+
+	// Read chunks of state file that are already downloaded. Returns false if state does not belong to this version of the file
+	bool LoadState(const FileInfo& rInfo, std::vector<bool>& rChunksDone) const;
+
+	// Members
+	const std::string _URL;
+	const std::string _path;
+	const std::string _statePath;
+	const int _connectionCount;
+	const long long _chunkSize;
+};
+
+#endif // DOWNLOADER_H_
@@ -0,0 +1,128 @@
+// Copyright 2017 Raphael Menges
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "Sha256.h"
+#include <cstring>
+#include <algorithm>
+
+// Round constants
+static const uint32_t K[64] =
+{
+	0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+	0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+	0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+	0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+	0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+	0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+	0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+	0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+// Rotate right
+static inline uint32_t RotateRight(uint32_t value, int count)
+{
+	return (value >> count) | (value << (32 - count));
+}
+
+Sha256::Sha256()
+{
+	const uint32_t initialState[8] = { 0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19 };
+	memcpy(_state, initialState, sizeof(_state));
+}
+
+void Sha256::Update(const unsigned char* pData, size_t size)
+{
+	_length += size;
+
+	// Fill up buffered block first
+	if (_bufferSize > 0)
+	{
+		const size_t count = std::min(size, sizeof(_buffer) - _bufferSize);
+		memcpy(_buffer + _bufferSize, pData, count);
+		_bufferSize += count;
+		pData += count;
+		size -= count;
+		if (_bufferSize < sizeof(_buffer)) { return; }
+		Transform(_buffer);
+		_bufferSize = 0;
+	}
+
+	// Process complete blocks directly from data
+	while (size >= sizeof(_buffer))
+	{
+		Transform(pData);
+		pData += sizeof(_buffer);
+		size -= sizeof(_buffer);
+	}
+
+	// Buffer rest
+	memcpy(_buffer, pData, size);
+	_bufferSize = size;
+}
+
+std::string Sha256::GetHexDigest()
+{
+	// Padding with one bit, zeros and length in bits
+	const uint64_t bitLength = _length * 8;
+	const unsigned char one = 0x80;
+	const unsigned char zero = 0x00;
+	Update(&one, 1);
+	while (_bufferSize != 56) { Update(&zero, 1); }
+	unsigned char lengthBytes[8];
+	for (int i = 0; i < 8; i++) { lengthBytes[i] = (unsigned char)(bitLength >> (56 - 8 * i)); }
+	Update(lengthBytes, 8);
+
+	// Convert state to hex
+	static const char* digits = "0123456789abcdef";
+	std::string digest;
+	for (int i = 0; i < 8; i++)
+	{
+		for (int j = 28; j >= 0; j -= 4)
+		{
+			digest.push_back(digits[(_state[i] >> j) & 0xf]);
+		}
+	}
+	return digest;
+}
+
+void Sha256::Transform(const unsigned char* pBlock)
+{
+	// Message schedule
+	uint32_t w[64];
+	for (int i = 0; i < 16; i++)
+	{
+		w[i] = ((uint32_t)pBlock[4 * i] << 24) | ((uint32_t)pBlock[4 * i + 1] << 16) | ((uint32_t)pBlock[4 * i + 2] << 8) | (uint32_t)pBlock[4 * i + 3];
+	}
+	for (int i = 16; i < 64; i++)
+	{
+		const uint32_t s0 = RotateRight(w[i - 15], 7) ^ RotateRight(w[i - 15], 18) ^ (w[i - 15] >> 3);
+		const uint32_t s1 = RotateRight(w[i - 2], 17) ^ RotateRight(w[i - 2], 19) ^ (w[i - 2] >> 10);
+		w[i] = w[i - 16] + s0 + w[i - 7] + s1;
+	}
+
+	// Compression
+	uint32_t a = _state[0], b = _state[1], c = _state[2], d = _state[3], e = _state[4], f = _state[5], g = _state[6], h = _state[7];
+	for (int i = 0; i < 64; i++)
+	{
+		const uint32_t s1 = RotateRight(e, 6) ^ RotateRight(e, 11) ^ RotateRight(e, 25);
+		const uint32_t choice = (e & f) ^ (~e & g);
+		const uint32_t temp1 = h + s1 + choice + K[i] + w[i];
+		const uint32_t s0 = RotateRight(a, 2) ^ RotateRight(a, 13) ^ RotateRight(a, 22);
+		const uint32_t majority = (a & b) ^ (a & c) ^ (b & c);
+		const uint32_t temp2 = s0 + majority;
+		h = g; g = f; f = e; e = d + temp1; d = c; c = b; b = a; a = temp1 + temp2;
+	}
+	_state[0] += a; _state[1] += b; _state[2] += c; _state[3] += d;
+	_state[4] += e; _state[5] += f; _state[6] += g; _state[7] += h;
+}
@@ -0,0 +1,49 @@
+// Copyright 2017 Raphael Menges
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+// SHA-256 of data that is fed incrementally.
+
+#ifndef SHA256_H_
+#define SHA256_H_
+
+#include <string>
+#include <cstdint>
+#include <cstddef>
+
+class Sha256
+{
+public:
+
+	// Constructor
+	Sha256();
+
+	// Feed data
+	void Update(const unsigned char* pData, size_t size);
+
+	// Finish hashing and return digest as lowercase hex string. No further updates afterwards
+	std::string GetHexDigest();
+
+private:
+
+	// Process one block of 64 bytes
+	void Transform(const unsigned char* pBlock);
+
+	// Members
+	uint32_t _state[8];
+	unsigned char _buffer[64];
+	size_t _bufferSize = 0;
+	uint64_t _length = 0; // length of data in bytes
+};
+
+#endif // SHA256_H_
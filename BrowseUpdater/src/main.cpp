@@ -14,17 +14,25 @@
 
 #include <iostream>
 #include <string>
+#include <vector>
 #include <sstream>
 #include <fstream>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <iomanip>
 #include <filesystem>
+#include "src/Downloader.h"
+#include "src/Sha256.h"
 #include "externals/curl/include/curl/curl.h"
 #include "submodules/miniz/miniz.h"
 #include "submodules/miniz/miniz_zip.h"
 
 // Constants
-const std::string serverURL = "https://userpages.uni-koblenz.de/~raphaelmenges/gtw-update";
+const std::string defaultServerURL = "https://userpages.uni-koblenz.de/~raphaelmenges/gtw-update";
+const std::string checksumExtension = ".sha256"; // manifest next to zip on server, containing hex SHA-256 of zip
+const int downloadConnectionCount = 4;
+const long long downloadChunkSize = 4 * 1024 * 1024;
 const std::string tmpZipName = "gtw_new_version.zip";
 const std::string tmpUnzipDirName = "gtw_new_version";
 const std::string gtwPath = "./Browse"; // path to GazeTheWeb-Browse folder, relative from bat file that calls the updater
@@ -37,11 +45,40 @@ size_t CURLWriteString(void *contents, size_t size, size_t nmemb, void *userp)
 	return size * nmemb;
 }
 
-// Callback for CURL to retrieve zip file
-size_t CURLWriteFile(void *ptr, size_t size, size_t nmemb, FILE *stream) {
-	size_t written = fwrite(ptr, size, nmemb, stream);
-	std::cout << ".";
-	return written;
+// Request string from server, returns whether successful
+bool RequestString(const std::string& rURL, std::string& rBuffer, std::string& rError)
+{
+	CURL* curl = curl_easy_init();
+	if (!curl)
+	{
+		rError = "CURL could not be instantiated.";
+		return false;
+	}
+	curl_easy_setopt(curl, CURLOPT_URL, rURL.c_str()); // set address of request
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L); // error codes of server are errors
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLWriteString); // use write callback
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &rBuffer); // set pointer to write data into
+	CURLcode res = curl_easy_perform(curl);
+	curl_easy_cleanup(curl);
+	if (res != CURLE_OK)
+	{
+		rError = "curl_easy_perform() failed: " + std::string(curl_easy_strerror(res));
+		return false;
+	}
+	return true;
+}
+
+// Show progress of download in one line
+void ShowProgress(long long downloaded, long long total)
+{
+	const double MB = 1024.0 * 1024.0;
+	std::cout << "\r" << std::fixed << std::setprecision(1) << (downloaded / MB) << " MB";
+	if (total > 0)
+	{
+		std::cout << " of " << (total / MB) << " MB (" << (int)((100 * downloaded) / total) << "%)";
+	}
+	std::cout << "   " << std::flush;
 }
 
 // End function
@@ -52,9 +89,11 @@ int Return(std::string message)
 	return 0;
 }
 
-// Main
-int main()
+// Main. Optional argument replaces URL of update server
+int main(int argc, char* argv[])
 {
+	const std::string serverURL = argc > 1 ? std::string(argv[1]) : defaultServerURL;
+
 	// Welcome user
 	std::cout << "####################################" << std::endl;
 	std::cout << "### Updater of GazeTheWeb-Browse ###" << std::endl;
@@ -94,54 +133,28 @@ int main()
 	std::cout << "Local version: " << versionString << std::endl;
 
 	// ### RETRIEVE DOWNLOAD URL ###
-	
-	// Variables
-	CURL *curl; // CURL handle
+
+	// Request zip to download
 	std::string readBuffer; // buffer
+	std::string error;
 	std::string downloadLink = "";
-
-	// Initialize CURL
-	curl = curl_easy_init();
-
-	// Perform request of zip to to download
-	if (curl)
+	if (!RequestString(serverURL + "/gtw-check.cgi?version=" + versionString, readBuffer, error))
 	{
-		// Setup CURL
-		curl_easy_setopt(curl, CURLOPT_URL, std::string(serverURL + "/gtw-check.cgi?version=" + versionString).c_str()); // set address of request
-		curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L); // follow potential redirection
-		curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLWriteString); // use write callback
-		curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer); // set pointer to write data into
-
-		// Perform the request
-		CURLcode res = curl_easy_perform(curl);
-		
-		// Check for errors
-		if (res != CURLE_OK)
-		{
-			curl_easy_cleanup(curl);
-			return Return("curl_easy_perform() failed: " + std::string(curl_easy_strerror(res)) + " Exiting...");
-		}
+		return Return(error + " Exiting...");
+	}
 
-		// Extract URL to zip to download
-		std::stringstream ss(readBuffer);
-		std::string token;
-		int i = 0;
-		while (std::getline(ss, token, '\n'))
+	// Extract URL to zip to download
+	std::stringstream ss(readBuffer);
+	std::string token;
+	int i = 0;
+	while (std::getline(ss, token, '\n'))
+	{
+		if (i == 1 && !token.empty()) // second line and only when not empty
 		{
-			if (i == 1 && !token.empty()) // second line and only when not empty
-			{
-				downloadLink = serverURL + "/" + token;
-				break;
-			}
-			++i;
+			downloadLink = serverURL + "/" + token;
+			break;
 		}
-
-		// Clean up CURL
-		curl_easy_cleanup(curl);
-	}
-	else
-	{
-		return Return("CURL could not be instantiated. Exiting...");
+		++i;
 	}
 
 	// Only continue if download link it not empty
@@ -149,54 +162,53 @@ int main()
 	{
 		return Return("No new version available for download. Exiting...");
 	}
-	else
+
+	// ### RETRIEVE CHECKSUM ###
+
+	std::string checksumBuffer;
+	if (!RequestString(downloadLink + checksumExtension, checksumBuffer, error))
 	{
-		std::cout << "Downloading new version: " << downloadLink;
+		return Return("Checksum of new version not available: " + error + " Exiting...");
+	}
+	std::string expectedChecksum;
+	std::stringstream(checksumBuffer) >> expectedChecksum; // first token, like output of sha256sum
+	std::transform(expectedChecksum.begin(), expectedChecksum.end(), expectedChecksum.begin(), ::tolower);
+	if (expectedChecksum.size() != 64)
+	{
+		return Return("Checksum of new version is malformed. Exiting...");
 	}
 
 	// ### DOWNLOAD NEW VERSION INTO TMP ###
-	curl = curl_easy_init();
-	if (curl)
+
+	// Download in chunks, resuming an interrupted download of the same zip. Data is hashed while downloading and
+	// kept in memory for extraction, the file on disk only serves resuming
+	std::cout << "Downloading new version: " << downloadLink << std::endl;
+	Downloader downloader(downloadLink, tmpZipPath, downloadConnectionCount, downloadChunkSize);
+	Sha256 hasher;
+	std::vector<unsigned char> zipData;
+	if (!downloader.Run(zipData, hasher, ShowProgress, error))
 	{
-		FILE *fp;
-		fp = fopen(tmpZipPath.c_str(), "wb");
-		if (fp != NULL) // Only continue if file is opened
-		{
-			// 
-			curl_easy_setopt(curl, CURLOPT_URL, downloadLink.c_str());
-			curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, CURLWriteFile);
-			curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
-			CURLcode res = curl_easy_perform(curl);
-
-			// Cleanup CURL and close file
-			curl_easy_cleanup(curl);
-			fclose(fp);
-
-			// Check for errors
-			if (res != CURLE_OK)
-			{
-				return Return("curl_easy_perform() failed: " + std::string(curl_easy_strerror(res)) + " Exiting...");
-			}
-		}
-		else
-		{
-			return Return("Target path for zip download could be opened. Exiting...");
-		}
-		std::cout << "...download done." << std::endl;
+		std::cout << std::endl;
+		return Return(error + " Exiting...");
 	}
-	else
+	std::cout << std::endl << "...download done." << std::endl;
+
+	// Verify zip before anything is extracted
+	if (hasher.GetHexDigest() != expectedChecksum)
 	{
-		return Return("CURL could not be instantiated. Exiting...");
+		downloader.Discard();
+		return Return("Checksum of downloaded zip does not match. Exiting...");
 	}
+	std::cout << "Checksum verified." << std::endl;
 
 	// ### UNPACK NEW VERSION INTO TMP ##
 
 	std::cout << "Unzipping new version";
 
-	// Try to open archive
+	// Try to open archive from downloaded data
 	mz_zip_archive zip_archive;
 	memset(&zip_archive, 0, sizeof(zip_archive));
-	auto status = mz_zip_reader_init_file(&zip_archive, tmpZipPath.c_str(), 0);
+	auto status = mz_zip_reader_init_mem(&zip_archive, zipData.data(), zipData.size(), 0);
 
 	// Check for success
 	if (!status)
@@ -223,7 +235,7 @@ int main()
 		{
 			mz_zip_reader_end(&zip_archive);
 			std::experimental::filesystem::remove(tmpZipPath.c_str());
-			std::experimental::filesystem::remove(tmpUnzipPath.c_str());
+			std::experimental::filesystem::remove_all(tmpUnzipPath.c_str());
 			std::cout << std::endl;
 			return Return("Temporary zip file could not be read. Exiting...");
 		}
@@ -238,9 +250,13 @@ int main()
 				std::experimental::filesystem::create_directory(path); // create the directory if not existing
 			}
 		}
-		else // file
+		else if (!mz_zip_reader_extract_to_file(&zip_archive, i, path.c_str(), 0)) // unzip it, miniz streams entry into file
 		{
-			mz_zip_reader_extract_to_file(&zip_archive, i, path.c_str(), 0); // unzip it
+			mz_zip_reader_end(&zip_archive);
+			std::experimental::filesystem::remove(tmpZipPath.c_str());
+			std::experimental::filesystem::remove_all(tmpUnzipPath.c_str());
+			std::cout << std::endl;
+			return Return("File could not be extracted: " + path + " Exiting...");
 		}
 
 		// Show progress
@@ -249,6 +265,7 @@ int main()
 
 	// Close the archive, freeing any resources it was using
 	mz_zip_reader_end(&zip_archive);
+	std::vector<unsigned char>().swap(zipData);
 
 	std::cout << "...unzipping done." << std::endl;
 
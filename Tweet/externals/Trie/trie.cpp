@@ -5,184 +5,462 @@
 #include <string>
 #include <sstream>
 #include <set>
+#include <queue>
+#include <algorithm>
+#include <cstring>
+#include <cstdio>
 
 #include <fstream>
 #include <iostream>
 
+#include <sys/stat.h>
+
+#ifdef _WIN32
+#define NOMINMAX // std::min and std::max are used
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 
+// Header of prebuilt dictionary file, followed by the nodes
+struct TrieFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t nodeCount;
+    uint32_t wordCount;
+};
+
+static const char TRIE_FILE_MAGIC[4] = { 'G', 'T', 'W', 'T' };
+static const uint32_t TRIE_FILE_VERSION = 1;
+static_assert(sizeof(Trie::Node) == 16, "Nodes are mapped from file and must not change their layout");
+
+/**
+* Read-only mapping of a complete file into memory
+*/
+class MappedFile {
+public:
+    MappedFile(const std::string &path) {
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE)
+            return;
+        LARGE_INTEGER fileSize;
+        if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0)
+            return;
+        mappingHandle = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mappingHandle == NULL)
+            return;
+        data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+        if (data != NULL)
+            size = (size_t)fileSize.QuadPart;
+#else
+        int descriptor = open(path.c_str(), O_RDONLY);
+        if (descriptor < 0)
+            return;
+        struct stat fileStat;
+        if (fstat(descriptor, &fileStat) == 0 && fileStat.st_size > 0) {
+            void *pointer = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+            if (pointer != MAP_FAILED) {
+                data = pointer;
+                size = (size_t)fileStat.st_size;
+            }
+        }
+        close(descriptor); // mapping stays valid
+#endif
+    }
+
+    ~MappedFile() {
+#ifdef _WIN32
+        if (data != NULL)
+            UnmapViewOfFile(data);
+        if (mappingHandle != NULL)
+            CloseHandle(mappingHandle);
+        if (file != INVALID_HANDLE_VALUE)
+            CloseHandle(file);
+#else
+        if (data != NULL)
+            munmap(const_cast<void *>(data), size);
+#endif
+    }
+
+    const void *data = NULL;
+    size_t size = 0;
+
+private:
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mappingHandle = NULL;
+#endif
+};
+
 /**
-* Constructor of the Tree Class
-* Keyboard uses it for the Wordcomplition
-* @param[in] first Node must be empty
+* Returns modification time of file, zero if it does not exist
+* @param[in] path path of file
 */
-Trie::Trie(const string &val = "") {
-    value = val;
-    flag = false;
+static time_t modificationTime(const std::string &path) {
+    struct stat fileStat;
+    if (stat(path.c_str(), &fileStat) != 0)
+        return 0;
+    return fileStat.st_mtime;
 }
 
 /**
-* Function of the Tree Class
-* searches after a word in the Trie-Tree
-* @param[in] word variable used for the search
+* Constructor of the Trie Class
+* Keyboard uses it for the Wordcomplition, dictionary is set with loadDict
 */
-string Trie::find(const string &word) {
-    Trie * node = this;
-    for (size_t i = 0; i < word.length(); i++) {
-        const char c = word[i];
-        if (node->children.find(c) == node->children.end())
-            return "";
-        else
-            node = &node->children[c];
-    }
-    return node->value;
+Trie::Trie() : nodes(NULL), nodeCount(0), unsavedCount(0) {
 }
 
-//------------------------------------------------------------------
 /**
-* Function of the Tree Class
-* Adds Word to the Trie-Tree
-* @param[in] word variable used for the insert
+* Destructor of the Trie Class, saves learned words and unmaps the dictionary
 */
-void Trie::insert(const string &word) {
-    Trie * node = this;
-    for (size_t i = 0; i < word.length(); i++) {
-        const char c = word[i];
-        if (node->children.find(c) == node->children.end())
-            node->add(c);
-        node = &node->children[c];
-    }
-    node->flag = true;
+Trie::~Trie() {
+    flushLearned();
 }
 
 /**
 * Function of the Tree Class
-* Adds Char to the Trie-Tree
-* used by the insert function
-* @param[in] Char variable used for the insert
+* Builds the prebuilt dictionary file from a text dictionary
+* Lines contain either a word, ranked by its line, or a word followed by its count
+* @param[in] dict path of the text dictionary
+* @param[in] out path of the prebuilt file
 */
-void Trie::add(char c) {
-    if (value == "")
-        children[c] = Trie(string(1, c));
-    else
-        children[c] = Trie(value + c);
+bool Trie::buildDict(std::string dict, std::string out) {
+    std::ifstream inf(dict);
+    if (!inf.is_open() || inf.fail()) {
+        cout << "Error opening Dictionary file: " << dict << endl;
+        return false;
+    }
+
+    // Read words with their frequency
+    vector<pair<string, uint32_t> > words;
+    std::string line;
+    while (getline(inf, line)) {
+        if (!line.empty() && line.back() == '\r')
+            line.pop_back();
+        std::istringstream lineStream(line);
+        std::string word;
+        long long count = -1;
+        if (!(lineStream >> word))
+            continue;
+        lineStream >> count;
+        words.push_back(make_pair(word, count > 0 ? (uint32_t)count : 0));
+    }
+    const uint32_t lineCount = (uint32_t)words.size();
+    for (size_t i = 0; i < words.size(); i++) {
+        if (words[i].second == 0)
+            words[i].second = lineCount - (uint32_t)i; // first line is most frequent word
+    }
+
+    // Insert words into temporary pointer-free trie
+    struct BuildNode {
+        map<char, uint32_t> children;
+        uint32_t frequency = 0;
+    };
+    vector<BuildNode> buildNodes(1);
+    for (const auto &rWord : words) {
+        uint32_t current = 0;
+        for (char c : rWord.first) {
+            auto child = buildNodes[current].children.find(c);
+            if (child == buildNodes[current].children.end()) {
+                buildNodes[current].children[c] = (uint32_t)buildNodes.size();
+                current = (uint32_t)buildNodes.size();
+                buildNodes.push_back(BuildNode());
+            }
+            else {
+                current = child->second;
+            }
+        }
+        buildNodes[current].frequency = std::max(buildNodes[current].frequency, rWord.second);
+    }
+
+    // Flatten in breadth first order, so children of every node are contiguous
+    vector<Node> flat(1);
+    vector<uint32_t> order(1, 0); // build node of every flat node
+    flat[0] = Node();
+    for (size_t i = 0; i < order.size(); i++) {
+        const BuildNode &rBuildNode = buildNodes[order[i]];
+        flat[i].frequency = rBuildNode.frequency;
+        flat[i].firstChild = (uint32_t)flat.size();
+        flat[i].childCount = (uint16_t)rBuildNode.children.size();
+        for (const auto &rChild : rBuildNode.children) {
+            Node node = Node();
+            node.label = rChild.first;
+            flat.push_back(node);
+            order.push_back(rChild.second);
+        }
+    }
+
+    // Propagate maximum frequency upwards, children always come after their parent
+    for (size_t i = flat.size(); i-- > 0;) {
+        uint32_t maxFrequency = flat[i].frequency;
+        for (uint32_t j = 0; j < flat[i].childCount; j++)
+            maxFrequency = std::max(maxFrequency, flat[flat[i].firstChild + j].maxFrequency);
+        flat[i].maxFrequency = maxFrequency;
+    }
+
+    // Write file
+    std::ofstream outf(out, std::ios::binary | std::ios::trunc);
+    if (!outf.is_open()) {
+        cout << "Error writing prebuilt Dictionary: " << out << endl;
+        return false;
+    }
+    TrieFileHeader header;
+    memcpy(header.magic, TRIE_FILE_MAGIC, sizeof(header.magic));
+    header.version = TRIE_FILE_VERSION;
+    header.nodeCount = (uint32_t)flat.size();
+    header.wordCount = lineCount;
+    outf.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    outf.write(reinterpret_cast<const char *>(flat.data()), flat.size() * sizeof(Node));
+    return outf.good();
 }
-//------------------------------------------------------------------
 
 /**
 * Function of the Tree Class
-* searches all Prefixes
+* Load Dictionary from File. The prebuilt file next to it is (re)built if
+* missing or outdated and then mapped into memory
+* @param[in] dict variable is the Dictionary-Path
 */
-vector<string> Trie::all_prefixes() {
-    vector<string> results;
-    if (flag)
-        results.push_back(value);
-
-    if (children.size()) {
-        map<char, Trie>::iterator iter;
-        vector<string>::iterator node;
-        for (iter = children.begin(); iter != children.end(); iter++) {
-            vector<string> nodes = iter->second.all_prefixes();
-            results.insert(results.end(), nodes.begin(), nodes.end());
+void Trie::loadDict(std::string dict) {
+    flushLearned();
+    mapping.reset();
+    nodes = NULL;
+    nodeCount = 0;
+    learned.clear();
+    dictPath = dict;
+
+    std::cout << "Keyboard: Opening Dictionary: " << dict << std::endl;
+
+    // Build prebuilt file if required
+    const std::string prebuilt = dict + ".bin";
+    const time_t prebuiltTime = modificationTime(prebuilt);
+    if (prebuiltTime == 0 || prebuiltTime < modificationTime(dict)) {
+        if (!buildDict(dict, prebuilt))
+            return;
+    }
+
+    // Map it and validate header
+    for (int attempt = 0; attempt < 2 && nodes == NULL; attempt++) {
+        mapping = std::unique_ptr<MappedFile>(new MappedFile(prebuilt));
+        const TrieFileHeader *pHeader = static_cast<const TrieFileHeader *>(mapping->data);
+        if (pHeader != NULL
+            && mapping->size >= sizeof(TrieFileHeader)
+            && memcmp(pHeader->magic, TRIE_FILE_MAGIC, sizeof(pHeader->magic)) == 0
+            && pHeader->version == TRIE_FILE_VERSION
+            && pHeader->nodeCount > 0
+            && mapping->size >= sizeof(TrieFileHeader) + pHeader->nodeCount * sizeof(Node)) {
+            nodes = reinterpret_cast<const Node *>(pHeader + 1);
+            nodeCount = pHeader->nodeCount;
+        }
+        else { // file of other version or damaged, build it again
+            mapping.reset();
+            if (attempt > 0 || !buildDict(dict, prebuilt)) {
+                cout << "Error loading prebuilt Dictionary: " << prebuilt << endl;
+                break;
+            }
         }
     }
-    return results;
+
+    // Load words learned so far
+    std::ifstream learnedFile(dict + ".learned");
+    std::string word;
+    uint32_t count;
+    while (learnedFile >> word >> count)
+        learned[word] = count;
 }
 
 /**
 * Function of the Tree Class
-* Seaches Trie-Tree for words on hand of the prefix
-* @param[in] prefix variable used for the Search
+* Searches node of word or prefix
+* @param[in] word variable used for the search
 */
-vector<string> Trie::autocomplete(const string &prefix) {
-    Trie * node = this;
-    vector<string> results;
-    for (size_t i = 0; i < prefix.length(); i++) {
-        const char c = prefix[i];
-        if (node->children.find(c) == node->children.end())
-            return results;
-        else
-            node = &node->children[c];
+const Trie::Node *Trie::findNode(const string &word) const {
+    if (nodes == NULL)
+        return NULL;
+    const Node *node = nodes;
+    for (size_t i = 0; i < word.length(); i++) {
+        const Node *first = nodes + node->firstChild;
+        const Node *last = first + node->childCount;
+        const char c = word[i];
+        const Node *child = std::lower_bound(first, last, c, [](const Node &rNode, char label) { return rNode.label < label; });
+        if (child == last || child->label != c)
+            return NULL;
+        node = child;
     }
-    return node->all_prefixes();
+    return node;
 }
 
+/**
+* Function of the Tree Class
+* Returns frequency of word in the dictionary, zero if not contained
+* @param[in] word variable used for the search
+*/
+uint32_t Trie::find(const string &word) const {
+    const Node *node = findNode(word);
+    return node != NULL ? node->frequency : 0;
+}
 
-/*
-TODO
---Save Trie-Tree to file (if possible)
---load Trie-Tree from file (if possible)
+/**
+* Function of the Tree Class
+* Boost of ranking per time a word was typed
 */
+uint32_t Trie::learnWeight() const {
+    return (nodes != NULL ? nodes->maxFrequency / 100 : 0) + 1;
+}
 
 /**
 * Function of the Tree Class
-* Load Dictionary from File
-* @param[in] dict variable is the Dictionary-Path
+* Returns the most frequent words starting with the prefix, most frequent first
+* @param[in] prefix variable used for the Search
+* @param[in] count maximum number of returned words
 */
-void Trie::loadDict(std::string dict) {
-    Trie * trie = this;
+vector<string> Trie::autocomplete(const string &prefix, size_t count) {
+    vector<string> results;
+    if (count == 0)
+        return results;
 
-    std::ifstream inf;
-    std::string word;
+    // Candidate of best first search, either a subtree or a complete word
+    struct Candidate {
+        uint32_t rank;
+        uint32_t node;
+        bool complete;
+        string word;
+        bool operator<(const Candidate &rOther) const { // top of queue is best candidate
+            if (rank != rOther.rank)
+                return rank < rOther.rank;
+            if (complete != rOther.complete)
+                return !complete;
+            return word > rOther.word;
+        }
+    };
 
-    std::cout << "Keyboard: Opening Dictionary: " << dict << std::endl;
-    //inf.open("dict.txt");
-    inf.open(dict);
-
-    if (!inf.is_open() || inf.fail())
-        cout << "Error opening Dictionary file - quit\n";
-    while (getline(inf, word)) {
-        trie->insert(word);
-        if (inf.bad())
-            perror("error while reading file");
+    // Collect best words of dictionary, only expanding subtrees that may contain better words
+    vector<pair<uint32_t, string> > ranked;
+    const Node *start = findNode(prefix);
+    if (start != NULL) {
+        priority_queue<Candidate> queue;
+        queue.push(Candidate{ start->maxFrequency, (uint32_t)(start - nodes), false, prefix });
+        while (!queue.empty() && ranked.size() < count) {
+            Candidate candidate = queue.top();
+            queue.pop();
+            if (candidate.complete) {
+                ranked.push_back(make_pair(candidate.rank, candidate.word));
+                continue;
+            }
+            const Node &rNode = nodes[candidate.node];
+            if (rNode.frequency > 0)
+                queue.push(Candidate{ rNode.frequency, candidate.node, true, candidate.word });
+            for (uint32_t i = 0; i < rNode.childCount; i++) {
+                const Node &rChild = nodes[rNode.firstChild + i];
+                queue.push(Candidate{ rChild.maxFrequency, rNode.firstChild + i, false, candidate.word + rChild.label });
+            }
+        }
+    }
+
+    // Learned words with that prefix compete with their boosted frequency
+    const uint32_t weight = learnWeight();
+    for (auto iter = learned.lower_bound(prefix); iter != learned.end() && iter->first.compare(0, prefix.length(), prefix) == 0; iter++) {
+        const uint32_t rank = find(iter->first) + iter->second * weight;
+        auto existing = std::find_if(ranked.begin(), ranked.end(), [&](const pair<uint32_t, string> &rEntry) { return rEntry.second == iter->first; });
+        if (existing != ranked.end())
+            existing->first = rank;
+        else
+            ranked.push_back(make_pair(rank, iter->first));
     }
-    inf.clear(); // clear eof and fail bits
-    inf.seekg(0, ios::beg);
-    inf.close();
+
+    // Sort and limit
+    std::stable_sort(ranked.begin(), ranked.end(), [](const pair<uint32_t, string> &rA, const pair<uint32_t, string> &rB) { return rA.first > rB.first; });
+    for (size_t i = 0; i < ranked.size() && i < count; i++)
+        results.push_back(ranked[i].second);
+    return results;
 }
 
 /**
 * Function of the Tree Class
-* Load Dictionary from File
-* @param[in] dict variable is the Dictionary-Path
-* @param[in] line variable is the String added to the Dictionary
+* Learns a typed word, so it is ranked higher in later completions
+* @param[in] word variable which was typed
 */
-void Trie::addLinetoDict(std::string dict, std::string line) {
-    std::ofstream out(dict, std::ios::app);
-    out << line + "\n";
+void Trie::learn(const string &word) {
+    if (word.empty() || dictPath.empty())
+        return;
+    learned[word]++;
+    learnedChanged();
 }
 
 /**
 * Function of the Tree Class
-* Load Dictionary from File
-* @param[in] dict variable is the Dictionary-Path
-* @param[in] line variable is the String which should be deleted in the Dictionary
+* Adds word to the Dictionary. It is learned with a count that brings it to the top
+* @param[in] word variable is the String added to the Dictionary
 */
-void Trie::deleteLineinDict(std::string dict, std::string line) {
+void Trie::addWord(const string &word) {
+    if (word.empty() || dictPath.empty())
+        return;
+    learned[word] = std::max(learned[word], (uint32_t)100);
+    learnedChanged();
+}
 
-    ifstream dictionary(dict);
-    ofstream temp("temp.txt"); // temp file for input of every student except the one user wants to delete
-    std::string word;
+/**
+* Function of the Tree Class
+* Removes word from the Dictionary, including its learned count
+* @param[in] word variable is the String which should be deleted in the Dictionary
+*/
+void Trie::removeWord(const string &word) {
+    if (dictPath.empty())
+        return;
+    learned.erase(word);
+    flushLearned();
 
-    while (getline(dictionary, word)) {
+    if (find(word) == 0)
+        return;
 
-        if (word != line) {
-            temp << word + "\n";
-        }
-        else {
+    // Remove word from text dictionary and rebuild prebuilt file on load
+    ifstream dictionary(dictPath);
+    const std::string tempPath = dictPath + ".tmp";
+    ofstream temp(tempPath);
+    std::string line;
+    while (getline(dictionary, line)) {
+        std::istringstream lineStream(line);
+        std::string lineWord;
+        lineStream >> lineWord;
+        if (lineWord != word)
+            temp << line + "\n";
+        else
             std::cout << "Word == " + word + " == was deleted" << std::endl;
-        }
-
     }
-
-    dictionary.clear(); // clear eof and fail bits
-    dictionary.seekg(0, ios::beg);
     dictionary.close();
     temp.close();
 
+    mapping.reset(); // Windows does not remove mapped files
+    nodes = NULL;
+    remove(dictPath.c_str());
+    rename(tempPath.c_str(), dictPath.c_str());
+    remove((dictPath + ".bin").c_str());
+    loadDict(dictPath);
+}
 
-    const char * c = dict.c_str();
+/**
+* Function of the Tree Class
+* Writes learned words next to the Dictionary if some changed since last write
+*/
+void Trie::flushLearned() {
+    if (unsavedCount == 0 || dictPath.empty())
+        return;
+    unsavedCount = 0;
+    std::ofstream out(dictPath + ".learned", std::ios::trunc);
+    for (const auto &rEntry : learned)
+        out << rEntry.first << " " << rEntry.second << "\n";
+}
 
-    remove(c);
-    rename("temp.txt", c);
+/**
+* Function of the Tree Class
+* Counts change of learned words. Whole file is rewritten, so it is written
+* only after some changes and otherwise on flush or destruction
+*/
+void Trie::learnedChanged() {
+    if (++unsavedCount >= LEARNED_SAVE_INTERVAL)
+        flushLearned();
 }
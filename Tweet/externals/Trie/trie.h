@@ -4,6 +4,13 @@
 * Author : Vivek Narayanan
 
 Modified for "GazeTheWeb - Tweet" application (01/01/2016)
+
+Rewritten as compact, frequency-ranked trie: nodes are stored in one flat
+array with the children of a node next to each other. The array is prebuilt
+from the text dictionary once and afterwards mapped directly from file. Every
+node knows the highest word frequency within its subtree, so the best words
+for a prefix are found without enumerating all completions. Words typed by
+the user are learned and ranked higher.
 */
 
 #include <map>
@@ -11,22 +18,54 @@ Modified for "GazeTheWeb - Tweet" application (01/01/2016)
 #include <string>
 #include <sstream>
 #include <set>
+#include <memory>
+#include <cstdint>
 
 using namespace std;
 
+class MappedFile;
+
 class Trie {
 public:
-    map<char, Trie> children;
-    string value;
-    bool flag;
-
-    Trie(const string &);
-    void add(char);
-    string find(const string &);
-    void insert(const string &);
-    vector<string> all_prefixes();
-    vector<string> autocomplete(const string &);
+
+    // Node of the flat trie as stored in the prebuilt file
+    struct Node {
+        uint32_t firstChild; // index of first child, children are contiguous and sorted by label
+        uint32_t frequency; // zero if no word ends here
+        uint32_t maxFrequency; // highest frequency within subtree, including node itself
+        uint16_t childCount;
+        char label;
+        uint8_t reserved;
+    };
+
+    Trie();
+    ~Trie();
+
     void loadDict(std::string);
-    void addLinetoDict(std::string, std::string);
-    void deleteLineinDict(std::string, std::string);
+    vector<string> autocomplete(const string &, size_t);
+    uint32_t find(const string &) const;
+    void learn(const string &);
+    void addWord(const string &);
+    void removeWord(const string &);
+    void flushLearned();
+
+    static bool buildDict(std::string, std::string);
+
+private:
+
+    Trie(const Trie &) = delete;
+    Trie &operator=(const Trie &) = delete;
+
+    const Node *findNode(const string &) const;
+    uint32_t learnWeight() const;
+    void learnedChanged();
+
+    static const uint32_t LEARNED_SAVE_INTERVAL = 20; // changes of learned words until file is rewritten
+
+    std::string dictPath;
+    std::unique_ptr<MappedFile> mapping;
+    const Node *nodes;
+    uint32_t nodeCount;
+    map<string, uint32_t> learned; // typed words with their count, sorted for prefix lookup
+    uint32_t unsavedCount; // changes of learned words since last write
 };
@@ -0,0 +1,94 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#include "FrameScheduler.h"
+
+#include <cmath>
+#include <thread>
+#include <iostream>
+
+// Seconds between printing of frame statistics
+static const float STATISTICS_INTERVAL = 60.f;
+
+/**
+* Constructor for the FrameScheduler
+* @param[in] lingerDuration seconds frames are composed after last damage
+* @param[in] maxIdleDuration seconds after which a frame is composed in any case
+* @param[in] idlePollRate times per second input is polled while idle
+* @param[in] inputThreshold pixels input has to move to add damage
+*/
+FrameScheduler::FrameScheduler(float lingerDuration, float maxIdleDuration, float idlePollRate, float inputThreshold) :
+    lingerDuration(lingerDuration), maxIdleDuration(maxIdleDuration), idlePollRate(idlePollRate), inputThreshold(inputThreshold) {
+    lastPoll = std::chrono::steady_clock::now();
+}
+
+/**
+* addDamage function
+* Marks current frame to be composed
+*/
+void FrameScheduler::addDamage() {
+    damaged = true;
+}
+
+/**
+* updateInput function
+* Adds damage when input moved far enough since last composed frame
+* @param[in] x horizontal input coordinate
+* @param[in] y vertical input coordinate
+*/
+void FrameScheduler::updateInput(int x, int y) {
+    float dX = (float)(x - lastX);
+    float dY = (float)(y - lastY);
+    if (std::sqrt(dX * dX + dY * dY) > inputThreshold) {
+        addDamage();
+        lastX = x;
+        lastY = y;
+    }
+}
+
+/**
+* shouldCompose function
+* Decides whether current frame is composed and collects statistics
+* @param[in] deltaTime seconds since last iteration
+* @return whether frame has to be composed
+*/
+bool FrameScheduler::shouldCompose(float deltaTime) {
+    timeSinceDamage += deltaTime;
+    timeSinceComposition += deltaTime;
+    if (damaged) {
+        timeSinceDamage = 0.f;
+        damaged = false;
+    }
+
+    // Compose while damage is recent, but at least from time to time
+    bool compose = timeSinceDamage <= lingerDuration || timeSinceComposition >= maxIdleDuration;
+    if (compose) {
+        timeSinceComposition = 0.f;
+        composedFrameCount++;
+    } else {
+        idleFrameCount++;
+    }
+
+    statisticsTime += deltaTime;
+    if (statisticsTime >= STATISTICS_INTERVAL) {
+        std::cout << "FrameScheduler: " << composedFrameCount << " composed and " << idleFrameCount
+            << " idle frames within " << statisticsTime << " seconds" << std::endl;
+        statisticsTime = 0.f;
+        composedFrameCount = 0;
+        idleFrameCount = 0;
+    }
+
+    return compose;
+}
+
+/**
+* waitForNextPoll function
+* Sleeps for remaining time of poll interval since last wait
+*/
+void FrameScheduler::waitForNextPoll() {
+    auto pollInterval = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<float>(1.f / idlePollRate));
+    std::this_thread::sleep_until(lastPoll + pollInterval);
+    lastPoll = std::chrono::steady_clock::now();
+}
@@ -0,0 +1,51 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#pragma once
+
+#include <chrono>
+
+/**
+* Decides whether the main loop has to compose a frame. Damage like input
+* movement or finished image downloads is added during an iteration. Frames
+* are composed for a while after the last damage, so animations of eyeGUI
+* can finish. Otherwise the loop skips rendering and polls input at a lower
+* rate. Counts of composed and idle frames are printed periodically.
+*/
+class FrameScheduler {
+
+public:
+
+    FrameScheduler(float lingerDuration, float maxIdleDuration, float idlePollRate, float inputThreshold);
+
+    // Add damage which requires composition of frame
+    void addDamage();
+
+    // Add damage when input moved beyond threshold since last composed frame
+    void updateInput(int x, int y);
+
+    // Decide whether current frame is composed, call once per iteration after damage has been added
+    bool shouldCompose(float deltaTime);
+
+    // Sleep until next poll of input is due, call instead of swapping buffers
+    void waitForNextPoll();
+
+private:
+
+    float lingerDuration;
+    float maxIdleDuration;
+    float idlePollRate;
+    float inputThreshold;
+
+    bool damaged = true;
+    float timeSinceDamage = 0.f;
+    float timeSinceComposition = 0.f;
+    int lastX = 0;
+    int lastY = 0;
+    std::chrono::steady_clock::time_point lastPoll;
+
+    float statisticsTime = 0.f;
+    unsigned int composedFrameCount = 0;
+    unsigned int idleFrameCount = 0;
+};
@@ -3,7 +3,7 @@
 //============================================================================
 
 #include "ActionBar.h"
-#include "src/TwitterClient/ImageDownload.h"
+#include "src/TwitterApp.h"
 
 /**
 * Constructor for the ActionBar Class
@@ -178,8 +178,8 @@ void ActionBar::openImageFrame() {
     eyegui::registerButtonListener(pLayout, "imageLeft", imageFrameButtonListener);
     eyegui::registerButtonListener(pLayout, "imageRight", imageFrameButtonListener);
     picIndex = 0;
-    renewImage();
     imageFrameOpen = true;
+    renewImage();
 }
 
 /**
@@ -188,20 +188,14 @@ void ActionBar::openImageFrame() {
 */
 void ActionBar::renewImage() {
 
-    // Download avatar image:
-    std::string str = mediaLinks.at(picIndex);
-
-    // Extract file extension
-    size_t i = str.rfind('.', str.length());
-    std::string ext = str.substr(i + 1, str.length() - i);
-
-    // Set filename using this rule: profile_ + Profile ID + extension
-    std::string filename = "img/tmp/picture_" + str.substr(str.size() - 9, str.size() - 5) + "." + ext;
-
-    std::string path = CONTENT_PATH + std::string("/") + filename;
-    download_image((char*)str.c_str(), (char*)path.c_str());
-    eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-    eyegui::replaceElementWithPicture(pLayout, "shownPicture", filename, alignment, false);
+    // Download media image, shown when available unless user has moved on
+    const int shownIndex = picIndex;
+    TwitterApp::getInstance()->getImageDownloader()->request(mediaLinks.at(picIndex), [this, shownIndex](std::string filename) {
+        if (imageFrameOpen && shownIndex == picIndex) {
+            eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
+            eyegui::replaceElementWithPicture(pLayout, "shownPicture", filename, alignment, false);
+        }
+    });
 }
 
 /**
@@ -4,7 +4,6 @@
 
 #include "WallContentArea.h"
 #include "src/TwitterApp.h"
-#include "src/TwitterClient/ImageDownload.h"
 #include <string>
 
 /**
@@ -162,6 +161,8 @@ bool WallContentArea::getRetweetedAt(int i) {
 * shows the the tweets wich where found
 */
 void WallContentArea::showTweets() {
+    ImageDownloader* imageDownloader = TwitterApp::getInstance()->getImageDownloader();
+    const int currentShowCount = ++showCount;
     std::string temp = "\n";
     for (rapidjson::SizeType i = tweetIndex; (i < content.Size()) && (i < tweetIndex + 4); i++) {
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i-tweetIndex)], content[i]["user"]["name"].GetString()+temp+content[i]["text"].GetString());
@@ -173,26 +174,38 @@ void WallContentArea::showTweets() {
 		}
         eyegui::setContentOfTextBlock(pLayout, textboxes[3 * (i - tweetIndex) + 2], "Retweets: " + std::to_string(content[i]["retweet_count"].GetInt()));
 
-        // Download avatar image:
-        std::string str = content[i]["user"]["profile_image_url"].GetString();
+        // Show default avatar until image is available. Cached images replace it immediately
+        std::string id = "profilePic" + std::to_string(i - tweetIndex + 1);
+        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
+        eyegui::replaceElementWithPicture(pLayout, id, "img/profile_default.png", alignment, false);
+        imageDownloader->request(getAvatarUrlAt(i), [this, id, currentShowCount](std::string filename) {
+            if (currentShowCount == showCount) {
+                eyegui::replaceElementWithPicture(pLayout, id, filename, eyegui::ImageAlignment::ORIGINAL, false);
+            }
+        });
+    }
 
-        // Extract file extension
-        size_t z = str.rfind('.', str.length());
-        std::string ext = str.substr(z + 1, str.length() - z);
+    // Prefetch avatars of next page
+    for (rapidjson::SizeType i = tweetIndex + 4; (i < content.Size()) && (i < tweetIndex + 8); i++) {
+        imageDownloader->prefetch(getAvatarUrlAt(i));
+    }
+}
 
-        // Set filename using this rule: profile_ + Profile ID + extension
-        std::string filename = "img/tmp/profile_" + std::string(content[i]["user"]["id_str"].GetString()) + "." + ext;
+/**
+* getAvatarUrlAt function
+* Getter of the url of the avatar image of the tweet author
+* @param[in] i is the index of the tweet
+* @param[out] string of the url with the profile image in the size of 400x400 pixels
+*/
+std::string WallContentArea::getAvatarUrlAt(rapidjson::SizeType i) {
+    std::string str = content[i]["user"]["profile_image_url"].GetString();
 
-        // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
-        int index = str.find("_normal.");
+    // Replace substring '_normal.' with '_400x400' to get profile image in the size of 400x400 pixels.
+    size_t index = str.find("_normal.");
+    if (index != std::string::npos) {
         str = str.replace(index, 8, "_400x400.");
-
-        std::string path = CONTENT_PATH + std::string("/") + filename;
-        download_image((char*)str.c_str(), (char*)path.c_str());
-
-        eyegui::ImageAlignment alignment = eyegui::ImageAlignment::ORIGINAL;
-        eyegui::replaceElementWithPicture(pLayout, "profilePic"+std::to_string(i - tweetIndex+1), filename, alignment, false);
     }
+    return str;
 }
 
 /**
@@ -246,6 +259,10 @@ void WallContentArea::selectTweet(std::string id) {
                     {
                         links.push_back(content[stoi(currentlySelected) + tweetIndex]["extended_entities"]["media"][i]["media_url"].GetString());
                     }
+                    for (const auto& rLink : links)
+                    {
+                        TwitterApp::getInstance()->getImageDownloader()->prefetch(rLink);
+                    }
                     TwitterApp::getInstance()->actionButtonArea->mediaLinks = links;
                     TwitterApp::getInstance()->actionButtonArea->changeToTweetsWithPics(getTweetIdAt(stoi(currentlySelected)), getTweetUser(stoi(currentlySelected)), getLikedAt(stoi(currentlySelected)), getRetweetedAt(stoi(currentlySelected)), getOwnAt(stoi(currentlySelected)));
 
@@ -31,6 +31,8 @@ private:
     bool getLikedAt(int i);
     bool getRetweetedAt(int i);
     bool getOwnAt(int i);
+    std::string getAvatarUrlAt(rapidjson::SizeType i);
+    int showCount = 0; // identifies latest call of showTweets, so late downloads do not replace newer avatars
     std::string currentlySelected = "none";
     std::shared_ptr<WallButton> wallButtonListener = std::shared_ptr<WallButton>(new WallButton);
     rapidjson::Document content;
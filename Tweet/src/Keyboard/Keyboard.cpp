@@ -5,6 +5,7 @@
 #include "Keyboard.h"
 #include "src/TwitterApp.h"
 #include <string>
+#include <sstream>
 
 /**
 * Constructor for the Keyboard
@@ -123,6 +124,7 @@ void Keyboard::init() {
 * Tweeting string variable "ausgabe" through TwitterApp
 */
 void Keyboard::tweet() {
+    learnWords(ausgabe);
     TwitterApp::getInstance()->getTwitter()->statusUpdate(ausgabe);
     TwitterApp::getInstance()->wallContentArea->updateNewsFeed(true);
     abort();
@@ -134,6 +136,7 @@ void Keyboard::tweet() {
 */
 void Keyboard::respond() {
     //std::cout << tweetid << std::endl;
+    learnWords(ausgabe);
     TwitterApp::getInstance()->getTwitter()->reply(ausgabe, tweetid);
     TwitterApp::getInstance()->wallContentArea->updateNewsFeed(false);
     abort();
@@ -580,7 +583,7 @@ Todo
 */
 void Keyboard::showWordComp() {
 
-    v = trie.autocomplete(tempWord);
+    v = trie.autocomplete(tempWord, WORD_COMP_COUNT);
 
     if (v.size() >= 3) {
         Wcount = 3;
@@ -860,6 +863,7 @@ void Keyboard::WordmoveLeft() {
 void Keyboard::writeWordComp(int Wordcase){
     useWordComp = false;
     if (Wordcase == 1 && word1.length() > 0) {
+        trie.learn(word1);
         for (size_t i = 0; i < tempWord.length(); i++) {
             deleteKey2();
         }
@@ -877,6 +881,7 @@ void Keyboard::writeWordComp(int Wordcase){
     }
 
     if (Wordcase == 2 && word2.length() > 0) {
+        trie.learn(word2);
         for (size_t i = 0; i < tempWord.length(); i++) {
             deleteKey2();
         }
@@ -893,6 +898,7 @@ void Keyboard::writeWordComp(int Wordcase){
     }
 
     if (Wordcase ==3 && word3.length() > 0) {
+        trie.learn(word3);
         for (size_t i = 0; i < tempWord.length(); i++) {
             deleteKey2();
         }
@@ -935,19 +941,32 @@ void Keyboard::addClipboardtoOut() {
 }
 
 /**
-* Function adds ausgabe as a new line to the Dictionary
+* Function learns all words of the given text for the Wordcompletion
+* @param[in] text typed by the user
+*/
+void Keyboard::learnWords(const std::string& text) {
+    std::istringstream stream(text);
+    std::string word;
+    while (stream >> word) {
+        // Strip punctuation at the end of the word
+        while (!word.empty() && std::string(".,;:!?\"')").find(word.back()) != std::string::npos)
+            word.pop_back();
+        trie.learn(word);
+    }
+}
+
+/**
+* Function adds ausgabe as a new word to the Dictionary
 */
 void Keyboard::addLinetoDict() {
-    trie.addLinetoDict(dict,ausgabe);
+    trie.addWord(ausgabe);
 }
 
 /**
 * Function deletes ausgabe line from the Dictionary, if posssible
 */
 void Keyboard::deleteLineinDict() {
-    trie.deleteLineinDict(dict, ausgabe);
-    trie = Trie("");
-    trie.loadDict(dict);
+    trie.removeWord(ausgabe);
 
     ausgabe = "";
     currentCursorPos = 0;
@@ -988,19 +1007,18 @@ void Keyboard::clearInput() {
 */
 void Keyboard::changeDict(int lang) {
     if (lang == 0) {
-        dict = "../src/Keyboard/eng.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "eng.txt";
     }
     if (lang == 1) {
-        dict = "../src/Keyboard/ger.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "ger.txt";
     }
     if (lang == 2) {
-        dict = "../src/Keyboard/french.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "french.txt";
     }
     if (lang == 3) {
-        dict = "../src/Keyboard/dutch.txt";
+        dict = CONTENT_PATH + std::string("/dict/") + "dutch.txt";
     }
 
-    trie = Trie("");
     trie.loadDict(dict);
 
     tempWord = " ";
@@ -1012,7 +1030,7 @@ void Keyboard::changeDict(int lang) {
     eyegui::setContentOfTextBlock(pLayout2, "Word2", "");
     eyegui::setContentOfTextBlock(pLayout2, "Word3", "");
 
-    v = trie.autocomplete(tempWord);
+    v = trie.autocomplete(tempWord, WORD_COMP_COUNT);
 
     // Bug: has some problems with the first char after loading new Dictionary
     // so we write one char and delete it
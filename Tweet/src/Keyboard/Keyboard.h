@@ -79,7 +79,9 @@ public:
     int Wcount;
     std::string  tempWord, word1, word2, word3,dict;
     std::vector<std::string> v;
-    Trie trie = Trie("");
+    Trie trie;
+    static const size_t WORD_COMP_COUNT = 30; // words fetched for browsing with WordmoveRight
+    void learnWords(const std::string&);
 
     // Test login
     void setPLayout(eyegui::Layout* newLayout) { this->pLayout = newLayout; }
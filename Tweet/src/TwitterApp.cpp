@@ -31,6 +31,9 @@ TwitterApp::TwitterApp(int width, int height) {
 
     //-----------------------------------------------------------------------------------------------------
 
+    // Images of tweets are downloaded in the background and cached across runs
+    imageDownloader = new ImageDownloader(CONTENT_PATH, "img/cache");
+
     // Instantiate various interface Elements
     menueButtonArea = new MenueBar(pLayout);
     menueButtonArea->show();
@@ -377,5 +380,6 @@ void TwitterApp::render() {
 * terminates current Gui
 */
 TwitterApp::~TwitterApp() {
+    delete imageDownloader;
     eyegui::terminateGUI(pGUI);
 }
@@ -13,6 +13,7 @@
 #include "src/Interface_Elements/ContentAreaPages/ConnectPageArea.h"
 #include "src/Interface_Elements/ContentAreaPages/DiscoverPageArea.h"
 #include "src/Keyboard/Keyboard.h"
+#include "src/TwitterClient/ImageDownloader.h"
 #include "externals/eyeGUI-development/include/eyeGUI.h"
 
 // Just some constants to avoid typing errors, also you dont have to lookup the names always
@@ -38,6 +39,7 @@ public:
     void updateCurrentPage();
     ~TwitterApp();
     Twitter* getTwitter() { return twitter; }
+    ImageDownloader* getImageDownloader() { return imageDownloader; }
     void render();
     eyegui::GUI* getGUI();
     void changeState(int state);
@@ -71,6 +73,7 @@ public:
     twitCurl account;
     twitCurl account2;
     Keyboard* keyboard;
+    ImageDownloader* imageDownloader;
     bool terminate = false;
 
 private:
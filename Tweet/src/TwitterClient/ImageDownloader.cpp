@@ -0,0 +1,355 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#include "ImageDownloader.h"
+
+#include <experimental/filesystem>
+#include <algorithm>
+#include <cstdio>
+#include <cctype>
+#include <iostream>
+
+namespace fs = std::experimental::filesystem;
+
+/**
+* Write callback of the workers, writes into file
+*/
+static size_t write_file(void *ptr, size_t size, size_t nmemb, FILE *stream) {
+    return fwrite(ptr, size, nmemb, stream);
+}
+
+/**
+* Constructor for the ImageDownloader
+* Loads existing cache and starts worker threads
+* @param[in] contentPath path to content folder, images are stored inside
+* @param[in] cacheFolder folder of cache, relative to content path
+* @param[in] workerCount number of parallel downloads
+* @param[in] cacheLimit maximum size of cache in bytes
+*/
+ImageDownloader::ImageDownloader(std::string contentPath, std::string cacheFolder, int workerCount, uintmax_t cacheLimit) :
+    contentPath(contentPath), cacheFolder(cacheFolder), cacheLimit(cacheLimit), shouldStop(false) {
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+    loadCache();
+    for (int i = 0; i < workerCount; i++) {
+        workers.push_back(std::thread(&ImageDownloader::work, this));
+    }
+}
+
+/**
+* Destructor for the ImageDownloader
+* Drops queued downloads and waits for running ones
+*/
+ImageDownloader::~ImageDownloader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        shouldStop = true;
+        requestQueue.clear();
+        prefetchQueue.clear();
+    }
+    condition.notify_all();
+    for (auto& rWorker : workers) {
+        rWorker.join();
+    }
+    curl_global_cleanup();
+}
+
+/**
+* request function
+* Requests image of url
+* @param[in] url of the image
+* @param[in] callback is executed with filename of the image
+*/
+void ImageDownloader::request(std::string url, Callback callback) {
+    const std::string key = getKey(url);
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+
+        // Already cached, mark as recently used. Pinned while callback is executed without lock, so workers do not evict it
+        auto entry = entries.find(key);
+        if (entry != entries.end()) {
+            lru.splice(lru.begin(), lru, entry->second.lruPosition);
+            inUse[key]++;
+            lock.unlock();
+            std::error_code error;
+            fs::last_write_time(getPath(key), fs::file_time_type::clock::now(), error); // keeps order for next start
+            callback(cacheFolder + "/" + key);
+            lock.lock();
+            if (--inUse[key] == 0) {
+                inUse.erase(key);
+            }
+            return;
+        }
+
+        // Already queued or running, promote prefetch to request
+        auto pendingCallbacks = pending.find(key);
+        if (pendingCallbacks != pending.end()) {
+            pendingCallbacks->second.push_back(callback);
+            auto job = std::find_if(prefetchQueue.begin(), prefetchQueue.end(), [&](const Job& rJob) { return rJob.key == key; });
+            if (job != prefetchQueue.end()) {
+                requestQueue.push_back(*job);
+                prefetchQueue.erase(job);
+            }
+            return;
+        }
+
+        // New download
+        pending[key].push_back(callback);
+        requestQueue.push_back(Job{ url, key });
+    }
+    condition.notify_one();
+}
+
+/**
+* prefetch function
+* Downloads image of url if not yet cached
+* @param[in] url of the image
+*/
+void ImageDownloader::prefetch(std::string url) {
+    const std::string key = getKey(url);
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (entries.find(key) != entries.end() || pending.find(key) != pending.end()) {
+            return;
+        }
+        pending[key];
+        prefetchQueue.push_back(Job{ url, key });
+    }
+    condition.notify_one();
+}
+
+/**
+* update function
+* Executes callbacks of finished downloads
+* @return whether any callback was executed
+*/
+bool ImageDownloader::update() {
+    std::vector<std::pair<Callback, std::string> > callbacks;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& rFinished : finished) {
+            auto pendingCallbacks = pending.find(rFinished.first);
+            if (pendingCallbacks == pending.end()) {
+                continue;
+            }
+            if (rFinished.second) {
+                for (const auto& rCallback : pendingCallbacks->second) {
+                    callbacks.push_back(std::make_pair(rCallback, rFinished.first));
+                    inUse[rFinished.first]++; // stays pinned after its pending entry is gone
+                }
+            }
+            pending.erase(pendingCallbacks);
+        }
+        finished.clear();
+    }
+
+    // Execute without lock, callbacks may request further images
+    for (const auto& rCallback : callbacks) {
+        rCallback.first(cacheFolder + "/" + rCallback.second);
+    }
+    if (!callbacks.empty()) {
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const auto& rCallback : callbacks) {
+            if (--inUse[rCallback.second] == 0) {
+                inUse.erase(rCallback.second);
+            }
+        }
+    }
+    return !callbacks.empty();
+}
+
+/**
+* getFilename function
+* @param[in] url of the image
+* @param[out] filename of image in cache, relative to content path
+*/
+std::string ImageDownloader::getFilename(const std::string& url) const {
+    return cacheFolder + "/" + getKey(url);
+}
+
+/**
+* work function
+* Executed by every worker thread, downloads jobs until stopped
+*/
+void ImageDownloader::work() {
+    // Handle is kept for all downloads, so connections to the same host are reused
+    CURL* curl = curl_easy_init();
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            condition.wait(lock, [this] { return shouldStop || !requestQueue.empty() || !prefetchQueue.empty(); });
+            if (shouldStop) {
+                break;
+            }
+            std::deque<Job>& rQueue = requestQueue.empty() ? prefetchQueue : requestQueue;
+            job = rQueue.front();
+            rQueue.pop_front();
+        }
+
+        const bool success = curl != NULL && download(curl, job);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.push_back(std::make_pair(job.key, success));
+        }
+    }
+
+    if (curl != NULL) {
+        curl_easy_cleanup(curl);
+    }
+}
+
+/**
+* download function
+* Downloads into temporary file, which is moved into the cache when complete
+* @param[in] curl handle of the worker
+* @param[in] job to download
+* @param[out] bool whether download succeeded
+*/
+bool ImageDownloader::download(void* curl, const Job& job) {
+    const std::string path = getPath(job.key);
+    const std::string partPath = path + ".part";
+    FILE* fp = fopen(partPath.c_str(), "wb");
+    if (fp == NULL) {
+        std::cout << "ImageDownloader: Could not write " << partPath << std::endl;
+        return false;
+    }
+
+    curl_easy_setopt(curl, CURLOPT_URL, job.url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_file);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, fp);
+    curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L); // no error pages in cache
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // required for multiple threads
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 10L);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT, 60L);
+    CURLcode res = curl_easy_perform(curl);
+    fclose(fp);
+
+    std::error_code error;
+    if (res != CURLE_OK) {
+        std::cout << "ImageDownloader: Download of " << job.url << " failed: " << curl_easy_strerror(res) << std::endl;
+        fs::remove(partPath, error);
+        return false;
+    }
+    fs::rename(partPath, path, error);
+    if (error) {
+        fs::remove(partPath, error);
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    insertIntoCache(job.key, fs::file_size(path, error));
+    return true;
+}
+
+/**
+* insertIntoCache function
+* Adds file to cache and removes least recently used files when over limit. Mutex must be locked
+* @param[in] key of file
+* @param[in] size of file
+*/
+void ImageDownloader::insertIntoCache(const std::string& key, uintmax_t size) {
+    if (size == static_cast<uintmax_t>(-1)) {
+        size = 0;
+    }
+    lru.push_front(key);
+    entries[key] = Entry{ size, lru.begin() };
+    cacheSize += size;
+
+    // Evict, but keep the new file and files of outstanding callbacks. Cache may exceed its limit until those are executed
+    auto candidate = lru.end();
+    while (cacheSize > cacheLimit && candidate != lru.begin()) {
+        --candidate;
+        if (*candidate == key || isPinned(*candidate)) {
+            continue;
+        }
+        const std::string evicted = *candidate;
+        candidate = lru.erase(candidate);
+        cacheSize -= entries[evicted].size;
+        entries.erase(evicted);
+        std::error_code error;
+        fs::remove(getPath(evicted), error);
+    }
+}
+
+/**
+* isPinned function
+* Whether file has callbacks waiting for it or being executed, so it must not be evicted. Mutex must be locked
+* @param[in] key of file
+* @param[out] bool whether file is pinned
+*/
+bool ImageDownloader::isPinned(const std::string& key) const {
+    if (inUse.find(key) != inUse.end()) {
+        return true;
+    }
+    auto pendingCallbacks = pending.find(key);
+    return pendingCallbacks != pending.end() && !pendingCallbacks->second.empty();
+}
+
+/**
+* loadCache function
+* Fills cache with files of previous runs, ordered by their last use
+*/
+void ImageDownloader::loadCache() {
+    std::error_code error;
+    const fs::path folder = contentPath + "/" + cacheFolder;
+    fs::create_directories(folder, error);
+
+    // Collect files, remove incomplete downloads
+    std::vector<std::pair<fs::file_time_type, fs::path> > files;
+    for (fs::directory_iterator iter(folder, error), end; !error && iter != end; iter.increment(error)) {
+        const fs::path path = iter->path();
+        if (path.extension() == ".part") {
+            fs::remove(path, error);
+            continue;
+        }
+        files.push_back(std::make_pair(fs::last_write_time(path, error), path));
+    }
+
+    // Oldest first, so most recently used ends up at front
+    std::sort(files.begin(), files.end());
+    std::lock_guard<std::mutex> lock(mutex);
+    for (const auto& rFile : files) {
+        insertIntoCache(rFile.second.filename().string(), fs::file_size(rFile.second, error));
+    }
+}
+
+/**
+* getKey function
+* Content address of url, hash of url plus extension of image
+* @param[in] url of the image
+* @param[out] key used as filename in cache
+*/
+std::string ImageDownloader::getKey(const std::string& url) const {
+    // FNV-1a
+    uint64_t hash = 14695981039346656037ULL;
+    for (char c : url) {
+        hash ^= (unsigned char)c;
+        hash *= 1099511628211ULL;
+    }
+    char hex[17];
+    snprintf(hex, sizeof(hex), "%016llx", (unsigned long long)hash);
+
+    // Extension of file in url, as eyeGUI decides by it how to load the image
+    std::string ext = "img";
+    const std::string path = url.substr(0, url.find_first_of("?#"));
+    const size_t dot = path.rfind('.');
+    if (dot != std::string::npos && path.find('/', dot) == std::string::npos) {
+        std::string candidate = path.substr(dot + 1);
+        if (!candidate.empty() && candidate.size() <= 4 && std::all_of(candidate.begin(), candidate.end(), [](char c) { return std::isalnum((unsigned char)c) != 0; })) {
+            ext = candidate;
+        }
+    }
+    return std::string(hex) + "." + ext;
+}
+
+/**
+* getPath function
+* @param[in] key of file
+* @param[out] absolute path of file in cache
+*/
+std::string ImageDownloader::getPath(const std::string& key) const {
+    return contentPath + "/" + cacheFolder + "/" + key;
+}
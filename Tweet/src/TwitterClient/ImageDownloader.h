@@ -0,0 +1,99 @@
+//============================================================================
+// Distributed under the Apache License, Version 2.0.
+//============================================================================
+
+#pragma once
+
+// Downloads are based on libcurl
+#include <curl/curl.h>
+
+#include <string>
+#include <vector>
+#include <deque>
+#include <list>
+#include <map>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+/**
+* Downloads images with a pool of worker threads, each reusing its connections.
+* Images are stored in an on-disk cache, named after a hash of their URL. When
+* the cache exceeds its size limit, least recently used images are removed.
+* Images whose callbacks have not been executed yet or are being executed are
+* never removed.
+* Callbacks are executed on the thread calling update, so they may use eyeGUI.
+*/
+class ImageDownloader {
+
+public:
+
+    // Callback receiving the filename of the image, relative to the content path
+    typedef std::function<void(std::string)> Callback;
+
+    ImageDownloader(std::string contentPath, std::string cacheFolder, int workerCount = 4, uintmax_t cacheLimit = 64 * 1024 * 1024);
+    ~ImageDownloader();
+
+    // Request image, callback is executed immediately when cached, otherwise after download
+    void request(std::string url, Callback callback);
+
+    // Download image in the background, so a later request finds it in the cache
+    void prefetch(std::string url);
+
+    // Executes callbacks of finished downloads, call it once per frame. Returns whether any callback was executed
+    bool update();
+
+    // Filename of image relative to content path
+    std::string getFilename(const std::string& url) const;
+
+private:
+
+    // Download job
+    struct Job {
+        std::string url;
+        std::string key;
+    };
+
+    // Entry of the cache
+    struct Entry {
+        uintmax_t size;
+        std::list<std::string>::iterator lruPosition;
+    };
+
+    void work();
+    bool download(void* curl, const Job& job);
+    void insertIntoCache(const std::string& key, uintmax_t size);
+    bool isPinned(const std::string& key) const;
+    void loadCache();
+    std::string getKey(const std::string& url) const;
+    std::string getPath(const std::string& key) const;
+
+    std::string contentPath;
+    std::string cacheFolder;
+    uintmax_t cacheLimit;
+
+    // Worker threads
+    std::vector<std::thread> workers;
+    std::mutex mutex;
+    std::condition_variable condition;
+    std::deque<Job> requestQueue; // visible images are downloaded first
+    std::deque<Job> prefetchQueue;
+    std::atomic<bool> shouldStop;
+
+    // Callbacks of queued and running downloads, mapped by key
+    std::map<std::string, std::vector<Callback> > pending;
+
+    // Count of callbacks of cached images being executed, mapped by key
+    std::map<std::string, int> inUse;
+
+    // Keys of finished downloads and whether they succeeded, consumed by update
+    std::deque<std::pair<std::string, bool> > finished;
+
+    // Cache, most recently used key at front of the list
+    std::list<std::string> lru;
+    std::map<std::string, Entry> entries;
+    uintmax_t cacheSize = 0;
+};
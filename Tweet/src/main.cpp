@@ -10,6 +10,7 @@
 #include "src/TwitterClient/ImageDownload.h"
 #include "src/Input.h"
 #include "src/Framebuffer.h"
+#include "src/FrameScheduler.h"
 #include <iostream>
 
 using namespace std;
@@ -195,6 +196,13 @@ int main(int argc, char* argv[]) {
 	float lastTime, deltaTime;
 	lastTime = (float)glfwGetTime();
 
+	// Skip rendering of frames in which nothing changed
+	FrameScheduler frameScheduler(
+		1.f, // seconds frames are rendered after last change, lets eyeGUI animations finish
+		1.f, // seconds after which a frame is rendered in any case
+		60.f, // times per second input is polled when nothing is rendered
+		8.f); // pixels input has to move to be a change
+
     // Main loop
     while (!glfwWindowShouldClose(window))
     {
@@ -208,9 +216,6 @@ int main(int argc, char* argv[]) {
         deltaTime = currentTime - lastTime;
         lastTime = currentTime;
 
-        // Clearing of buffers
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-
         // Get current mouse cursor position and give it to eyeGUI as gaze
         int x, y;
         eyegui::Input input;
@@ -223,22 +228,50 @@ int main(int argc, char* argv[]) {
 		// Since the input coordinates are probably in full screen resolution, calculate them into coordinates of framebuffer
 		input.gazeX = (int)((float)input.gazeX * (1280.f / (float)resX));
 		input.gazeY = (int)((float)input.gazeY * (800.f / (float)resY));
+		frameScheduler.updateInput(input.gazeX, input.gazeY);
+
+        // Show images that finished downloading
+        if (login->application->getImageDownloader()->update())
+        {
+            frameScheduler.addDamage();
+        }
 
-        // Render GUI into framebuffer
+        // Update GUI, elements hit by gaze are animated
 		framebuffer.Bind();
         eyegui::Input usedInput = eyegui::updateGUI(login->application->getGUI(), deltaTime, input);
-        eyegui::drawGUI(login->application->getGUI());
 		framebuffer.Unbind();
+        if (usedInput.gazeUsed)
+        {
+            frameScheduler.addDamage();
+        }
 
-		// Render framebuffer on screen
-		glBindVertexArray(screenfillingVAO);
-		glUseProgram(screenfillingProgram);
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, framebuffer.GetAttachment(0));
-		glDrawArrays(GL_POINTS, 0, 1);
+        if (frameScheduler.shouldCompose(deltaTime))
+        {
+            // Clearing of buffers
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+            // Render GUI into framebuffer
+            framebuffer.Bind();
+            eyegui::drawGUI(login->application->getGUI());
+            framebuffer.Unbind();
+
+            // Render framebuffer on screen
+            glBindVertexArray(screenfillingVAO);
+            glUseProgram(screenfillingProgram);
+            glActiveTexture(GL_TEXTURE0);
+            glBindTexture(GL_TEXTURE_2D, framebuffer.GetAttachment(0));
+            glDrawArrays(GL_POINTS, 0, 1);
+
+            // Swap front and back buffers
+            glfwSwapBuffers(window);
+        }
+        else
+        {
+            // Nothing changed, wait before polling input again
+            frameScheduler.waitForNextPoll();
+        }
 
-        // Swap front and back buffers and poll events
-        glfwSwapBuffers(window);
+        // Poll events
         glfwPollEvents();
     }
 